@@ -0,0 +1,127 @@
+#ifndef _DELTA_DECODER_H
+#define _DELTA_DECODER_H
+
+#include "payload_decoder.h"
+
+// ============================================================================
+// 델타 압축 묶음 해석 (LoRa_Node delta_codec.h의 역변환)
+//
+// 묶음: [디스크립터][샘플 수]
+//       첫 샘플 [시각 varint][측정 데이터], 이후 [경과 초 varint][변경 비트맵][zigzag 델타 varint...]
+// 무선 묶음(FPort 4)은 업링크 페이로드 그대로, 플래시 기록(/history.bin)은 [길이 u16][묶음]의 반복
+// 풀어낸 프레임은 [디스크립터][측정 데이터]가 이어진 버퍼라서 바로 decodeFrames()에 넘길 수 있음:
+//   decodeFrames(*layout, frames + FRAME_DESCRIPTOR_SIZE, FRAME_DESCRIPTOR_SIZE + layout->size, n, columns)
+// ============================================================================
+
+#define DELTA_FRAME_STRIDE_MAX (FRAME_DESCRIPTOR_SIZE + 32)   // 풀어낸 프레임 하나의 최대 크기
+#define HISTORY_UNIX_TIME_MIN 1577836800UL   // 플래시 기록 시각이 이 이상이면 Unix 초 (history_log.h와 같음)
+
+// 필드 경계 마스크 (16비트 필드 시작 위치, 펌웨어 드라이버의 DELTA_U16_FIELDS와 같음)
+inline uint32_t deltaFieldMask(const FrameLayout &layout) {
+  uint32_t mask = 0;
+  for (uint8_t j = 0; j < layout.field_count; j++) {
+    if (layout.fields[j].type != FIELD_U8) mask |= 1u << layout.fields[j].offset;
+  }
+  return mask;
+}
+
+inline int16_t zigzagDecode(uint16_t v) { return (int16_t)((v >> 1) ^ (0u - (v & 1))); }
+
+// varint 하나 (최대 5바이트, 끝을 넘거나 너무 길면 false)
+inline bool readVarint(const uint8_t* &p, const uint8_t* end, uint32_t &value) {
+  value = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (p >= end) return false;
+    uint8_t b = *p++;
+    value |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+// 묶음 하나 → frames (샘플마다 FRAME_DESCRIPTOR_SIZE + layout->size 바이트), times (펌웨어가 넣은 시각)
+// 반환: 풀어낸 샘플 수 (형식 오류, 알 수 없는 디스크립터, max_samples 초과면 0)
+inline size_t decodeDeltaBlock(const uint8_t* in, size_t len, uint8_t* frames, uint32_t* times,
+                               size_t max_samples, const FrameLayout* &layout) {
+  layout = nullptr;
+  if (len < 2 || !isFrameDescriptor(in[0])) return 0;
+  const FrameLayout* found = layoutForDescriptor(in[0]);
+  size_t count = in[1];
+  if (!found || count == 0 || count > max_samples) return 0;
+
+  const uint8_t size = found->size;
+  const size_t stride = FRAME_DESCRIPTOR_SIZE + size;
+  const uint32_t u16_fields = deltaFieldMask(*found);
+  uint8_t field_count = 0;
+  for (uint8_t i = 0; i < size; i++, field_count++) {
+    if ((u16_fields >> i) & 1) i++;
+  }
+  const uint8_t bitmap_size = (field_count + 7) / 8;
+
+  const uint8_t* p = in + 2;
+  const uint8_t* end = in + len;
+  uint32_t time;
+  if (!readVarint(p, end, time) || (size_t)(end - p) < size) return 0;
+  frames[0] = in[0];
+  memcpy(frames + FRAME_DESCRIPTOR_SIZE, p, size);
+  times[0] = time;
+  p += size;
+
+  for (size_t s = 1; s < count; s++) {
+    uint32_t dt;
+    if (!readVarint(p, end, dt) || (size_t)(end - p) < bitmap_size) return 0;
+    const uint8_t* bitmap = p;
+    p += bitmap_size;
+
+    uint8_t* frame = frames + s * stride;
+    memcpy(frame, frame - stride, stride);
+    uint8_t* data = frame + FRAME_DESCRIPTOR_SIZE;
+    times[s] = times[s - 1] + dt;
+
+    uint8_t field = 0;
+    for (uint8_t i = 0; i < size; i++, field++) {
+      bool wide = ((u16_fields >> i) & 1) && i + 1 < size;
+      if (!(bitmap[field >> 3] & (1 << (field & 7)))) {
+        if (wide) i++;
+        continue;
+      }
+      uint32_t raw;
+      if (!readVarint(p, end, raw) || raw > 0xFFFF) return 0;
+      int16_t delta = zigzagDecode((uint16_t)raw);
+      if (wide) {
+        uint16_t value = (uint16_t)((data[i] << 8 | data[i + 1]) + delta);
+        data[i] = value >> 8;
+        data[i + 1] = value & 0xFF;
+        i++;
+      } else {
+        data[i] = (uint8_t)(data[i] + delta);
+      }
+    }
+  }
+  if (p != end) return 0;
+
+  layout = found;
+  return count;
+}
+
+// 무선 묶음(FPort 4) 시각 → 샘플별 측정 시각 (수신 시각 기준 Unix 초)
+// times[0] = 전송 시 첫 샘플의 경과 초, 이후는 첫 샘플과의 간격이 더해진 값
+inline void batchSampleTimes(uint32_t received_unix, const uint32_t* times, size_t count, uint32_t* sample_unix) {
+  for (size_t s = 0; s < count; s++) sample_unix[s] = received_unix - times[0] + (times[s] - times[0]);
+}
+
+// 플래시 기록 시각이 Unix 초인지 (아니면 노드 전원 인가 후 초라서 같은 전원 주기 안에서만 비교 가능)
+inline bool historyTimeIsUnix(uint32_t time) { return time >= HISTORY_UNIX_TIME_MIN; }
+
+// 플래시 기록 파일에서 다음 묶음 위치 ([길이 u16][묶음], 끝이거나 잘린 레코드면 false)
+inline bool nextHistoryBlock(const uint8_t* data, size_t len, size_t &pos, const uint8_t* &block,
+                             size_t &block_len) {
+  if (pos + 2 > len) return false;
+  block_len = (size_t)data[pos] << 8 | data[pos + 1];
+  if (pos + 2 + block_len > len) return false;
+  block = data + pos + 2;
+  pos += 2 + block_len;
+  return true;
+}
+
+#endif
@@ -0,0 +1,444 @@
+#ifndef _PAYLOAD_DECODER_H
+#define _PAYLOAD_DECODER_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// ============================================================================
+// LoRa_Node 업링크 페이로드 디코더 (호스트용, 헤더 전용)
+//
+// 펌웨어 encode()의 바이트 배치를 필드 표(FrameLayout)로 옮겨 두고, 모든 프레임 버전을
+// 같은 코드로 해석함 (버전 = 디스크립터 bit6-4, 크기는 디스크립터 제외):
+//   stair_v1      v1 13바이트  LoRa_Stabilize / LoRa_Stabilize_v2 ([12] 연속 실패 횟수)
+//   stair         v2 14바이트  LoRa_Node stair / stair_battery (링크 품질, 고도 플래그)
+//   am1008w_v1    v1 16바이트  LoRa_AM1008W_i2c / _uart ([14] 연속 실패 횟수, 준비 비트 전)
+//   am1008w       v2 24바이트  LoRa_Node am1008w_* (준비 비트, 구간 통계)
+//   air_v1        v1 20바이트  LoRa_AM1008W_uart/README.md 문서 구조
+//   air_v2        v2 24바이트  LoRa_Node air_station (구간 통계 전)
+//   air           v3 32바이트  LoRa_Node air_station
+//
+// 업링크 하나는 decodeUplink()로: FPort 표(PORT_ROUTES)로 포트별 앞 헤더를 벗기고,
+// 첫 바이트가 디스크립터(frame_header.h)면 표 한 번 조회로 버전을 고름.
+// 디스크립터가 없는 구 펌웨어 프레임만 센서 종류(FrameKind)와 길이로 추정함
+//
+// 배치 API(decodeFrames)는 같은 버전의 프레임이 일정 간격(stride)으로 이어진 버퍼를
+// 열(column)별 float 배열로 풀어냄 (struct-of-arrays). 디스크립터가 붙은 프레임은
+// frames + FRAME_DESCRIPTOR_SIZE, stride = FRAME_DESCRIPTOR_SIZE + layout.size로 넘기면 됨:
+//  - 블록(PAYLOAD_DECODE_BLOCK 프레임)마다 필드 하나씩 끝까지 도는 안쪽 루프라서
+//    분기 없이 같은 연산만 반복됨 (컴파일러 자동 벡터화 대상)
+//  - 값 없음(센티널, 상태/준비 비트 꺼짐)은 비트 마스크 선택으로 NAN을 넣음 (selectFloat)
+//  - 필요 없는 열은 nullptr로 두면 건너뜀
+// ============================================================================
+
+#define PAYLOAD_DECODE_BLOCK 1024     // 블록 크기 (프레임 32바이트 기준 32KB, L1/L2에 머묾)
+#define PAYLOAD_NO_SENTINEL 0xFFFFFFFF
+
+// 값은 펌웨어 FRAME_TYPE_* (frame_header.h)와 같음
+enum FrameKind {
+  FRAME_STAIR = 0,
+  FRAME_AM1008W = 1,
+  FRAME_AIR_STATION = 2
+};
+
+// 프레임 디스크립터: bit7 1 | bit6-4 버전 | bit3-1 FrameKind | bit0 부팅 후 첫 측정
+#define FRAME_DESCRIPTOR_SIZE 1
+#define FRAME_MARKER 0x80
+#define FRAME_FLAG_BOOT 0x01
+
+// 업링크 종류 (FPort로 구분)
+enum FrameClass {
+  CLASS_MEASUREMENT,  // FPort 1  [디스크립터][측정 데이터]
+  CLASS_BACKLOG,      // FPort 2  [경과 시간(분) u16][디스크립터][측정 데이터]
+  CLASS_DIAGNOSTIC,   // FPort 3  [디스크립터][진단 데이터] (예약, 아직 보내는 펌웨어 없음)
+  CLASS_DELTA_BATCH,  // FPort 4  [디스크립터][샘플 수][델타 압축 샘플...] (delta_decoder.h)
+  CLASS_CONFIG_ACK    // FPort 11 [트랜잭션 ID][상태][실패 명령][디스크립터][측정 데이터]
+};
+
+// 디코딩 결과 열 (모든 프레임 버전 공통, 없는 항목은 NAN)
+enum PayloadColumn {
+  COL_TEMP_BME,       // °C
+  COL_HUM_BME,        // %
+  COL_PRESS_BME,      // hPa
+  COL_TEMP_BMP,       // °C
+  COL_PRESS_BMP,      // hPa
+  COL_ALTITUDE,       // m (절대: QNH 기준, 상대: 기준점 대비 - COL_FLAGS bit0)
+  COL_TEMP_AM,        // °C
+  COL_HUM_AM,         // %
+  COL_CO2,            // ppm
+  COL_PM1_0,          // μg/m³
+  COL_PM2_5,          // μg/m³
+  COL_PM10,           // μg/m³
+  COL_VOC,            // 0~3
+  COL_STATUS,         // 센서 상태 비트
+  COL_FLAGS,          // 고도 플래그 (stair)
+  COL_READY,          // AM1008W 항목별 준비 비트
+  COL_LINK,           // 링크 품질 바이트 (link_quality.h)
+  COL_SEND_FAILURES,  // 연속 전송 실패 횟수 (구 펌웨어)
+  COL_SAMPLES,        // 구간 샘플 수
+  COL_VOC_MAX,
+  COL_PM2_5_MAX,
+  COL_PM2_5_SD,
+  COL_PM10_MAX,
+  COL_COUNT
+};
+
+enum FieldType {
+  FIELD_U8,
+  FIELD_U16,          // 빅엔디안
+  FIELD_ALTITUDE      // u16, aux 바이트 bit0이 켜져 있으면 int16 x0.1m 아니면 m + 500
+};
+
+// 값 = raw * scale + bias, 아래 조건이 모두 맞을 때만 유효
+//  - raw != missing
+//  - (frame[gate_offset] & gate_bits) == gate_bits   (센서 상태 비트)
+//  - (frame[ready_offset] & ready_bits) == ready_bits (AM1008W 준비 비트)
+struct FieldLayout {
+  uint8_t column;
+  uint8_t type;
+  uint8_t offset;
+  float scale;
+  float bias;
+  uint32_t missing;
+  uint8_t gate_offset;
+  uint8_t gate_bits;
+  uint8_t ready_offset;
+  uint8_t ready_bits;
+};
+
+struct FrameLayout {
+  const char* name;
+  FrameKind kind;
+  uint8_t version;
+  uint8_t size;
+  const FieldLayout* fields;
+  uint8_t field_count;
+};
+
+// ---- 필드 표 ----
+
+#define PL_U16(col, off, scale, bias) {col, FIELD_U16, off, scale, bias, PAYLOAD_NO_SENTINEL, 0, 0, 0, 0}
+#define PL_U8(col, off) {col, FIELD_U8, off, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 0, 0, 0, 0}
+#define PL_GATED(col, type, off, scale, bias, missing, gate_off, gate, ready_off, ready) \
+  {col, type, off, scale, bias, missing, gate_off, gate, ready_off, ready}
+
+// AM1008W 준비 비트 (am1008w.h AM1008_READY_*)
+#define PL_READY_CO2 0x02
+#define PL_READY_VOC 0x04
+#define PL_READY_PM 0x08
+
+static const FieldLayout STAIR_V1_FIELDS[] = {
+  PL_U16(COL_TEMP_BME, 0, 0.1f, -40.0f),
+  PL_U16(COL_HUM_BME, 2, 0.1f, 0.0f),
+  PL_U16(COL_PRESS_BME, 4, 0.1f, 800.0f),
+  PL_U16(COL_TEMP_BMP, 6, 0.1f, -40.0f),
+  PL_U16(COL_PRESS_BMP, 8, 0.1f, 800.0f),
+  PL_U16(COL_ALTITUDE, 10, 1.0f, -500.0f),
+  PL_U8(COL_SEND_FAILURES, 12),
+};
+
+static const FieldLayout STAIR_FIELDS[] = {
+  PL_U16(COL_TEMP_BME, 0, 0.1f, -40.0f),
+  PL_U16(COL_HUM_BME, 2, 0.1f, 0.0f),
+  PL_U16(COL_PRESS_BME, 4, 0.1f, 800.0f),
+  PL_U16(COL_TEMP_BMP, 6, 0.1f, -40.0f),
+  PL_U16(COL_PRESS_BMP, 8, 0.1f, 800.0f),
+  {COL_ALTITUDE, FIELD_ALTITUDE, 10, 1.0f, -500.0f, PAYLOAD_NO_SENTINEL, 13, 0, 0, 0},  // gate_offset = 고도 플래그
+  PL_U8(COL_LINK, 12),
+  PL_U8(COL_FLAGS, 13),
+};
+
+// AM1008W 16바이트: 상태 bit1(유효한 측정)이 꺼져 있으면 값 없음
+// [14]는 구 펌웨어에서 연속 실패 횟수, 이후 링크 품질이고 [15]는 예약(0) 또는 준비 비트라
+// 원시값만 열로 내보내고 준비 비트로 거르지는 않음
+static const FieldLayout AM1008W_V1_FIELDS[] = {
+  PL_GATED(COL_TEMP_AM, FIELD_U16, 0, 0.1f, -40.0f, 0xFFFF, 13, 0x02, 0, 0),
+  PL_GATED(COL_HUM_AM, FIELD_U16, 2, 0.1f, 0.0f, 0xFFFF, 13, 0x02, 0, 0),
+  PL_GATED(COL_CO2, FIELD_U16, 4, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 0, 0),
+  PL_GATED(COL_PM2_5, FIELD_U16, 6, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 0, 0),
+  PL_GATED(COL_PM10, FIELD_U16, 8, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 0, 0),
+  PL_GATED(COL_PM1_0, FIELD_U16, 10, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 0, 0),
+  PL_GATED(COL_VOC, FIELD_U8, 12, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 0, 0),
+  PL_U8(COL_STATUS, 13),
+  PL_U8(COL_LINK, 14),
+  PL_U8(COL_READY, 15),
+};
+
+static const FieldLayout AM1008W_FIELDS[] = {
+  PL_GATED(COL_TEMP_AM, FIELD_U16, 0, 0.1f, -40.0f, 0xFFFF, 13, 0x02, 0, 0),
+  PL_GATED(COL_HUM_AM, FIELD_U16, 2, 0.1f, 0.0f, 0xFFFF, 13, 0x02, 0, 0),
+  PL_GATED(COL_CO2, FIELD_U16, 4, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 15, PL_READY_CO2),
+  PL_GATED(COL_PM2_5, FIELD_U16, 6, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 15, PL_READY_PM),
+  PL_GATED(COL_PM10, FIELD_U16, 8, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 15, PL_READY_PM),
+  PL_GATED(COL_PM1_0, FIELD_U16, 10, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 15, PL_READY_PM),
+  PL_GATED(COL_VOC, FIELD_U8, 12, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 15, PL_READY_VOC),
+  PL_U8(COL_STATUS, 13),
+  PL_U8(COL_LINK, 14),
+  PL_U8(COL_READY, 15),
+  PL_GATED(COL_SAMPLES, FIELD_U8, 16, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 0, 0),
+  PL_GATED(COL_VOC_MAX, FIELD_U8, 17, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 15, PL_READY_VOC),
+  PL_GATED(COL_PM2_5_MAX, FIELD_U16, 18, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 15, PL_READY_PM),
+  PL_GATED(COL_PM2_5_SD, FIELD_U16, 20, 0.1f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 15, PL_READY_PM),
+  PL_GATED(COL_PM10_MAX, FIELD_U16, 22, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 13, 0x02, 15, PL_READY_PM),
+};
+
+// 복합 노드 공통 앞 18바이트 (상태 [17]: bit0 BME280, bit1 BMP390, bit2 AM1008W)
+#define PL_AIR_HEAD(ready_off, co2, pm, voc) \
+  PL_GATED(COL_TEMP_BME, FIELD_U16, 0, 0.1f, -40.0f, 0xFFFF, 17, 0x01, 0, 0), \
+  PL_GATED(COL_HUM_BME, FIELD_U16, 2, 0.1f, 0.0f, 0xFFFF, 17, 0x01, 0, 0), \
+  PL_GATED(COL_PRESS_BME, FIELD_U16, 4, 0.1f, 800.0f, 0xFFFF, 17, 0x01, 0, 0), \
+  PL_GATED(COL_TEMP_AM, FIELD_U16, 6, 0.1f, -40.0f, 0xFFFF, 17, 0x04, 0, 0), \
+  PL_GATED(COL_HUM_AM, FIELD_U16, 8, 0.1f, 0.0f, 0xFFFF, 17, 0x04, 0, 0), \
+  PL_GATED(COL_CO2, FIELD_U16, 10, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 17, 0x04, ready_off, co2), \
+  PL_GATED(COL_PM2_5, FIELD_U16, 12, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 17, 0x04, ready_off, pm), \
+  PL_GATED(COL_PM10, FIELD_U16, 14, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 17, 0x04, ready_off, pm), \
+  PL_GATED(COL_VOC, FIELD_U8, 16, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 17, 0x04, ready_off, voc), \
+  PL_U8(COL_STATUS, 17)
+
+#define PL_AIR_V2_TAIL \
+  PL_U8(COL_LINK, 18), \
+  PL_U8(COL_READY, 19), \
+  PL_GATED(COL_PRESS_BMP, FIELD_U16, 20, 0.1f, 800.0f, 0xFFFF, 17, 0x02, 0, 0), \
+  PL_GATED(COL_PM1_0, FIELD_U16, 22, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 17, 0x04, 19, PL_READY_PM)
+
+static const FieldLayout AIR_V1_FIELDS[] = {
+  PL_AIR_HEAD(0, 0, 0, 0),
+  PL_U8(COL_SEND_FAILURES, 18),
+};
+
+static const FieldLayout AIR_V2_FIELDS[] = {
+  PL_AIR_HEAD(19, PL_READY_CO2, PL_READY_PM, PL_READY_VOC),
+  PL_AIR_V2_TAIL,
+};
+
+static const FieldLayout AIR_FIELDS[] = {
+  PL_AIR_HEAD(19, PL_READY_CO2, PL_READY_PM, PL_READY_VOC),
+  PL_AIR_V2_TAIL,
+  PL_GATED(COL_SAMPLES, FIELD_U8, 24, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 17, 0x04, 0, 0),
+  PL_GATED(COL_VOC_MAX, FIELD_U8, 25, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 17, 0x04, 19, PL_READY_VOC),
+  PL_GATED(COL_PM2_5_MAX, FIELD_U16, 26, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 17, 0x04, 19, PL_READY_PM),
+  PL_GATED(COL_PM2_5_SD, FIELD_U16, 28, 0.1f, 0.0f, PAYLOAD_NO_SENTINEL, 17, 0x04, 19, PL_READY_PM),
+  PL_GATED(COL_PM10_MAX, FIELD_U16, 30, 1.0f, 0.0f, PAYLOAD_NO_SENTINEL, 17, 0x04, 19, PL_READY_PM),
+};
+
+#define PL_LAYOUT(name, kind, version, size, fields) \
+  {name, kind, version, size, fields, sizeof(fields) / sizeof(fields[0])}
+
+static const FrameLayout FRAME_LAYOUTS[] = {
+  PL_LAYOUT("stair_v1", FRAME_STAIR, 1, 13, STAIR_V1_FIELDS),
+  PL_LAYOUT("stair", FRAME_STAIR, 2, 14, STAIR_FIELDS),
+  PL_LAYOUT("am1008w_v1", FRAME_AM1008W, 1, 16, AM1008W_V1_FIELDS),
+  PL_LAYOUT("am1008w", FRAME_AM1008W, 2, 24, AM1008W_FIELDS),
+  PL_LAYOUT("air_v1", FRAME_AIR_STATION, 1, 20, AIR_V1_FIELDS),
+  PL_LAYOUT("air_v2", FRAME_AIR_STATION, 2, 24, AIR_V2_FIELDS),
+  PL_LAYOUT("air", FRAME_AIR_STATION, 3, 32, AIR_FIELDS),
+};
+
+#define FRAME_LAYOUT_COUNT (sizeof(FRAME_LAYOUTS) / sizeof(FRAME_LAYOUTS[0]))
+
+// 센서 종류와 길이로 프레임 버전 찾기 (디스크립터 없는 구 프레임용, 없으면 nullptr)
+inline const FrameLayout* findFrameLayout(FrameKind kind, size_t size) {
+  for (size_t i = 0; i < FRAME_LAYOUT_COUNT; i++) {
+    if (FRAME_LAYOUTS[i].kind == kind && FRAME_LAYOUTS[i].size == size) return &FRAME_LAYOUTS[i];
+  }
+  return nullptr;
+}
+
+inline uint8_t frameDescriptor(FrameKind kind, uint8_t version, uint8_t flags) {
+  return FRAME_MARKER | (version & 0x07) << 4 | (kind & 0x07) << 1 | (flags & 0x01);
+}
+
+// 구 프레임 첫 바이트는 온도 상위 바이트(0x00~0x04) 또는 0xFF라서 bit7 + 0xFF 제외로 구분됨
+inline bool isFrameDescriptor(uint8_t b) { return (b & FRAME_MARKER) && b != 0xFF; }
+
+// 디스크립터 → 프레임 버전 (버전 x 종류 64칸 표 한 번 조회, 없으면 nullptr)
+inline const FrameLayout* layoutForDescriptor(uint8_t descriptor) {
+  struct DescriptorTable {
+    const FrameLayout* slots[64];
+    DescriptorTable() : slots() {
+      for (size_t i = 0; i < FRAME_LAYOUT_COUNT; i++) {
+        slots[(FRAME_LAYOUTS[i].version & 0x07) << 3 | (FRAME_LAYOUTS[i].kind & 0x07)] = &FRAME_LAYOUTS[i];
+      }
+    }
+  };
+  static const DescriptorTable table;
+  return table.slots[(descriptor >> 1) & 0x3F];
+}
+
+// ---- FPort 표 ----
+
+struct PortRoute {
+  uint8_t fport;
+  FrameClass frame_class;
+  uint8_t header_size;   // 디스크립터 앞 포트별 헤더 크기
+};
+
+static const PortRoute PORT_ROUTES[] = {
+  {1, CLASS_MEASUREMENT, 0},
+  {2, CLASS_BACKLOG, 2},
+  {3, CLASS_DIAGNOSTIC, 0},
+  {4, CLASS_DELTA_BATCH, 0},
+  {11, CLASS_CONFIG_ACK, 3},
+};
+
+#define PORT_ROUTE_COUNT (sizeof(PORT_ROUTES) / sizeof(PORT_ROUTES[0]))
+
+inline const PortRoute* findPortRoute(uint8_t fport) {
+  for (size_t i = 0; i < PORT_ROUTE_COUNT; i++) {
+    if (PORT_ROUTES[i].fport == fport) return &PORT_ROUTES[i];
+  }
+  return nullptr;
+}
+
+inline const char* payloadColumnName(uint8_t column) {
+  static const char* const names[COL_COUNT] = {
+    "temp_bme", "hum_bme", "press_bme", "temp_bmp", "press_bmp", "altitude",
+    "temp_am", "hum_am", "co2", "pm1_0", "pm2_5", "pm10", "voc",
+    "status", "flags", "ready", "link", "send_failures",
+    "samples", "voc_max", "pm2_5_max", "pm2_5_sd", "pm10_max",
+  };
+  return column < COL_COUNT ? names[column] : "?";
+}
+
+// ---- 디코딩 ----
+
+// cond(0/1)에 따라 a 또는 b (비트 마스크 선택이라 삼항 연산자와 달리 자동 벡터화됨)
+inline float selectFloat(uint32_t cond, float a, float b) {
+  uint32_t bits_a, bits_b;
+  memcpy(&bits_a, &a, sizeof(bits_a));
+  memcpy(&bits_b, &b, sizeof(bits_b));
+  uint32_t mask = 0u - cond;
+  uint32_t bits = (bits_a & mask) | (bits_b & ~mask);
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+inline float selectValid(uint32_t valid, float value) { return selectFloat(valid, value, NAN); }
+
+// 필드 하나를 프레임 count개에 대해 out[0..count)로 (안쪽 루프는 분기 없음)
+inline void decodeField(const FieldLayout &field, const uint8_t* frames, size_t stride, size_t count,
+                        float* out) {
+  const uint8_t off = field.offset;
+  const uint8_t gate_off = field.gate_offset;
+  const uint8_t gate = field.gate_bits;
+  const uint8_t ready_off = field.ready_offset;
+  const uint8_t ready = field.ready_bits;
+  const uint32_t missing = field.missing;
+  const float scale = field.scale;
+  const float bias = field.bias;
+
+  switch (field.type) {
+    case FIELD_U8:
+      for (size_t i = 0; i < count; i++) {
+        const uint8_t* f = frames + i * stride;
+        uint32_t raw = f[off];
+        uint32_t valid = (uint32_t)(raw != missing) & (uint32_t)((f[gate_off] & gate) == gate) &
+                         (uint32_t)((f[ready_off] & ready) == ready);
+        out[i] = selectValid(valid, (float)raw * scale + bias);
+      }
+      break;
+
+    case FIELD_U16:
+      for (size_t i = 0; i < count; i++) {
+        const uint8_t* f = frames + i * stride;
+        uint32_t raw = (uint32_t)f[off] << 8 | f[off + 1];
+        uint32_t valid = (uint32_t)(raw != missing) & (uint32_t)((f[gate_off] & gate) == gate) &
+                         (uint32_t)((f[ready_off] & ready) == ready);
+        out[i] = selectValid(valid, (float)raw * scale + bias);
+      }
+      break;
+
+    case FIELD_ALTITUDE:
+      // gate_offset은 고도 플래그 위치 (bit0: 상대고도)
+      for (size_t i = 0; i < count; i++) {
+        const uint8_t* f = frames + i * stride;
+        uint16_t raw = (uint16_t)(f[off] << 8 | f[off + 1]);
+        float absolute = (float)raw * scale + bias;
+        float relative = (float)(int16_t)raw * 0.1f;
+        out[i] = selectFloat(f[gate_off] & 0x01, relative, absolute);
+      }
+      break;
+  }
+}
+
+// 같은 버전 프레임 count개 (frames[i * stride]부터 layout.size 바이트)를 열별로 디코딩
+// columns[COL_*]: 프레임 수만큼의 배열, nullptr이면 그 열은 건너뜀 (프레임에 없는 열은 NAN으로 채움)
+inline void decodeFrames(const FrameLayout &layout, const uint8_t* frames, size_t stride, size_t count,
+                         float* const* columns) {
+  bool present[COL_COUNT] = {};
+  for (uint8_t j = 0; j < layout.field_count; j++) present[layout.fields[j].column] = true;
+
+  for (size_t start = 0; start < count; start += PAYLOAD_DECODE_BLOCK) {
+    size_t n = count - start < PAYLOAD_DECODE_BLOCK ? count - start : PAYLOAD_DECODE_BLOCK;
+    const uint8_t* block = frames + start * stride;
+
+    for (uint8_t j = 0; j < layout.field_count; j++) {
+      const FieldLayout &field = layout.fields[j];
+      if (columns[field.column]) decodeField(field, block, stride, n, columns[field.column] + start);
+    }
+    for (uint8_t c = 0; c < COL_COUNT; c++) {
+      if (present[c] || !columns[c]) continue;
+      for (size_t i = 0; i < n; i++) columns[c][start + i] = NAN;
+    }
+  }
+}
+
+// 버전을 아는 프레임 하나 (layout.size 바이트)를 values[COL_COUNT]로
+inline void decodeFrame(const FrameLayout &layout, const uint8_t* frame, float* values) {
+  float* columns[COL_COUNT];
+  for (uint8_t c = 0; c < COL_COUNT; c++) columns[c] = &values[c];
+  decodeFrames(layout, frame, layout.size, 1, columns);
+}
+
+// 디스크립터 없는 프레임 하나를 values[COL_COUNT]로 (반환: 알 수 없는 버전이면 false)
+inline bool decodeFrame(FrameKind kind, const uint8_t* frame, size_t size, float* values) {
+  const FrameLayout* layout = findFrameLayout(kind, size);
+  if (!layout) return false;
+
+  decodeFrame(*layout, frame, values);
+  return true;
+}
+
+// 업링크 하나의 해석 결과
+struct UplinkInfo {
+  FrameClass frame_class;
+  const FrameLayout* layout;   // nullptr: 알 수 없는 포트/버전 또는 진단 프레임
+  uint8_t descriptor;          // 0: 디스크립터 없는 구 프레임
+  const uint8_t* header;       // 포트별 헤더 (경과 시간, 설정 응답)
+  uint8_t header_size;
+};
+
+// FPort + 페이로드 → values[COL_COUNT] (반환: 측정 데이터를 디코딩했으면 true)
+// 묶음(CLASS_DELTA_BATCH)은 info만 채우고 false → decodeDeltaBlock()으로
+// legacy_kind: 디스크립터 없는 구 펌웨어 프레임일 때 가정할 센서 종류 (장치 등록 정보)
+inline bool decodeUplink(uint8_t fport, const uint8_t* payload, size_t len, FrameKind legacy_kind,
+                         UplinkInfo &info, float* values) {
+  info = UplinkInfo();
+  const PortRoute* route = findPortRoute(fport);
+  if (!route || len < route->header_size) return false;
+
+  info.frame_class = route->frame_class;
+  info.header = payload;
+  info.header_size = route->header_size;
+  const uint8_t* frame = payload + route->header_size;
+  size_t size = len - route->header_size;
+  if (size == 0) return false;  // 측정 데이터 없는 설정 응답
+
+  if (isFrameDescriptor(frame[0])) {
+    info.descriptor = frame[0];
+    if (info.frame_class == CLASS_DIAGNOSTIC || info.frame_class == CLASS_DELTA_BATCH) return false;
+    info.layout = layoutForDescriptor(frame[0]);
+    if (info.layout && size != (size_t)FRAME_DESCRIPTOR_SIZE + info.layout->size) info.layout = nullptr;
+    if (!info.layout) return false;
+  } else {
+    info.layout = findFrameLayout(legacy_kind, size);
+    if (!info.layout) return false;
+  }
+
+  decodeFrame(*info.layout, frame + (info.descriptor ? FRAME_DESCRIPTOR_SIZE : 0), values);
+  return true;
+}
+
+#endif
@@ -0,0 +1,363 @@
+// ============================================================================
+// 페이로드 디코더 벤치마크 (pio run -e native && .pio/build/native/program [프레임 수])
+//
+// 버전별로 프레임 N개를 이어 붙인 버퍼를 만들어
+//  - 행 단위: decodeFrame()을 프레임마다 호출 (기존 수집 서비스 방식)
+//  - 배치: decodeFrames()로 열 배열에 한 번에
+// 두 방식의 처리량을 출력하고 결과가 값 단위로 같은지 확인
+// 시작 전에 FPort/디스크립터 분기(decodeUplink)가 버전별로 같은 값을 내는지 먼저 확인
+//
+// 이어서 델타 압축 (펌웨어 delta_codec.h 인코더 → delta_decoder.h): 현재 버전마다 합성 시계열로
+// 무선 묶음(DR0 36바이트, DR5 227바이트)/플래시 묶음(512바이트) 압축률과 처리량을 재고
+// 원래 프레임으로 되돌아오는지 확인
+// 기록 파일을 주면 ([초] [디스크립터 포함 프레임 hex] 줄 단위) 그 데이터로도 같은 측정을 함
+// ============================================================================
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "payload_decoder.h"
+#include "delta_decoder.h"
+#include "delta_codec.h"      // 펌웨어 인코더 (../LoRa_Node/lib/LoRaNodeCore/src)
+
+#define BENCH_DEFAULT_FRAMES 4000000
+#define BENCH_REPEAT 3              // 가장 빠른 회차 기록
+#define DELTA_SERIES_FRAMES 200000  // 합성 시계열 길이
+#define RADIO_BATCH_DR0_BYTES 36    // uplink_queue.h batchPayloadLimit() DR0
+#define RADIO_BATCH_DR5_BYTES 227   // uplink_queue.h batchPayloadLimit() DR5
+#define HISTORY_BLOCK_BYTES 512     // history_log.h HISTORY_BLOCK_SIZE
+
+// 재현 가능한 의사 난수 (xorshift32)
+static uint32_t bench_seed = 0x12345678;
+static uint32_t nextRandom() {
+  bench_seed ^= bench_seed << 13;
+  bench_seed ^= bench_seed >> 17;
+  bench_seed ^= bench_seed << 5;
+  return bench_seed;
+}
+
+// 측정값은 무작위, 상태/준비 바이트는 대부분 켜짐 (가끔 꺼져서 NAN 경로도 지나감)
+static void fillFrames(const FrameLayout &layout, std::vector<uint8_t> &buffer, size_t count) {
+  buffer.resize(layout.size * count);
+  for (size_t i = 0; i < count; i++) {
+    uint8_t* f = &buffer[i * layout.size];
+    for (uint8_t b = 0; b < layout.size; b++) f[b] = (uint8_t)nextRandom();
+    for (uint8_t j = 0; j < layout.field_count; j++) {
+      const FieldLayout &field = layout.fields[j];
+      if (field.gate_bits) f[field.gate_offset] |= (nextRandom() & 0x0F) ? field.gate_bits : 0;
+      if (field.ready_bits) f[field.ready_offset] |= (nextRandom() & 0x0F) ? field.ready_bits : 0;
+    }
+  }
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool sameValues(const float* a, const float* b) {
+  for (uint8_t c = 0; c < COL_COUNT; c++) {
+    if (!(a[c] == b[c] || (isnan(a[c]) && isnan(b[c])))) return false;
+  }
+  return true;
+}
+
+// 버전마다 포트별 프레임 (측정/밀린 측정값/설정 응답, 구 프레임)을 decodeUplink로 풀어 직접 디코딩과 비교
+static bool checkDispatch(const FrameLayout &layout) {
+  std::vector<uint8_t> frame;
+  fillFrames(layout, frame, 1);
+  float expected[COL_COUNT];
+  decodeFrame(layout, frame.data(), expected);
+
+  uint8_t payload[3 + FRAME_DESCRIPTOR_SIZE + 64];
+  float values[COL_COUNT];
+  UplinkInfo info;
+  bool ok = true;
+
+  static const uint8_t ports[] = {1, 2, 11};
+  for (uint8_t fport : ports) {
+    const PortRoute* route = findPortRoute(fport);
+    memset(payload, 0x5A, route->header_size);
+    payload[route->header_size] = frameDescriptor(layout.kind, layout.version, FRAME_FLAG_BOOT);
+    memcpy(payload + route->header_size + FRAME_DESCRIPTOR_SIZE, frame.data(), layout.size);
+    size_t len = route->header_size + FRAME_DESCRIPTOR_SIZE + layout.size;
+
+    // legacy_kind를 일부러 다르게 줘도 디스크립터가 우선
+    FrameKind other = layout.kind == FRAME_STAIR ? FRAME_AIR_STATION : FRAME_STAIR;
+    ok &= decodeUplink(fport, payload, len, other, info, values) && info.layout == &layout &&
+          info.frame_class == route->frame_class && sameValues(values, expected);
+  }
+
+  // 디스크립터 없는 구 프레임은 센서 종류 + 길이로
+  bool legacy = isFrameDescriptor(frame[0]) ||
+                (decodeUplink(1, frame.data(), layout.size, layout.kind, info, values) &&
+                 info.descriptor == 0 && sameValues(values, expected));
+  return ok && legacy;
+}
+
+static void benchLayout(const FrameLayout &layout, size_t count) {
+  std::vector<uint8_t> frames;
+  fillFrames(layout, frames, count);
+
+  // 행 단위 (프레임마다 COL_COUNT 값)
+  std::vector<float> rows(count * COL_COUNT);
+  double row_ms = 1e30;
+  for (int r = 0; r < BENCH_REPEAT; r++) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+      decodeFrame(layout.kind, &frames[i * layout.size], layout.size, &rows[i * COL_COUNT]);
+    }
+    double ms = elapsedMs(start);
+    if (ms < row_ms) row_ms = ms;
+  }
+
+  // 배치 (열 배열)
+  std::vector<float> storage(count * COL_COUNT);
+  float* columns[COL_COUNT];
+  for (uint8_t c = 0; c < COL_COUNT; c++) columns[c] = &storage[c * count];
+  double batch_ms = 1e30;
+  for (int r = 0; r < BENCH_REPEAT; r++) {
+    auto start = std::chrono::steady_clock::now();
+    decodeFrames(layout, frames.data(), layout.size, count, columns);
+    double ms = elapsedMs(start);
+    if (ms < batch_ms) batch_ms = ms;
+  }
+
+  // 결과 확인: 두 방식의 모든 값이 같아야 함 (둘 다 NAN 포함)
+  size_t mismatches = 0;
+  for (uint8_t c = 0; c < COL_COUNT; c++) {
+    for (size_t i = 0; i < count; i++) {
+      float row = rows[i * COL_COUNT + c];
+      float batch = columns[c][i];
+      if (!(row == batch || (isnan(row) && isnan(batch)))) mismatches++;
+    }
+  }
+
+  double mb = frames.size() / 1e6;
+  printf("%-11s %2dB  row %8.1fms %7.1f Mframe/s   batch %7.1fms %7.1f Mframe/s %7.0f MB/s  x%.1f  %s\n",
+         layout.name, layout.size, row_ms, count / row_ms / 1e3, batch_ms, count / batch_ms / 1e3,
+         mb / batch_ms * 1e3, row_ms / batch_ms, mismatches == 0 ? "✓" : "✗ mismatch");
+}
+
+// ---- 델타 압축 ----
+
+// 합성 시계열 스텝: 열마다 (바뀔 확률 %, 최대 걸음 raw)
+static void seriesStep(uint8_t column, int &chance, int &step) {
+  switch (column) {
+    case COL_TEMP_BME: case COL_TEMP_BMP: case COL_TEMP_AM: chance = 40; step = 1; break;   // ±0.1°C
+    case COL_HUM_BME: case COL_HUM_AM: chance = 50; step = 3; break;                        // ±0.3%
+    case COL_PRESS_BME: case COL_PRESS_BMP: case COL_ALTITUDE: chance = 40; step = 1; break;
+    case COL_CO2: chance = 80; step = 10; break;                                            // ±10ppm
+    case COL_PM1_0: case COL_PM2_5: case COL_PM10: chance = 60; step = 2; break;
+    case COL_PM2_5_MAX: case COL_PM10_MAX: chance = 60; step = 3; break;
+    case COL_PM2_5_SD: chance = 70; step = 5; break;
+    case COL_VOC: case COL_VOC_MAX: chance = 3; step = 1; break;
+    case COL_LINK: chance = 30; step = 1; break;
+    default: chance = 0; step = 0; break;                                                   // 상태/준비/샘플 수
+  }
+}
+
+// 디스크립터 포함 프레임 count개 (60초 ±1초 간격) 무작위 걸음
+static void synthSeries(const FrameLayout &layout, size_t count, std::vector<uint8_t> &frames,
+                        std::vector<uint32_t> &times) {
+  const size_t stride = FRAME_DESCRIPTOR_SIZE + layout.size;
+  frames.resize(stride * count);
+  times.resize(count);
+
+  std::vector<uint8_t> first;
+  fillFrames(layout, first, 1);
+  for (uint8_t j = 0; j < layout.field_count; j++) {
+    const FieldLayout &field = layout.fields[j];
+    if (field.gate_bits) first[field.gate_offset] |= field.gate_bits;
+    if (field.ready_bits) first[field.ready_offset] |= field.ready_bits;
+  }
+  frames[0] = frameDescriptor(layout.kind, layout.version, 0);
+  memcpy(&frames[FRAME_DESCRIPTOR_SIZE], first.data(), layout.size);
+  times[0] = 0;
+
+  for (size_t i = 1; i < count; i++) {
+    uint8_t* f = &frames[i * stride];
+    memcpy(f, f - stride, stride);
+    uint8_t* data = f + FRAME_DESCRIPTOR_SIZE;
+    for (uint8_t j = 0; j < layout.field_count; j++) {
+      const FieldLayout &field = layout.fields[j];
+      int chance, step;
+      seriesStep(field.column, chance, step);
+      if (step == 0 || (int)(nextRandom() % 100) >= chance) continue;
+      int delta = (int)(nextRandom() % (2 * step + 1)) - step;
+      if (field.type == FIELD_U8) {
+        data[field.offset] = (uint8_t)(data[field.offset] + delta);
+      } else {
+        uint16_t v = (uint16_t)((data[field.offset] << 8 | data[field.offset + 1]) + delta);
+        data[field.offset] = v >> 8;
+        data[field.offset + 1] = v & 0xFF;
+      }
+    }
+    times[i] = times[i - 1] + 59 + nextRandom() % 3;
+  }
+}
+
+// 프레임 열 → [길이 u16][묶음] 레코드 열 (플래시 기록 형식, 무선은 레코드 헤더만 빼면 같음)
+// 반환: 묶음 수 (빈 묶음에도 프레임 하나가 안 들어가면 0)
+static size_t encodeSeries(const std::vector<uint8_t> &frames, size_t stride, const std::vector<uint32_t> &times,
+                           uint32_t u16_fields, uint16_t block_bytes, std::vector<uint8_t> &out) {
+  out.assign(frames.size() * 2 + 16, 0);
+  std::vector<uint8_t> buffer(block_bytes);
+  size_t pos = 0, blocks = 0;
+  DeltaBlock block;
+  deltaBegin(block, buffer.data(), block_bytes, u16_fields);
+
+  auto flush = [&]() {
+    out[pos] = block.len >> 8;
+    out[pos + 1] = block.len & 0xFF;
+    memcpy(&out[pos + 2], buffer.data(), block.len);
+    pos += 2 + block.len;
+    blocks++;
+    deltaBegin(block, buffer.data(), block_bytes, u16_fields);
+  };
+
+  for (size_t i = 0; i < times.size(); i++) {
+    if (deltaAdd(block, &frames[i * stride], (uint8_t)stride, times[i])) continue;
+    if (block.count == 0) return 0;
+    flush();
+    deltaAdd(block, &frames[i * stride], (uint8_t)stride, times[i]);
+  }
+  if (block.count) flush();
+  out.resize(pos);
+  return blocks;
+}
+
+// 레코드 열 → 프레임/시각 (반환: 풀어낸 샘플 수)
+static size_t decodeSeries(const std::vector<uint8_t> &stream, std::vector<uint8_t> &frames,
+                           std::vector<uint32_t> &times) {
+  size_t pos = 0, n = 0;
+  const uint8_t* block;
+  size_t block_len;
+  const FrameLayout* layout;
+  while (nextHistoryBlock(stream.data(), stream.size(), pos, block, block_len)) {
+    size_t max = times.size() - n;
+    size_t got = decodeDeltaBlock(block, block_len, &frames[n * DELTA_FRAME_STRIDE_MAX], &times[n],
+                                  max, layout);
+    if (got == 0) break;
+    // 묶음마다 stride가 같으므로 앞으로 당겨 붙임
+    size_t stride = FRAME_DESCRIPTOR_SIZE + layout->size;
+    if (stride != DELTA_FRAME_STRIDE_MAX) {
+      memmove(&frames[n * stride], &frames[n * DELTA_FRAME_STRIDE_MAX], got * stride);
+    }
+    n += got;
+  }
+  return n;
+}
+
+static void benchDelta(const char* name, const FrameLayout &layout, const std::vector<uint8_t> &frames,
+                       const std::vector<uint32_t> &times) {
+  const size_t stride = FRAME_DESCRIPTOR_SIZE + layout.size;
+  const size_t count = times.size();
+  const uint32_t u16_fields = deltaFieldMask(layout);
+  static const uint16_t block_sizes[] = {RADIO_BATCH_DR0_BYTES, RADIO_BATCH_DR5_BYTES, HISTORY_BLOCK_BYTES};
+
+  for (uint16_t block_bytes : block_sizes) {
+    std::vector<uint8_t> stream;
+    size_t blocks = 0;
+    double enc_ms = 1e30, dec_ms = 1e30;
+    for (int r = 0; r < BENCH_REPEAT; r++) {
+      auto start = std::chrono::steady_clock::now();
+      blocks = encodeSeries(frames, stride, times, u16_fields, block_bytes, stream);
+      double ms = elapsedMs(start);
+      if (ms < enc_ms) enc_ms = ms;
+    }
+    bool radio = block_bytes != HISTORY_BLOCK_BYTES;
+    if (blocks == 0) {
+      printf("delta %-11s %-6s %3dB  frame does not fit (firmware sends FPort 2 single frames)\n",
+             name, radio ? "radio" : "flash", block_bytes);
+      continue;
+    }
+
+    std::vector<uint8_t> decoded(count * DELTA_FRAME_STRIDE_MAX + DELTA_FRAME_STRIDE_MAX);
+    std::vector<uint32_t> decoded_times(count);
+    size_t n = 0;
+    for (int r = 0; r < BENCH_REPEAT; r++) {
+      auto start = std::chrono::steady_clock::now();
+      n = decodeSeries(stream, decoded, decoded_times);
+      double ms = elapsedMs(start);
+      if (ms < dec_ms) dec_ms = ms;
+    }
+    bool ok = n == count && memcmp(decoded.data(), frames.data(), count * stride) == 0 &&
+              decoded_times == times;
+
+    // 무선 묶음은 레코드 헤더 없이 업링크 하나가 묶음 하나
+    size_t encoded = stream.size() - (radio ? blocks * 2 : 0);
+    double raw_mb = frames.size() / 1e6;
+    printf("delta %-11s %-6s %3dB  x%4.1f (%5.1fB/frame, %5.1f frames/%s)  enc %6.0f MB/s  dec %6.0f MB/s  %s\n",
+           name, radio ? "radio" : "flash", block_bytes, (double)frames.size() / encoded,
+           (double)encoded / count, (double)count / blocks, radio ? "uplink" : "block",
+           raw_mb / enc_ms * 1e3, raw_mb / dec_ms * 1e3, ok ? "✓" : "✗ mismatch");
+  }
+}
+
+// 기록 파일: 줄마다 "[초] [디스크립터 포함 프레임 hex]", 첫 줄의 디스크립터와 같은 프레임만 사용
+static bool loadRecorded(const char* path, const FrameLayout* &layout, std::vector<uint8_t> &frames,
+                         std::vector<uint32_t> &times) {
+  FILE* file = fopen(path, "r");
+  if (!file) return false;
+  layout = nullptr;
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    char* p = line;
+    uint32_t t = strtoul(p, &p, 10);
+    while (*p == ' ' || *p == '\t') p++;
+    uint8_t frame[DELTA_FRAME_STRIDE_MAX];
+    size_t len = 0;
+    unsigned byte;
+    while (len < sizeof(frame) && sscanf(p, "%2x", &byte) == 1) {
+      frame[len++] = (uint8_t)byte;
+      p += 2;
+    }
+    if (len == 0 || !isFrameDescriptor(frame[0])) continue;
+    if (!layout) layout = layoutForDescriptor(frame[0]);
+    if (!layout || (!frames.empty() && frame[0] != frames[0])) continue;
+    if (len != (size_t)FRAME_DESCRIPTOR_SIZE + layout->size) continue;
+    frames.insert(frames.end(), frame, frame + len);
+    times.push_back(t);
+  }
+  fclose(file);
+  return layout && !times.empty();
+}
+
+int main(int argc, char** argv) {
+  size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : BENCH_DEFAULT_FRAMES;
+  printf("Payload decoder benchmark: %zu frames per layout, best of %d\n", count, BENCH_REPEAT);
+
+  for (size_t i = 0; i < FRAME_LAYOUT_COUNT; i++) {
+    printf("dispatch %-11s v%d  %s\n", FRAME_LAYOUTS[i].name, FRAME_LAYOUTS[i].version,
+           checkDispatch(FRAME_LAYOUTS[i]) ? "✓" : "✗ mismatch");
+  }
+
+  for (size_t i = 0; i < FRAME_LAYOUT_COUNT; i++) {
+    benchLayout(FRAME_LAYOUTS[i], count);
+  }
+
+  // 델타 압축: 디스크립터를 쓰는 버전마다 (같은 종류의 가장 높은 버전)
+  for (size_t i = 0; i < FRAME_LAYOUT_COUNT; i++) {
+    const FrameLayout &layout = FRAME_LAYOUTS[i];
+    if (i + 1 < FRAME_LAYOUT_COUNT && FRAME_LAYOUTS[i + 1].kind == layout.kind) continue;
+    std::vector<uint8_t> frames;
+    std::vector<uint32_t> times;
+    synthSeries(layout, DELTA_SERIES_FRAMES, frames, times);
+    benchDelta(layout.name, layout, frames, times);
+  }
+
+  if (argc > 2) {
+    const FrameLayout* layout;
+    std::vector<uint8_t> frames;
+    std::vector<uint32_t> times;
+    if (!loadRecorded(argv[2], layout, frames, times)) {
+      printf("✗ %s: no descriptor frames\n", argv[2]);
+      return 1;
+    }
+    printf("recorded %s: %zu %s frames\n", argv[2], times.size(), layout->name);
+    benchDelta("recorded", *layout, frames, times);
+  }
+  return 0;
+}
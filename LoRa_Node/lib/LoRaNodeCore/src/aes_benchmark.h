@@ -0,0 +1,82 @@
+#ifndef _AES_BENCHMARK_H
+#define _AES_BENCHMARK_H
+
+#include "esp_timer.h"
+#include "lorawan_crypto.h"
+
+// ============================================================================
+// 업링크 프레임당 LoRaWAN 암호 연산 시간/에너지: 소프트웨어 vs 하드웨어 AES (NODE_AES_BENCH)
+//
+// 프레임 하나 = FRMPayload 암호화(16바이트당 1블록) + MIC(B0 | MHDR..FRMPayload CMAC)
+// 측정 프레임 하나부터 DR5 최대 묶음까지 크기별로 AES_BENCH_ROUNDS번 평균, 두 구현의 MIC가 같은지도 확인
+// 에너지 = 시간 × NODE_ACTIVE_MA × 3.3V (대략 값이므로 실측 전류로 바꿔 써야 의미 있음)
+// ============================================================================
+
+#ifndef NODE_ACTIVE_MA
+#define NODE_ACTIVE_MA 40.0f        // CPU 동작 중 보드 전류 (라디오 대기)
+#endif
+
+#define AES_BENCH_ROUNDS 200
+#define AES_BENCH_VOLTAGE 3.3f
+#define AES_BENCH_FHDR_SIZE 9       // MHDR 1 + FHDR 7 + FPort 1
+#define AES_BENCH_MAX_PAYLOAD 242   // KR920 DR5 최대 FRMPayload
+
+struct AesBenchResult {
+  float us;          // 프레임당 시간
+  uint32_t blocks;   // 프레임당 AES 블록 수
+  uint32_t mic;      // 마지막 프레임 MIC (구현 비교용)
+};
+
+static AesBenchResult benchFrameCrypto(uint8_t backend, uint8_t* msg, uint8_t payload_len) {
+  static const uint8_t key[AES_BLOCK_SIZE] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6,
+                                              0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+  const uint32_t dev_addr = 0x260B0000;
+  AesBenchResult result = {0, 0, 0};
+  aes_backend = backend;
+  uint32_t blocks = aes_blocks;
+
+  int64_t start = esp_timer_get_time();
+  for (uint32_t fcnt = 0; fcnt < AES_BENCH_ROUNDS; fcnt++) {
+    lorawanCryptPayload(key, LORAWAN_DIR_UPLINK, dev_addr, fcnt, msg + AES_BENCH_FHDR_SIZE, payload_len);
+    result.mic = lorawanDataMic(key, LORAWAN_DIR_UPLINK, dev_addr, fcnt, msg, AES_BENCH_FHDR_SIZE + payload_len);
+  }
+  result.us = (float)(esp_timer_get_time() - start) / AES_BENCH_ROUNDS;
+  result.blocks = (aes_blocks - blocks) / AES_BENCH_ROUNDS;
+  return result;
+}
+
+static float benchEnergyUj(float us) { return us * NODE_ACTIVE_MA * AES_BENCH_VOLTAGE / 1000.0f; }
+
+// frame_size: 이 노드의 측정 프레임 크기 (디스크립터 포함)
+void runAesBenchmark(uint8_t frame_size) {
+  const uint8_t sizes[] = {frame_size, 51, 115, AES_BENCH_MAX_PAYLOAD};
+  static uint8_t msg[AES_BENCH_FHDR_SIZE + AES_BENCH_MAX_PAYLOAD];
+  uint8_t saved_backend = aes_backend;
+
+  Serial.println("=== LoRaWAN crypto benchmark (per uplink frame) ===");
+  Serial.printf("CPU %uMHz, %.0fmA assumed, %d rounds\n", getCpuFrequencyMhz(), NODE_ACTIVE_MA, AES_BENCH_ROUNDS);
+#ifdef NODE_HW_AES
+  Serial.printf("RadioLib hook: %u calls since boot%s\n", aes_hook_calls,
+                aes_hook_calls ? "" : " - check -Wl,--wrap flags");
+#else
+  Serial.println("Hardware AES not enabled (NODE_HW_AES) - software only");
+#endif
+
+  for (uint8_t size : sizes) {
+    for (size_t i = 0; i < sizeof(msg); i++) msg[i] = (uint8_t)i;
+    AesBenchResult sw = benchFrameCrypto(AES_BACKEND_SOFT, msg, size);
+    Serial.printf("%3uB: %2u blocks, SW %7.1fus %6.1fuJ", size, sw.blocks, sw.us, benchEnergyUj(sw.us));
+#ifdef NODE_HW_AES
+    for (size_t i = 0; i < sizeof(msg); i++) msg[i] = (uint8_t)i;
+    AesBenchResult hw = benchFrameCrypto(AES_BACKEND_HW, msg, size);
+    Serial.printf(", HW %7.1fus %6.1fuJ (x%.1f) %s", hw.us, benchEnergyUj(hw.us), hw.us > 0 ? sw.us / hw.us : 0.0f,
+                  hw.mic == sw.mic ? "✓" : "✗ MIC mismatch");
+#endif
+    Serial.println();
+  }
+
+  aes_backend = saved_backend;
+  Serial.println("====================================================");
+}
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef _AIR_STATION_H
+#define _AIR_STATION_H
+
+#include "bme280.h"
+#include "bmp390.h"
+#include "am1008w_i2c_bus.h"
+
+// ============================================================================
+// 복합 공기질 노드 드라이버 (AM1008W-K-P + BME280 + BMP390, 한 I2C 버스 GPIO41/42)
+// NODE_SENSOR_AIR_STATION 환경에서 사용, 인터페이스는 sensor_node.h 참고
+// AM1008W는 필수, BME280/BMP390은 선택 (없으면 상태 플래그만 꺼짐)
+//
+// 같은 버스에서 AM1008W는 ≤30kHz(기본 10kHz), Bosch 센서는 400kHz로 동작 (i2c_bus.h).
+// pollSensors()가 클럭별로 묶어서 Bosch 두 칩을 400kHz로 먼저 트리거한 뒤 AM1008W
+// 프레임을 저속으로 읽으므로 클럭 전환은 주기당 두 번뿐임
+//
+// 32바이트 페이로드 (앞 20바이트는 구 LoRa_AM1008W_uart 문서 구조와 동일):
+//   [0-1] BME280 온도  [2-3] BME280 습도  [4-5] BME280 압력
+//   [6-7] AM1008W 온도  [8-9] AM1008W 습도  [10-11] CO2  [12-13] PM2.5  [14-15] PM10
+//   [16] VOC Level  [17] 센서 상태 (bit0 BME280, bit1 BMP390, bit2 AM1008W)
+//   [18] 링크 품질 (link_quality.h)  [19] AM1008W 항목별 준비 비트 (AM1008_READY_*, 예열 중이면 값 없음)
+//   [20-21] BMP390 압력  [22-23] PM1.0
+//   [24-31] AM1008W 구간 통계 (am1008w.h encodeAm1008Stats, CO2/PM 값은 구간 평균)
+// ============================================================================
+
+#define AIR_STATUS_BME280 0x01
+#define AIR_STATUS_BMP390 0x02
+#define AIR_STATUS_AM1008W 0x04
+
+typedef Am1008w<Am1008I2cBus> AirStationAm1008w;
+
+// 센서 데이터 구조체
+struct AirStationData {
+  float temperature_bme;  // BME280 온도
+  float humidity_bme;     // BME280 습도
+  float pressure_bme;     // BME280 압력
+  float pressure_bmp;     // BMP390 압력
+  AM1008Data am;          // AM1008W 측정값
+  uint8_t status;         // AIR_STATUS_* (이번 주기에 유효한 센서)
+};
+
+// 주기 측정 스케줄 (bit i = air_station_tasks[i])
+const SensorTask air_station_tasks[] = {
+  SENSOR_TASK("BME280", Bme280),
+  SENSOR_TASK("BMP390", Bmp390),
+  SENSOR_TASK("AM1008W", AirStationAm1008w),
+};
+
+class AirStation {
+ public:
+  typedef AirStationData Reading;
+  static const uint8_t PAYLOAD_SIZE = 24 + AM1008_STATS_SIZE;
+  static const uint8_t FRAME_TYPE = FRAME_TYPE_AIR_STATION;
+  static const uint8_t FRAME_VERSION = 3;  // 바이트 배치 변경 시 증가
+  static const uint32_t DELTA_U16_FIELDS = 0x54505555;  // 16비트 필드 시작 위치 [0-14], [20-22], [26-30] 짝수 바이트
+
+  const char* title() { return " LoRa:Air "; }
+  const char* splashTitle() { return "LoRa-Air Station"; }
+
+  bool begin() {
+    // AM1008W 먼저 (버스 초기화, I2C 모드 대기, 주소 감지 포함)
+    am1008w.begin();
+
+    Serial.println("Attempting BME280 initialization...");
+    bme280_available = Bme280::begin(sensorBus, BME280_ADDRESS);
+    Serial.println(bme280_available ? "✓ BME280 initialized (0x76)" : "BME280 not found at 0x76 - continuing without it");
+    displayInitScreen(bme280_available ? "BME280 OK" : "BME280 not found");
+
+    Serial.println("Attempting BMP390 initialization...");
+    bmp390_available = Bmp390::begin(sensorBus, BMP390_ADDRESS);
+    Serial.println(bmp390_available ? "✓ BMP390 initialized (0x77)" : "BMP390 not found at 0x77 - continuing without it");
+    displayInitScreen(bmp390_available ? "BMP390 OK" : "BMP390 not found");
+
+    return AirStationAm1008w::isAvailable();
+  }
+
+  Reading read() {
+    AirStationData data;
+    data.temperature_bme = NAN;
+    data.humidity_bme = NAN;
+    data.pressure_bme = NAN;
+    data.pressure_bmp = NAN;
+    data.status = 0;
+
+    uint8_t enabled = 0;
+    if (bme280_available) enabled |= 0x01;
+    if (bmp390_available) enabled |= 0x02;
+    if (AirStationAm1008w::isAvailable()) enabled |= 0x04;
+
+    uint8_t collected = pollSensors(air_station_tasks, 3, enabled);
+
+    if (collected & 0x01) {
+      const Bme280Result &bme = Bme280::data();
+      if (bme.temperature >= -40 && bme.temperature <= 85 && bme.humidity >= 0 && bme.humidity <= 100 &&
+          bme.pressure >= 800 && bme.pressure <= 1200) {
+        data.temperature_bme = bme.temperature;
+        data.humidity_bme = bme.humidity;
+        data.pressure_bme = bme.pressure;
+        data.status |= AIR_STATUS_BME280;
+      } else {
+        Serial.println("Warning: Invalid BME280 reading");
+      }
+    }
+
+    if (collected & 0x02) {
+      const Bmp390Result &bmp = Bmp390::data();
+      if (bmp.pressure >= 800 && bmp.pressure <= 1200) {
+        data.pressure_bmp = bmp.pressure;
+        data.status |= AIR_STATUS_BMP390;
+      } else {
+        Serial.println("Warning: Invalid BMP390 pressure reading");
+      }
+    }
+
+    data.am = AirStationAm1008w::data();
+    if ((collected & 0x04) && data.am.valid) data.status |= AIR_STATUS_AM1008W;
+    if (!(collected & 0x04)) data.am.valid = false;
+
+    return data;
+  }
+
+  // 센서 데이터를 바이트 배열로 변환 (없는 값은 0xFFFF / 0)
+  void encode(const Reading &data, uint8_t* buffer) {
+    uint16_t temp_bme = 0xFFFF, hum_bme = 0xFFFF, press_bme = 0xFFFF, press_bmp = 0xFFFF;
+    uint16_t temp_am = 0xFFFF, hum_am = 0xFFFF, co2 = 0, pm25 = 0, pm10 = 0, pm1 = 0;
+    uint8_t voc = 0, am_ready = 0;
+
+    if (data.status & AIR_STATUS_BME280) {
+      temp_bme = (uint16_t)((data.temperature_bme + 40) * 10);
+      hum_bme = (uint16_t)(data.humidity_bme * 10);
+      press_bme = (uint16_t)((data.pressure_bme - 800) * 10);
+    }
+    if (data.status & AIR_STATUS_BMP390) {
+      press_bmp = (uint16_t)((data.pressure_bmp - 800) * 10);
+    }
+    if (data.status & AIR_STATUS_AM1008W) {
+      if (!isnan(data.am.temperature)) temp_am = (uint16_t)((data.am.temperature + 40) * 10);
+      if (!isnan(data.am.humidity)) hum_am = (uint16_t)(data.am.humidity * 10);
+      am_ready = data.am.ready;
+      if (am_ready & AM1008_READY_CO2) co2 = data.am.co2;
+      if (am_ready & AM1008_READY_PM) {
+        pm25 = data.am.pm2_5;
+        pm10 = data.am.pm10;
+        pm1 = data.am.pm1_0;
+      }
+      if (am_ready & AM1008_READY_VOC) voc = data.am.voc_level;
+    }
+
+    buffer[0] = temp_bme >> 8;        // BME280 온도 상위
+    buffer[1] = temp_bme & 0xFF;      // BME280 온도 하위
+    buffer[2] = hum_bme >> 8;         // BME280 습도 상위
+    buffer[3] = hum_bme & 0xFF;       // BME280 습도 하위
+    buffer[4] = press_bme >> 8;       // BME280 압력 상위
+    buffer[5] = press_bme & 0xFF;     // BME280 압력 하위
+    buffer[6] = temp_am >> 8;         // AM1008W 온도 상위
+    buffer[7] = temp_am & 0xFF;       // AM1008W 온도 하위
+    buffer[8] = hum_am >> 8;          // AM1008W 습도 상위
+    buffer[9] = hum_am & 0xFF;        // AM1008W 습도 하위
+    buffer[10] = co2 >> 8;            // CO2 상위
+    buffer[11] = co2 & 0xFF;          // CO2 하위
+    buffer[12] = pm25 >> 8;           // PM2.5 상위
+    buffer[13] = pm25 & 0xFF;         // PM2.5 하위
+    buffer[14] = pm10 >> 8;           // PM10 상위
+    buffer[15] = pm10 & 0xFF;         // PM10 하위
+    buffer[16] = voc;                 // VOC Level
+    buffer[17] = data.status;         // 센서 상태 플래그
+    buffer[18] = encodeLinkQuality(consecutive_send_failures); // 링크 품질
+    buffer[19] = am_ready;            // AM1008W 항목별 준비 비트
+    buffer[20] = press_bmp >> 8;      // BMP390 압력 상위
+    buffer[21] = press_bmp & 0xFF;    // BMP390 압력 하위
+    buffer[22] = pm1 >> 8;            // PM1.0 상위
+    buffer[23] = pm1 & 0xFF;          // PM1.0 하위
+    if (data.status & AIR_STATUS_AM1008W) {
+      encodeAm1008Stats(data.am, buffer + 24);  // AM1008W 구간 통계
+    } else {
+      memset(buffer + 24, 0, AM1008_STATS_SIZE);
+    }
+  }
+
+  void print(const Reading &data) {
+    if (data.status & AIR_STATUS_BME280) {
+      Serial.println("BME280 - Temp: " + String(data.temperature_bme, 1) + "°C, Humidity: " +
+                     String(data.humidity_bme, 1) + "%, Pressure: " + String(data.pressure_bme, 1) + "hPa");
+    } else {
+      Serial.println("BME280 - Not available");
+    }
+
+    if (data.status & AIR_STATUS_BMP390) {
+      Serial.println("BMP390 - Pressure: " + String(data.pressure_bmp, 2) + "hPa");
+    } else {
+      Serial.println("BMP390 - Not available");
+    }
+
+    am1008w.print(data.am);
+  }
+
+  void draw(const Reading &data) {
+    // 온습도는 BME280 우선 (AM1008W 내부 온습도는 팬/레이저 발열 영향을 받음)
+    bool bme = data.status & AIR_STATUS_BME280;
+    float temperature = bme ? data.temperature_bme : data.am.temperature;
+    float humidity = bme ? data.humidity_bme : data.am.humidity;
+
+    display.drawBitmap(0, DISPLAY_ROW_1, icon_temp, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_1);
+    display.print("Temp: ");
+    if (isnan(temperature)) {
+      display.println("N/A");
+    } else {
+      display.print(temperature, 1);
+      display.println(" C");
+    }
+
+    display.drawBitmap(0, DISPLAY_ROW_2, icon_humidity, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_2);
+    display.print("Humi: ");
+    if (isnan(humidity)) {
+      display.println("N/A");
+    } else {
+      display.print(humidity, 1);
+      display.println(" %");
+    }
+
+    display.drawBitmap(0, DISPLAY_ROW_3, icon_co2, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_3);
+    display.print("CO2: ");
+    if (!(data.status & AIR_STATUS_AM1008W)) {
+      display.println("N/A");
+    } else if (data.am.ready & AM1008_READY_CO2) {
+      display.print(data.am.co2);
+      display.println(" ppm");
+    } else {
+      display.println("warm-up");
+    }
+
+    display.drawBitmap(0, DISPLAY_ROW_4, icon_pm, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_4);
+    display.print("PM2.5: ");
+    if (!(data.status & AIR_STATUS_AM1008W)) {
+      display.println("N/A");
+    } else if (data.am.ready & AM1008_READY_PM) {
+      display.print(data.am.pm2_5);
+      display.println(" ug/m3");
+    } else {
+      display.println("warm-up");
+    }
+  }
+
+  void onConfigActions(uint8_t actions) {}
+
+ private:
+  AirStationAm1008w am1008w;
+  bool bme280_available = false;
+  bool bmp390_available = false;
+};
+
+#endif
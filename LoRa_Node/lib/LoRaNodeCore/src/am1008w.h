@@ -0,0 +1,626 @@
+#ifndef _AM1008W_H
+#define _AM1008W_H
+
+#include "node_display.h"
+#include "sensor_driver.h"
+#include "running_stats.h"
+
+// ============================================================================
+// AM1008W-K-P 복합 공기질 센서 드라이버 (CO2, VOC, 온습도, PM1.0/2.5/10)
+// 측정 프레임 해석/검증/인코딩은 공통이고, 프레임을 가져오는 방법만 Bus가 담당
+//  - am1008w_uart_bus.h : UART 명령-응답 (NODE_SENSOR_AM1008W_UART)
+//  - am1008w_i2c_bus.h  : I2C 동적 주소 감지 (NODE_SENSOR_AM1008W_I2C)
+//
+// Bus 인터페이스 (모두 static):
+//   const char* splashTitle();
+//   bool begin();                      // 버스 초기화 및 센서 감지
+//   bool trigger();                    // 측정 요청 (비차단)
+//   bool collect(uint8_t* frame);      // AM1008_FRAME_SIZE 바이트, 헤더 확인까지
+//   bool sendCommand(uint8_t cmd, uint16_t value);  // 제어 명령 (AM1008_CMD_*)
+//   void printWiringHelp();            // 초기화 실패 시 배선 안내
+//   uint16_t i2cKhz();                 // 센서 I2C 버스 클럭 (UART면 0)
+//   READY_MS                           // trigger 후 응답이 준비되기까지 시간
+//   SLEEP_OK                           // 응답 대기 중 Light Sleep 허용 (UART 수신 중이면 false)
+//   RETRY_DELAY_MS                     // 초기화 테스트 재시도 간격
+//
+// 측정 상태와 프레임 버퍼는 정적 할당이며, 칩 단계 함수(trigger/readyInMs/collect)는
+// sensor_driver.h 스케줄러에 그대로 등록됨
+//
+// PM 듀티 사이클 (node_config.pm_duty_cycle, 원격 명령 CMD_SET_PM_MODE):
+// 센서 전류(최대 300mA)의 대부분은 PM 측정용 팬과 레이저이므로, 측정 사이에는 입자 측정을
+// 닫아 두고 trigger()에서 열어 예열(≤8초) + 갱신 1회를 기다린 뒤 collect()에서 읽고 다시 닫음.
+// 예열 대기는 pollSensors()가 Light Sleep으로 보내며 CO2/VOC/온습도 센서는 계속 동작함
+// 0x0C 데이터 인코딩이 확인되지 않았으므로 빌드 기본값은 연속 측정(NODE_PM_DUTY_CYCLE 0)이고,
+// 켜더라도 열기/닫기 명령이 실패하거나(UART 응답 없음/다른 응답, I2C 쓰기 실패) 닫은 뒤에도 PM 값이
+// 계속 바뀌면(닫기 무시) 재부팅 전까지 연속 측정으로 돌아가고 상태 플래그 0x04로 알림
+//
+// 측정 항목별 예열 (사양서: PM ≤8초, CO2 ≤30초, VOC ≤120초):
+// 전원 투입(부팅)과 입자 측정을 켠 시각을 기준으로 항목마다 준비 여부를 따로 판단해
+// AM1008Data.ready에 표시하고, 준비되지 않은 항목은 값 없음으로 보냄.
+// PM은 예열 8초만 남은 만큼 기다린 뒤 바로 측정하고 CO2/VOC는 안정될 때까지 비트만 꺼 둠
+//
+// 구간 통계 (node_config.stats_window_s/stats_period_s, 원격 명령 CMD_SET_SAMPLING):
+// 센서는 1초마다 갱신되므로 PM이 켜져 있는 동안 window초에 걸쳐 period초마다 샘플을 모아
+// Welford 통계(running_stats.h)로 요약함. CO2/PM은 평균을 보내고 PM은 최대/표준편차를,
+// VOC는 최대를 함께 보내 발걸음 등으로 생기는 짧은 PM 급상승을 놓치지 않음 (window 0이면 단일 샘플)
+//
+// 24바이트 페이로드:
+//   [0-1] 온도 (NaN이면 0xFFFF)  [2-3] 습도 (NaN이면 0xFFFF)  [4-5] CO2 평균
+//   [6-7] PM2.5 평균  [8-9] PM10 평균  [10-11] PM1.0 평균  [12] VOC Level
+//   [13] 센서 상태 플래그 (0x01 감지, 0x02 유효, 0x04 PM 듀티 사이클 포기 → 연속 측정)
+//   [14] 링크 품질 (link_quality.h)  [15] 항목별 준비 비트 (AM1008_READY_*)
+//   [16-23] 구간 통계 (encodeAm1008Stats)
+// ============================================================================
+
+#define AM1008_FRAME_SIZE 25
+#define AM1008_INIT_ATTEMPTS 3
+
+// 제어 명령 코드 (사양서 시리얼 명령표, I2C는 D3에 같은 코드 사용)
+#define AM1008_CMD_PM_SWITCH 0x0C       // [u16] 입자 측정(팬 + 레이저) 열기/닫기
+
+// 0x0C 데이터 (DF1: 0x02 열기 / 0x01 닫기, DF2: 0x1E)
+// 사양서(docs/am1008w_datasheet.md)에는 명령 코드만 있고 데이터 인코딩이 없음. 아래 값은 같은 제조사
+// (Cubic) 레이저 PM 센서 UART 프로토콜의 입자 측정 열기/닫기 예시 프레임을 따른 것이므로
+// AM1008W-K 원본 사양서나 실물로 다시 확인해야 함 (닫기가 안 먹으면 듀티 사이클 전류가 줄지 않음)
+#define AM1008_PM_OPEN 0x021E           // 11 03 0C 02 1E C0
+#define AM1008_PM_CLOSE 0x011E          // 11 03 0C 01 1E C1
+
+// 열기/닫기 명령 상태 (확인 전에는 듀티 사이클을 하되, 실패하면 연속 측정으로)
+#define AM1008_PM_SWITCH_UNVERIFIED 0
+#define AM1008_PM_SWITCH_OK 1
+#define AM1008_PM_SWITCH_FAILED 2
+
+// AM1008_PM_WARMUP_MS(PM 예열 시간)는 설정 검증에도 쓰므로 remote_config.h에 있음
+#define AM1008_CO2_WARMUP_MS 30000      // CO2 예열 시간 (사양서 ≤30초, 전원 투입 기준)
+#define AM1008_VOC_WARMUP_MS 120000     // VOC 예열 시간 (사양서 ≤120초, 전원 투입 기준)
+#define AM1008_UPDATE_MS 1000           // 측정값 갱신 주기 (예열 후 한 번 더 갱신된 값을 읽음)
+
+// 측정 항목별 준비 비트 (AM1008Data.ready, 페이로드 준비 바이트)
+#define AM1008_READY_TH 0x01            // 온습도 (예열 불필요)
+#define AM1008_READY_CO2 0x02
+#define AM1008_READY_VOC 0x04
+#define AM1008_READY_PM 0x08
+
+#define AM1008_STATS_SIZE 8             // 구간 통계 페이로드 크기
+
+const unsigned char PROGMEM icon_co2[] = {
+  0x00, 0x3C, 0x42, 0x99, 0x99, 0x42, 0x3C, 0x00  // 🌫️ CO2 (구름 모양)
+};
+
+const unsigned char PROGMEM icon_pm[] = {
+  0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA  // 🌪️ 미세먼지 (점점이)
+};
+
+// AM1008W-K-P 센서 데이터 구조체
+struct AM1008Data {
+  float temperature;
+  float humidity;
+  uint16_t co2;
+  uint8_t voc_level;
+  uint16_t pm1_0;
+  uint16_t pm2_5;
+  uint16_t pm10;
+  bool valid;
+  uint8_t ready;      // AM1008_READY_* (예열이 끝난 항목만 유효)
+
+  // 구간 통계 (PM/CO2 값은 샘플 평균, samples가 1이면 단일 샘플)
+  uint8_t samples;
+  uint8_t voc_max;
+  uint16_t pm2_5_max;
+  float pm2_5_stddev;
+  uint16_t pm10_max;
+};
+
+// 구간 통계 8바이트 (PM이 준비되지 않았으면 샘플 수만):
+//   [0] 샘플 수  [1] VOC 최대  [2-3] PM2.5 최대  [4-5] PM2.5 표준편차 x10  [6-7] PM10 최대
+void encodeAm1008Stats(const AM1008Data &data, uint8_t* buffer) {
+  bool pm = data.ready & AM1008_READY_PM;
+  uint16_t pm25_max = pm ? data.pm2_5_max : 0;
+  uint16_t pm25_sd = pm ? (uint16_t)(data.pm2_5_stddev * 10 + 0.5f) : 0;
+  uint16_t pm10_max = pm ? data.pm10_max : 0;
+
+  buffer[0] = data.samples;
+  buffer[1] = (data.ready & AM1008_READY_VOC) ? data.voc_max : 0;
+  buffer[2] = pm25_max >> 8;
+  buffer[3] = pm25_max & 0xFF;
+  buffer[4] = pm25_sd >> 8;
+  buffer[5] = pm25_sd & 0xFF;
+  buffer[6] = pm10_max >> 8;
+  buffer[7] = pm10_max & 0xFF;
+}
+
+// UART 체크섬: 앞 바이트 합과 더해 0이 되는 값 (예: 11 02 01 01 → EB)
+uint8_t am1008Checksum(const uint8_t* bytes, size_t len) {
+  uint8_t sum = 0;
+  for (size_t i = 0; i < len; i++) sum += bytes[i];
+  return (uint8_t)(0x100 - sum);
+}
+
+// 송수신 바이트 출력 (8바이트마다 줄바꿈)
+void printAm1008Bytes(const char* label, const uint8_t* bytes, size_t len) {
+  Serial.print(label);
+  for (size_t i = 0; i < len; i++) {
+    Serial.print("0x");
+    if (bytes[i] < 16) Serial.print("0");
+    Serial.print(bytes[i], HEX);
+    Serial.print(" ");
+    if ((i + 1) % 8 == 0) Serial.println();
+  }
+  Serial.println();
+}
+
+template <typename Bus>
+class Am1008w {
+ public:
+  typedef AM1008Data Reading;
+  static const uint8_t PAYLOAD_SIZE = 16 + AM1008_STATS_SIZE;
+  static const uint8_t FRAME_TYPE = FRAME_TYPE_AM1008W;
+  static const uint8_t FRAME_VERSION = 2;  // 바이트 배치 변경 시 증가
+  static const uint32_t DELTA_U16_FIELDS = 0x00540555;  // 16비트 필드 시작 위치 [0-10], [18-22] 짝수 바이트
+
+  const char* title() { return " LoRa:AM1008W "; }
+  const char* splashTitle() { return Bus::splashTitle(); }
+
+  bool begin() {
+    Serial.println("Attempting AM1008W-K-P initialization...");
+    displayInitScreen("Init AM1008W-K-P...");
+
+    if (!Bus::begin()) {
+      Serial.println("✗ AM1008W-K-P not detected on bus");
+    }
+
+    // AM1008W-K-P 테스트 (3번 시도)
+    for (int attempt = 1; attempt <= AM1008_INIT_ATTEMPTS; attempt++) {
+      Serial.println("AM1008W-K-P test attempt " + String(attempt) + "/" + String(AM1008_INIT_ATTEMPTS));
+      if (pollSensors(&task, 1) && last.valid) {
+        Serial.println("✓ AM1008W-K-P sensor detected and working!");
+        available = true;
+        displayInitScreen("AM1008W-K-P OK");
+        if (node_config.pm_duty_cycle) {
+          parseFrame(frame, closed_at, false);  // 닫기 확인용
+          if (!setParticleMeasurement(false)) particleSwitchFailed("close command failed");  // 첫 측정 주기까지 팬/레이저 끔
+        }
+        return true;
+      }
+      Serial.println("✗ AM1008W-K-P test failed on attempt " + String(attempt));
+      if (attempt < AM1008_INIT_ATTEMPTS) {
+        delay(Bus::RETRY_DELAY_MS);
+      }
+    }
+
+    Serial.println("WARNING: AM1008W-K-P sensor initialization failed!");
+    Bus::printWiringHelp();
+    Serial.println("Continuing without sensor for debugging...");
+    displayInitScreen("AM1008W-K-P FAIL!");
+    delay(2000);
+    // 디버깅을 위해 재시작하지 않고 계속 진행
+    return false;
+  }
+
+  Reading read() {
+    if (!available) return emptyData();
+    if (!pollSensors(&task, 1)) return emptyData();
+    return last;
+  }
+
+  // 센서 데이터를 바이트 배열로 변환
+  void encode(const Reading &data, uint8_t* buffer) {
+    // AM1008W 데이터 (NaN이면 특별값으로 설정)
+    uint16_t temp_am = 0xFFFF, hum_am = 0xFFFF, co2_am = 0, pm1_am = 0, pm25_am = 0, pm10_am = 0;
+    uint8_t voc_am = 0;
+
+    if (available && data.valid) {
+      // 온도 처리 (NaN 체크)
+      if (!isnan(data.temperature)) {
+        temp_am = (uint16_t)((data.temperature + 40) * 10);
+      }
+
+      // 습도 처리 (NaN 체크)
+      if (!isnan(data.humidity)) {
+        hum_am = (uint16_t)(data.humidity * 10);
+      }
+
+      // 다른 데이터들 (예열 중인 항목은 값 없음)
+      if (data.ready & AM1008_READY_CO2) co2_am = data.co2;
+      if (data.ready & AM1008_READY_PM) {
+        pm1_am = data.pm1_0;
+        pm25_am = data.pm2_5;
+        pm10_am = data.pm10;
+      }
+      if (data.ready & AM1008_READY_VOC) voc_am = data.voc_level;
+    }
+
+    // 센서 상태 플래그 (비트마스크)
+    uint8_t sensor_status = 0;
+    if (available) sensor_status |= 0x01;
+    if (data.valid) sensor_status |= 0x02;
+    if (pm_switch == AM1008_PM_SWITCH_FAILED) sensor_status |= 0x04;
+
+    // 패킷 구성
+    buffer[0] = temp_am >> 8;           // AM1008W 온도 상위
+    buffer[1] = temp_am & 0xFF;         // AM1008W 온도 하위
+    buffer[2] = hum_am >> 8;            // AM1008W 습도 상위
+    buffer[3] = hum_am & 0xFF;          // AM1008W 습도 하위
+    buffer[4] = co2_am >> 8;            // AM1008W CO2 상위
+    buffer[5] = co2_am & 0xFF;          // AM1008W CO2 하위
+    buffer[6] = pm25_am >> 8;           // AM1008W PM2.5 상위
+    buffer[7] = pm25_am & 0xFF;         // AM1008W PM2.5 하위
+    buffer[8] = pm10_am >> 8;           // AM1008W PM10 상위
+    buffer[9] = pm10_am & 0xFF;         // AM1008W PM10 하위
+    buffer[10] = pm1_am >> 8;           // AM1008W PM1.0 상위
+    buffer[11] = pm1_am & 0xFF;         // AM1008W PM1.0 하위
+    buffer[12] = voc_am;                // AM1008W VOC Level
+    buffer[13] = sensor_status;         // 센서 상태 플래그
+    buffer[14] = encodeLinkQuality(consecutive_send_failures); // 링크 품질
+    buffer[15] = data.valid ? data.ready : 0; // 항목별 준비 비트
+    if (available && data.valid) {
+      encodeAm1008Stats(data, buffer + 16);   // 구간 통계
+    } else {
+      memset(buffer + 16, 0, AM1008_STATS_SIZE);
+    }
+  }
+
+  void print(const Reading &data) {
+    if (!available || !data.valid) {
+      Serial.println("AM1008W-K-P sensor not available or invalid data");
+      return;
+    }
+
+    Serial.print("Temperature: ");
+    if (isnan(data.temperature)) {
+      Serial.println("N/A");
+    } else {
+      Serial.println(String(data.temperature, 1) + "C");
+    }
+
+    Serial.print("Humidity: ");
+    if (isnan(data.humidity)) {
+      Serial.println("N/A");
+    } else {
+      Serial.println(String(data.humidity, 1) + "%");
+    }
+
+    const char* co2_note = (data.ready & AM1008_READY_CO2) ? "" : " (warming up)";
+    const char* voc_note = (data.ready & AM1008_READY_VOC) ? "" : " (warming up)";
+    const char* pm_note = (data.ready & AM1008_READY_PM) ? "" : " (warming up)";
+    Serial.printf("CO2: %d ppm%s\n", data.co2, co2_note);
+    Serial.printf("VOC Level: %d%s\n", data.voc_level, voc_note);
+    Serial.printf("PM1.0: %d ug/m3%s\n", data.pm1_0, pm_note);
+    Serial.printf("PM2.5: %d ug/m3%s\n", data.pm2_5, pm_note);
+    Serial.printf("PM10: %d ug/m3%s\n", data.pm10, pm_note);
+    printAm1008Stats(data);
+  }
+
+  static void printAm1008Stats(const AM1008Data &data) {
+    if (data.samples < 2) return;
+    Serial.printf("Window: %d samples, PM2.5 max %d sd %.1f, PM10 max %d, VOC max %d\n", data.samples,
+                  data.pm2_5_max, data.pm2_5_stddev, data.pm10_max, data.voc_max);
+  }
+
+  void draw(const Reading &data) {
+    if (!available || !data.valid) {
+      display.setCursor(12, DISPLAY_ROW_1);
+      display.println("AM1008W-K-P");
+      display.setCursor(12, DISPLAY_ROW_2);
+      display.println("Sensor Error");
+      display.setCursor(12, DISPLAY_ROW_3);
+      display.println("Check Connection");
+      return;
+    }
+
+    // 온도
+    display.drawBitmap(0, DISPLAY_ROW_1, icon_temp, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_1);
+    display.print("Temp: ");
+    if (isnan(data.temperature)) {
+      display.println("N/A");
+    } else {
+      display.print(data.temperature, 1);
+      display.println(" C");
+    }
+
+    // 습도
+    display.drawBitmap(0, DISPLAY_ROW_2, icon_humidity, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_2);
+    display.print("Humi: ");
+    if (isnan(data.humidity)) {
+      display.println("N/A");
+    } else {
+      display.print(data.humidity, 1);
+      display.println(" %");
+    }
+
+    // CO2
+    display.drawBitmap(0, DISPLAY_ROW_3, icon_co2, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_3);
+    display.print("CO2: ");
+    if (data.ready & AM1008_READY_CO2) {
+      display.print(data.co2);
+      display.println(" ppm");
+    } else {
+      display.println("warm-up");
+    }
+
+    // PM2.5
+    display.drawBitmap(0, DISPLAY_ROW_4, icon_pm, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_4);
+    display.print("PM2.5: ");
+    if (data.ready & AM1008_READY_PM) {
+      display.print(data.pm2_5);
+      display.println(" ug/m3");
+    } else {
+      display.println("warm-up");
+    }
+  }
+
+  void onConfigActions(uint8_t actions) {}
+
+  // 칩 단계 인터페이스 (sensor_driver.h)
+  static const SensorTask task;
+
+  // 입자 측정을 켜고, PM 예열이 남아 있으면 그만큼 기다린 뒤 collect()에서 측정 요청
+  // (듀티 사이클 모드는 매 주기 켜므로 항상 예열, 연속 모드는 부팅 직후에만)
+  // 열기 명령이 실패해도 측정은 계속함 (CO2/VOC/온습도는 유효, PM은 pm_on에 따라 준비 비트로 표시)
+  static bool trigger() {
+    duty_cycle = available && node_config.pm_duty_cycle && pm_switch != AM1008_PM_SWITCH_FAILED;
+    if (duty_cycle && !pm_on && pm_switch == AM1008_PM_SWITCH_UNVERIFIED) verifyParticleClosed();
+    if ((duty_cycle || !pm_on) && !setParticleMeasurement(true)) {
+      particleSwitchFailed("open command failed");
+    }
+
+    warmup_wait_ms = pmWarmupRemainingMs();
+    if (warmup_wait_ms > 0) {
+      warmup_wait_ms += AM1008_UPDATE_MS;
+      Serial.printf("AM1008W PM warming up, measuring in %lums\n", (unsigned long)warmup_wait_ms);
+      return true;
+    }
+    return Bus::trigger();
+  }
+
+  static uint32_t readyInMs() { return warmup_wait_ms > 0 ? warmup_wait_ms : Bus::READY_MS; }
+
+  static uint16_t i2cKhz() { return Bus::i2cKhz(); }
+
+  // 예열 중에는 주고받는 데이터가 없으므로 UART여도 Light Sleep 가능
+  static bool sleepOk() { return warmup_wait_ms > 0 || Bus::SLEEP_OK; }
+
+  static bool collect() {
+    last = emptyData();
+    // 예열을 기다렸으면 trigger 때 요청하지 않았으므로 지금 요청
+    bool ok = requestFrame(warmup_wait_ms > 0);
+    if (ok) {
+      parseFrame(frame, last);
+      last.ready = readyFlags();
+      if (last.valid && available) sampleWindow();  // 초기화 테스트는 단일 샘플
+    }
+    if (duty_cycle) {
+      if (ok) parseFrame(frame, closed_at, false);  // 닫기 확인용 마지막 원시 값
+      if (!setParticleMeasurement(false)) particleSwitchFailed("close command failed");  // 다음 주기까지 팬/레이저 끔
+    }
+    return ok;
+  }
+
+  // 지금 측정하면 유효한 항목 (AM1008_READY_*)
+  static uint8_t readyFlags() {
+    uint32_t powered_ms = millis() - powered_at;
+    uint8_t ready = AM1008_READY_TH;
+    if (powered_ms >= AM1008_CO2_WARMUP_MS) ready |= AM1008_READY_CO2;
+    if (powered_ms >= AM1008_VOC_WARMUP_MS) ready |= AM1008_READY_VOC;
+    if (pm_on && pmWarmupRemainingMs() == 0) ready |= AM1008_READY_PM;
+    return ready;
+  }
+
+  // ---- 작동 모드 제어 ----
+
+  // 입자 측정 열기/닫기 (팬 + 레이저 전원)
+  static bool setParticleMeasurement(bool on) {
+    bool ok = Bus::sendCommand(AM1008_CMD_PM_SWITCH, on ? AM1008_PM_OPEN : AM1008_PM_CLOSE);
+    if (ok && on && !pm_on) pm_on_at = millis();  // 꺼져 있다 켜졌으면 예열 다시 시작
+    if (ok) pm_on = on;
+    Serial.printf("%s AM1008W particle measurement %s\n", ok ? "✓" : "✗", on ? "on" : "off");
+    return ok;
+  }
+
+  static const AM1008Data& data() { return last; }
+
+  static bool isAvailable() { return available; }
+
+ private:
+  static bool available;
+  static bool pm_on;          // 입자 측정(팬/레이저) 상태, 전원 투입 시 켜져 있음
+  static bool duty_cycle;     // 이번 측정 주기가 듀티 사이클 모드인지
+  static uint8_t pm_switch;   // 입자 측정 열기/닫기 명령 상태 (AM1008_PM_SWITCH_*)
+  static AM1008Data closed_at;      // 입자 측정을 닫을 때의 원시 값 (닫기 확인용)
+  static uint32_t powered_at;       // 센서 전원 투입 시각 (보드와 같은 5V라 부팅 시각)
+  static uint32_t pm_on_at;         // 입자 측정을 마지막으로 켠 시각
+  static uint32_t warmup_wait_ms;   // 이번 주기 PM 예열 대기 (0이면 바로 측정)
+  static RunningStats co2_stats, pm1_stats, pm25_stats, pm10_stats;
+
+  // fresh: 측정 요청부터 (아니면 trigger()에서 요청한 응답만 읽음)
+  static bool requestFrame(bool fresh) {
+    if (fresh) {
+      if (!Bus::trigger()) return false;
+      delay(Bus::READY_MS);
+    }
+    return Bus::collect(frame);
+  }
+
+  // last(첫 샘플)부터 window 동안 period마다 샘플을 모아 last를 구간 통계로 바꿈
+  // 예열 중인 항목은 통계에 넣지 않음
+  static void sampleWindow() {
+    co2_stats.reset();
+    pm1_stats.reset();
+    pm25_stats.reset();
+    pm10_stats.reset();
+    uint8_t voc_max = 0;
+    uint8_t samples = 0;
+
+    AM1008Data sample = last;
+    uint32_t start = millis();
+    uint32_t window_ms = node_config.stats_window_s * 1000UL;
+    while (true) {
+      if (sample.valid) {
+        uint8_t ready = readyFlags();
+        if (ready & AM1008_READY_CO2) co2_stats.add(sample.co2);
+        if (ready & AM1008_READY_PM) {
+          pm1_stats.add(sample.pm1_0);
+          pm25_stats.add(sample.pm2_5);
+          pm10_stats.add(sample.pm10);
+        }
+        if (sample.voc_level > voc_max) voc_max = sample.voc_level;
+        if (samples < UINT8_MAX) samples++;
+      }
+
+      if (millis() - start + node_config.stats_period_s * 1000UL > window_ms) break;
+      sensorWait(node_config.stats_period_s * 1000UL, Bus::SLEEP_OK);
+      sample = emptyData();
+      if (requestFrame(true)) parseFrame(frame, sample, false);
+    }
+
+    last.samples = samples;
+    last.voc_max = voc_max;
+    last.ready = readyFlags();
+    if (co2_stats.count) last.co2 = (uint16_t)(co2_stats.mean + 0.5f);
+    if (pm25_stats.count) {
+      last.pm1_0 = (uint16_t)(pm1_stats.mean + 0.5f);
+      last.pm2_5 = (uint16_t)(pm25_stats.mean + 0.5f);
+      last.pm10 = (uint16_t)(pm10_stats.mean + 0.5f);
+      last.pm2_5_max = (uint16_t)pm25_stats.max;
+      last.pm2_5_stddev = pm25_stats.stddev();
+      last.pm10_max = (uint16_t)pm10_stats.max;
+    }
+    if (samples > 1) {
+      Serial.printf("AM1008W window: %d samples in %lums\n", samples, millis() - start);
+    }
+  }
+  static AM1008Data last;
+  static uint8_t frame[AM1008_FRAME_SIZE];
+
+  // 열기/닫기 명령을 믿을 수 없음: 재부팅 전까지 연속 측정 (원격 설정으로 다시 켜도 무시)
+  static void particleSwitchFailed(const char* reason) {
+    if (pm_switch == AM1008_PM_SWITCH_FAILED) return;
+    pm_switch = AM1008_PM_SWITCH_FAILED;
+    duty_cycle = false;
+    Serial.printf("⚠ AM1008W PM duty cycle disabled (%s) - continuous sampling\n", reason);
+  }
+
+  // 닫은 뒤 첫 주기에 열기 전에 한 번 읽어, PM 값이 닫을 때와 다르면 센서가 닫기를 무시한 것
+  // (닫혀 있으면 PM 값이 그대로이거나 0, 읽기 실패는 판단 보류)
+  static void verifyParticleClosed() {
+    AM1008Data probe = emptyData();
+    if (!requestFrame(true)) return;
+    parseFrame(frame, probe, false);
+    if (!probe.valid || !closed_at.valid) return;
+
+    bool unchanged = probe.pm1_0 == closed_at.pm1_0 && probe.pm2_5 == closed_at.pm2_5 &&
+                     probe.pm10 == closed_at.pm10;
+    bool zeroed = probe.pm1_0 == 0 && probe.pm2_5 == 0 && probe.pm10 == 0;
+    if (unchanged || zeroed) {
+      pm_switch = AM1008_PM_SWITCH_OK;
+      Serial.println("✓ AM1008W particle measurement close confirmed");
+    } else {
+      pm_on = true;   // 닫기 무시 → 계속 켜져 있었으므로 예열도 필요 없음
+      particleSwitchFailed("close ignored, PM values still changing");
+    }
+  }
+
+  static uint32_t pmWarmupRemainingMs() {
+    uint32_t on_ms = millis() - pm_on_at;
+    return on_ms >= AM1008_PM_WARMUP_MS ? 0 : AM1008_PM_WARMUP_MS - on_ms;
+  }
+
+  static AM1008Data emptyData() {
+    AM1008Data data;
+    data.temperature = NAN;
+    data.humidity = NAN;
+    data.co2 = 0;
+    data.voc_level = 0;
+    data.pm1_0 = 0;
+    data.pm2_5 = 0;
+    data.pm10 = 0;
+    data.valid = false;
+    data.ready = 0;
+    data.samples = 0;
+    data.voc_max = 0;
+    data.pm2_5_max = 0;
+    data.pm2_5_stddev = 0;
+    data.pm10_max = 0;
+    return data;
+  }
+
+  // 측정 프레임 데이터시트 기준 파싱 (UART/I2C 동일 위치)
+  static void parseFrame(const uint8_t* frame, AM1008Data &data, bool verbose = true) {
+    // CO2: [DF1][DF2] (0~5,000 ppm)
+    data.co2 = (frame[3] << 8) | frame[4];
+
+    // VOC: [DF3][DF4] (0~3 level)
+    data.voc_level = (frame[5] << 8) | frame[6];
+
+    // 습도: [DF5][DF6] ÷ 10 (5.0~99.0%)
+    uint16_t humidity_raw = (frame[7] << 8) | frame[8];
+    data.humidity = humidity_raw / 10.0;
+
+    // 온도: (DF7 * 256 + DF8 - 500) / 10 (데이터시트 공식)
+    uint16_t temp_raw = (frame[9] << 8) | frame[10];
+    data.temperature = (temp_raw - 500) / 10.0;
+
+    // PM1.0 / PM2.5 / PM10: [DF9]~[DF14] (0~1,000 ug/m³)
+    data.pm1_0 = (frame[11] << 8) | frame[12];
+    data.pm2_5 = (frame[13] << 8) | frame[14];
+    data.pm10 = (frame[15] << 8) | frame[16];
+
+    // 데이터 유효성 검사
+    if (data.co2 <= 5000 &&
+        data.humidity >= 0 && data.humidity <= 100 &&
+        data.temperature >= -40 && data.temperature <= 85 &&
+        data.pm1_0 <= 1000 && data.pm2_5 <= 1000 && data.pm10 <= 1000 &&
+        data.voc_level <= 3) {
+      data.valid = true;
+      if (!verbose) return;
+
+      Serial.println("Parsed data:");
+      Serial.println("  CO2: " + String(data.co2) + " ppm");
+      Serial.println("  VOC: " + String(data.voc_level) + " level");
+      Serial.println("  Humidity: " + String(data.humidity, 1) + " %");
+      Serial.println("  Temperature: " + String(data.temperature, 1) + " °C");
+      Serial.println("  PM1.0: " + String(data.pm1_0) + " ug/m³");
+      Serial.println("  PM2.5: " + String(data.pm2_5) + " ug/m³");
+      Serial.println("  PM10: " + String(data.pm10) + " ug/m³");
+    } else {
+      Serial.println("✗ Sensor data validation failed - values out of range");
+    }
+  }
+};
+
+template <typename Bus>
+const SensorTask Am1008w<Bus>::task = SENSOR_TASK("AM1008W", Am1008w<Bus>);
+template <typename Bus>
+bool Am1008w<Bus>::available = false;
+template <typename Bus>
+bool Am1008w<Bus>::pm_on = true;
+template <typename Bus>
+bool Am1008w<Bus>::duty_cycle = false;
+template <typename Bus>
+uint8_t Am1008w<Bus>::pm_switch = AM1008_PM_SWITCH_UNVERIFIED;
+template <typename Bus>
+AM1008Data Am1008w<Bus>::closed_at = {};
+template <typename Bus>
+uint32_t Am1008w<Bus>::powered_at = 0;
+template <typename Bus>
+uint32_t Am1008w<Bus>::pm_on_at = 0;
+template <typename Bus>
+uint32_t Am1008w<Bus>::warmup_wait_ms = 0;
+template <typename Bus>
+RunningStats Am1008w<Bus>::co2_stats;
+template <typename Bus>
+RunningStats Am1008w<Bus>::pm1_stats;
+template <typename Bus>
+RunningStats Am1008w<Bus>::pm25_stats;
+template <typename Bus>
+RunningStats Am1008w<Bus>::pm10_stats;
+template <typename Bus>
+AM1008Data Am1008w<Bus>::last;
+template <typename Bus>
+uint8_t Am1008w<Bus>::frame[AM1008_FRAME_SIZE];
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef _AM1008W_I2C_BUS_H
+#define _AM1008W_I2C_BUS_H
+
+#include <esp_system.h>  // esp_reset_reason()
+#include "am1008w.h"
+
+// ============================================================================
+// AM1008W-K-P I2C 전송 (클럭 ≤30kHz, 기본 10kHz - 원격 설정 CMD_SET_I2C_CLOCK)
+// 주소가 모듈마다 달라 부팅 시 후보 범위를 돌며 측정 명령에 유효한 응답을
+// 주는 주소를 찾음. 응답 헤더는 0x16 0x19 (25바이트)
+// 제어 명령은 0x16 0x07 CMD DF1 DF2 0x00 XOR(앞 6바이트) 7바이트 쓰기
+// ============================================================================
+
+// AM1008W-K-P I2C 핀 설정 (별도 I2C 버스)
+#define AM1008_SDA_PIN 41  // GPIO41 (SDA) - AM1008W-K-P SDA에 연결
+#define AM1008_SCL_PIN 42  // GPIO42 (SCL) - AM1008W-K-P SCL에 연결
+
+// 성능 최적화 상수
+#define I2C_RESPONSE_DELAY_MS 50    // I2C 응답 대기 시간 (최적화됨)
+#define I2C_ADDRESS_TEST_DELAY_MS 20 // 주소 테스트 간격 (최적화됨)
+#define I2C_SCAN_DELAY_MS 5         // I2C 스캔 지연 시간 (최적화됨)
+#define AM1008_I2C_MODE_WAIT_MS 10000 // 전원 공급 후 I2C 모드 대기 (데이터시트 10초)
+#define AM1008_I2C_WARM_WAIT_MS 5000  // ESP32만 리셋되어 센서 전원이 유지된 경우 (이미 I2C 모드)
+#define AM1008_DIAG_KHZ 1           // 하드웨어 진단/스캔용 저속 클럭
+
+uint8_t detected_sensor_address = 0;  // 동적으로 감지된 센서 주소
+
+struct Am1008I2cBus {
+  static const uint16_t RETRY_DELAY_MS = 2000;
+  static const uint16_t READY_MS = 0;     // 센서가 자체 갱신한 최신 프레임을 바로 읽음
+  static const bool SLEEP_OK = true;
+
+  static const char* splashTitle() { return "LoRa - Suseo Station"; }
+
+  // 데이터시트 한계 ≤30kHz (원격 설정 CMD_SET_I2C_CLOCK, sensorBus에 이 주소로만 등록)
+  static uint16_t i2cKhz() { return node_config.i2c_clock_khz; }
+
+  // 소프트웨어/패닉/워치독 리셋은 ESP32만 재시작하므로 센서는 전원이 유지되어 이미 I2C 모드
+  // (전원 투입, 브라운아웃, 외부 리셋, Deep Sleep 복귀 등은 센서 전원도 끊겼을 수 있으므로 전체 대기)
+  static bool sensorStayedPowered() {
+    switch (esp_reset_reason()) {
+      case ESP_RST_SW:
+      case ESP_RST_PANIC:
+      case ESP_RST_INT_WDT:
+      case ESP_RST_TASK_WDT:
+      case ESP_RST_WDT:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  static bool begin() {
+    // AM1008W-K-P I2C 모드 대기 (데이터시트: 전원 공급 후 10초), 부팅 후 지난 시간은 빼고 남은 만큼만
+    uint32_t mode_wait_ms = sensorStayedPowered() ? AM1008_I2C_WARM_WAIT_MS : AM1008_I2C_MODE_WAIT_MS;
+    if (millis() < mode_wait_ms) {
+      uint32_t wait_ms = mode_wait_ms - millis();
+      Serial.println("Waiting " + String(wait_ms) + "ms for AM1008W-K-P initialization...");
+      displayInitScreen("Wait for I2C mode...");
+      delay(wait_ms);
+    }
+
+    // AM1008W-K-P용 I2C 초기화 (GPIO41, 42) - sensorBus(Wire) 사용
+    Serial.println("Initializing I2C on GPIO41 (SDA), GPIO42 (SCL)...");
+    sensorBus.begin(AM1008_SDA_PIN, AM1008_SCL_PIN);
+    delay(100);
+    Serial.printf("SDA: GPIO%d, SCL: GPIO%d, Clock: %dkHz\n", AM1008_SDA_PIN, AM1008_SCL_PIN, node_config.i2c_clock_khz);
+
+    // 하드웨어 상세 테스트 및 I2C 주소 스캔 (디버깅용)
+    Serial.println("\n=== Hardware Diagnostic Tests ===");
+    detailedHardwareTest();
+    scanI2CDevices();
+
+    Serial.println("\n=== AM1008W-K-P Detection ===");
+    detected_sensor_address = detectAM1008Sensor();
+    return detected_sensor_address != 0;
+  }
+
+  static bool trigger() {
+    if (detected_sensor_address == 0) {
+      Serial.println("✗ 센서 주소가 감지되지 않았습니다. 초기화가 필요합니다.");
+      return false;
+    }
+    // 원격 설정으로 바뀐 클럭 반영 (이 주소의 트랜잭션에만 적용)
+    sensorBus.setDeviceClock(detected_sensor_address, i2cKhz());
+    return true;
+  }
+
+  // 감지된 주소에서 25바이트 측정 프레임 읽기
+  static bool collect(uint8_t* frame) {
+    Serial.printf("Reading AM1008W-K-P via I2C (0x%02X)...\n", detected_sensor_address);
+    if (!requestFrame(detected_sensor_address, frame)) return false;
+    printAm1008Bytes("Received I2C response: ", frame, AM1008_FRAME_SIZE);
+
+    // 응답 헤더 확인: 0x16 0x19 (25바이트 데이터)
+    if (frame[0] != 0x16 || frame[1] != 0x19) {
+      Serial.println("✗ Invalid I2C response header");
+      Serial.printf("Expected: 0x16 0x19, Got: 0x%02X 0x%02X\n", frame[0], frame[1]);
+      return false;
+    }
+
+    Serial.println("✓ Valid AM1008W-K-P I2C response detected");
+    return true;
+  }
+
+  // 제어 명령 쓰기 (명령 코드는 UART 명령표와 같음, 센서는 쓰기 ACK만 돌려줌)
+  static bool sendCommand(uint8_t cmd, uint16_t value) {
+    if (detected_sensor_address == 0) return false;
+
+    uint8_t command[7] = {0x16, 0x07, cmd, (uint8_t)(value >> 8), (uint8_t)(value & 0xFF), 0x00, 0};
+    for (uint8_t i = 0; i < 6; i++) command[6] ^= command[i];
+
+    printAm1008Bytes("Sending I2C command: ", command, sizeof(command));
+    if (!sensorBus.write(detected_sensor_address, command, sizeof(command))) {
+      Serial.printf("✗ Command 0x%02X: I2C write failed\n", cmd);
+      return false;
+    }
+    delay(I2C_RESPONSE_DELAY_MS);  // 센서가 명령을 처리할 시간
+    return true;
+  }
+
+  static void printWiringHelp() {
+    Serial.println("Check connections:");
+    Serial.println("- AM1008W-K-P SDA -> GPIO41 (pull-up required)");
+    Serial.println("- AM1008W-K-P SCL -> GPIO42 (pull-up required)");
+    Serial.println("- AM1008W-K-P I2C mode jumper set");
+  }
+
+ private:
+  static bool requestFrame(uint8_t address, uint8_t* frame) {
+    size_t received = sensorBus.read(address, frame, AM1008_FRAME_SIZE);
+    if (received < AM1008_FRAME_SIZE) {
+      Serial.printf("주소 0x%02X: 응답 데이터 부족 (%d/%d 바이트)\n", address, (int)received, AM1008_FRAME_SIZE);
+      return false;
+    }
+    return true;
+  }
+
+  // 하드웨어 디버깅 함수
+  static void detailedHardwareTest() {
+    // GPIO 상태 확인
+    Serial.println("GPIO States:");
+    Serial.printf("GPIO41 (SDA): %d\n", digitalRead(AM1008_SDA_PIN));
+    Serial.printf("GPIO42 (SCL): %d\n", digitalRead(AM1008_SCL_PIN));
+
+    // 등록되지 않은 주소는 더 낮은 클럭으로 테스트 (등록된 장치는 자기 클럭 유지)
+    uint16_t probe_khz = sensorBus.setProbeClock(AM1008_DIAG_KHZ);
+    delay(100);
+
+    // 여러 주소에서 응답 테스트
+    Serial.println("Testing I2C addresses:");
+    for (uint8_t addr = 0x20; addr <= 0x30; addr++) {
+      uint8_t error = sensorBus.probe(addr);
+      if (error == 0) {
+        Serial.printf("0x%02X: %d (ACK)\n", addr, error);
+      }
+      delay(10);
+    }
+
+    // I2C 재초기화
+    sensorBus.begin(AM1008_SDA_PIN, AM1008_SCL_PIN);
+    sensorBus.setProbeClock(probe_khz);
+  }
+
+  static void scanI2CDevices() {
+    Serial.println("Scanning I2C devices (improved)...");
+    int nDevices = 0;
+
+    // 더 느린 클럭으로 스캔
+    uint16_t probe_khz = sensorBus.setProbeClock(AM1008_DIAG_KHZ);
+
+    for (uint8_t address = 1; address < 127; address++) {
+      if (sensorBus.probe(address) == 0) {
+        Serial.printf("I2C device found at address 0x%02X !\n", address);
+        nDevices++;
+      }
+      delay(I2C_SCAN_DELAY_MS); // 각 주소 테스트 간 지연 (최적화됨)
+    }
+
+    // 클럭 속도 복원
+    sensorBus.setProbeClock(probe_khz);
+
+    if (nDevices == 0) {
+      Serial.println("No I2C devices found!");
+    } else {
+      Serial.printf("Found %d device(s)\n", nDevices);
+    }
+  }
+
+  // AM1008W-K-P 센서 동적 감지 (찾지 못하면 0)
+  // 헤더와 CO2 범위만 확인하고, 전체 값 검증은 Am1008w::begin()의 측정 테스트가 담당
+  static uint8_t detectAM1008Sensor() {
+    Serial.println("=== AM1008W-K-P 센서 동적 감지 시작 ===");
+
+    // 검색할 주소 범위 정의
+    const uint8_t address_ranges[][2] = {
+      {0x28, 0x2F},  // 범위 1: 0x28~0x2F
+      {0x50, 0x57},  // 범위 2: 0x50~0x57
+      {0x30, 0x37}   // 범위 3: 0x30~0x37
+    };
+
+    const uint8_t command[] = {0x16, 0x02, 0x01, 0x01, 0xEB}; // I2C 데이터 읽기 명령
+    uint8_t response[AM1008_FRAME_SIZE];
+
+    // 후보 주소는 아직 등록 전이므로 AM1008W 클럭으로 탐색
+    uint16_t probe_khz = sensorBus.setProbeClock(i2cKhz());
+
+    // 각 주소 범위에서 검색
+    for (int range = 0; range < 3; range++) {
+      Serial.printf("범위 %d: 0x%02X~0x%02X 검색 중...\n",
+                    range + 1, address_ranges[range][0], address_ranges[range][1]);
+
+      for (uint8_t addr = address_ranges[range][0]; addr <= address_ranges[range][1]; addr++) {
+        // I2C 연결 테스트
+        if (sensorBus.probe(addr) == 0) {
+          Serial.printf("주소 0x%02X: I2C 응답 있음\n", addr);
+
+          // 명령 전송
+          if (sensorBus.write(addr, command, sizeof(command))) {
+            delay(I2C_RESPONSE_DELAY_MS); // 응답 대기 (최적화됨)
+
+            if (requestFrame(addr, response)) {
+              uint16_t co2 = (response[3] << 8) | response[4];
+              if (response[0] == 0x16 && response[1] == 0x19 && co2 <= 5000) {
+                Serial.printf("✓ AM1008W-K-P 센서 발견! 주소: 0x%02X\n", addr);
+                sensorBus.setProbeClock(probe_khz);
+                sensorBus.setDeviceClock(addr, i2cKhz());
+                return addr;
+              }
+              Serial.printf("주소 0x%02X: 유효하지 않은 응답 (0x%02X 0x%02X, CO2 %d)\n",
+                            addr, response[0], response[1], co2);
+            }
+          } else {
+            Serial.printf("주소 0x%02X: 명령 전송 실패\n", addr);
+          }
+        }
+
+        delay(I2C_ADDRESS_TEST_DELAY_MS); // 다음 주소 테스트 전 대기 (최적화됨)
+      }
+    }
+
+    sensorBus.setProbeClock(probe_khz);
+    Serial.println("✗ AM1008W-K-P 센서를 찾을 수 없습니다.");
+    return 0;
+  }
+};
+
+#endif
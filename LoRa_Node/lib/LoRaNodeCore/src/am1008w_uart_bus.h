@@ -0,0 +1,127 @@
+#ifndef _AM1008W_UART_BUS_H
+#define _AM1008W_UART_BUS_H
+
+#include "am1008w.h"
+#include "power_manager.h"  // 명령 ~ 응답 수신 동안 PM 잠금 (NODE_PM_DFS)
+
+// ============================================================================
+// AM1008W-K-P UART 전송 (9600 8N1, 명령-응답 방식)
+// 측정 명령 0x11 0x02 0x01 0x01 0xEB → 응답 0x16 0x16 0x01 + 데이터
+// 제어 명령 0x11 0x03 CMD DF1 DF2 CS → 응답 0x16 LEN CMD ... CS
+// ============================================================================
+
+// AM1008W-K-P UART 핀 설정
+#define AM1008_RX_PIN 47  // GPIO47 (RX) - AM1008W-K-P TX에 연결
+#define AM1008_TX_PIN 48  // GPIO48 (TX) - AM1008W-K-P RX에 연결
+#define AM1008_UART_BAUD 9600
+#define AM1008_UART_TIMEOUT_MS 1000
+#define AM1008_UART_ACK_SIZE 4     // 제어 명령 응답 앞부분 (0x16 LEN CMD DF1)
+
+HardwareSerial am1008Serial(1); // UART1 사용 (AM1008W-K-P용)
+
+struct Am1008UartBus {
+  static const uint16_t RETRY_DELAY_MS = 1000;
+  static const uint16_t READY_MS = 200;   // 명령 후 응답 프레임 전송 완료까지
+  static const bool SLEEP_OK = false;     // Light Sleep 중에는 UART 수신 바이트가 유실됨
+
+  // 응답을 기다리는 동안 자동 Light Sleep/클록 변경 막기 (trigger → collect 사이 delay() 포함)
+  static void holdUart(bool hold) {
+    static bool held = false;
+    if (hold == held) return;
+    held = hold;
+    if (hold) pmAcquire(PM_LOCK_UART);
+    else pmRelease(PM_LOCK_UART);
+  }
+
+  static const char* splashTitle() { return "LoRa-AM1008W Sensors"; }
+
+  static uint16_t i2cKhz() { return 0; }
+
+  static bool begin() {
+    am1008Serial.begin(AM1008_UART_BAUD, SERIAL_8N1, AM1008_RX_PIN, AM1008_TX_PIN);
+    delay(1000); // 센서 안정화 대기
+    return true;
+  }
+
+  // 측정 명령 전송 (명령-응답 방식, 응답은 collect()에서 읽음)
+  static bool trigger() {
+    const uint8_t read_measurement_cmd[] = {0x11, 0x02, 0x01, 0x01, 0xEB};
+
+    // 이전 데이터 비우기
+    while (am1008Serial.available()) {
+      am1008Serial.read();
+    }
+
+    holdUart(true);
+    printAm1008Bytes("Sending command: ", read_measurement_cmd, sizeof(read_measurement_cmd));
+    am1008Serial.write(read_measurement_cmd, sizeof(read_measurement_cmd));
+    return true;
+  }
+
+  // 응답 프레임 읽기 (READY_MS 후 아직 덜 왔으면 타임아웃까지 대기)
+  static bool collect(uint8_t* frame) {
+    unsigned long startTime = millis();
+    while (am1008Serial.available() < AM1008_FRAME_SIZE) {
+      if (millis() - startTime > AM1008_UART_TIMEOUT_MS) {
+        holdUart(false);
+        Serial.print("Timeout! Available bytes: ");
+        Serial.println(am1008Serial.available());
+        return false;
+      }
+      delay(10);
+    }
+
+    am1008Serial.readBytes(frame, AM1008_FRAME_SIZE);
+    holdUart(false);
+    printAm1008Bytes("Received response: ", frame, AM1008_FRAME_SIZE);
+
+    // 응답 헤더 확인: 16 16 01
+    if (frame[0] != 0x16 || frame[1] != 0x16 || frame[2] != 0x01) {
+      Serial.println("✗ Invalid response header");
+      Serial.printf("Expected: 0x16 0x16 0x01, Got: 0x%02X 0x%02X 0x%02X\n", frame[0], frame[1], frame[2]);
+      return false;
+    }
+
+    Serial.println("✓ Valid AM1008W-K-P response detected");
+    return true;
+  }
+
+  // 제어 명령 전송 후 같은 명령 코드의 응답 확인
+  static bool sendCommand(uint8_t cmd, uint16_t value) {
+    uint8_t command[6] = {0x11, 0x03, cmd, (uint8_t)(value >> 8), (uint8_t)(value & 0xFF), 0};
+    command[5] = am1008Checksum(command, 5);
+
+    while (am1008Serial.available()) {
+      am1008Serial.read();
+    }
+    holdUart(true);
+    printAm1008Bytes("Sending command: ", command, sizeof(command));
+    am1008Serial.write(command, sizeof(command));
+
+    uint8_t ack[AM1008_UART_ACK_SIZE];
+    am1008Serial.setTimeout(AM1008_UART_TIMEOUT_MS);
+    size_t received = am1008Serial.readBytes(ack, sizeof(ack));
+    holdUart(false);
+    if (received < sizeof(ack)) {
+      Serial.printf("✗ Command 0x%02X: no response\n", cmd);
+      return false;
+    }
+    if (ack[0] != 0x16 || ack[2] != cmd) {
+      Serial.printf("✗ Command 0x%02X: unexpected response 0x%02X 0x%02X 0x%02X\n", cmd, ack[0], ack[1], ack[2]);
+      return false;
+    }
+
+    // 남은 응답 바이트(데이터 + CS)는 다음 trigger()에서 비움
+    return true;
+  }
+
+  static void printWiringHelp() {
+    Serial.println("Check connections:");
+    Serial.println("- AM1008W-K-P TX -> GPIO47 (ESP32 RX)");
+    Serial.println("- AM1008W-K-P RX -> GPIO48 (ESP32 TX)");
+    Serial.println("- AM1008W-K-P VCC -> 5V");
+    Serial.println("- AM1008W-K-P GND -> GND");
+  }
+};
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef _BATTERY_MONITOR_H
+#define _BATTERY_MONITOR_H
+
+// ============================================================================
+// 배터리 전압/잔량 측정 (NODE_BATTERY 환경 전용, Heltec V3 공식 핀맵 기준)
+// GPIO37(ADC_CTL)을 켠 동안만 분압 회로가 연결되어 GPIO1(ADC1_CH0)로 읽음
+// NODE_ULP_SCREEN이면 ULP RISC-V가 주기마다 읽은 값을 씀 (ulp_monitor.h)
+// ============================================================================
+
+#include <Arduino.h>
+#ifdef NODE_ULP_SCREEN
+// ADC1은 ULP RISC-V가 맡음 (ulp_monitor.h). ulp_riscv_adc_init()이 새 ADC 드라이버라 레거시 driver/adc.h를
+// 같이 링크하면 부팅 시 충돌 검사로 중단 → 보정만 새 API로 하고 값은 ULP 기록의 최신 샘플을 씀
+#include "driver/gpio.h"
+#include "esp_adc/adc_cali.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "ulp_main.h"
+#include "ulp_screen.h"
+#else
+#include "driver/adc.h"
+#include "esp_adc_cal.h"
+#endif
+
+#define ADC_CTL   37
+#define ADC_BAT   1
+#define BATTERY_ADC_SAMPLES 16
+#define BATTERY_DIVIDER_FACTOR 4.9f   // 문서에 기반한 분압 계수
+
+// 배터리 관련 변수들
+float battery_voltage = 0.0;
+int battery_percentage = 0;
+
+#ifdef NODE_ULP_SCREEN
+static adc_cali_handle_t adc_cali = nullptr;
+
+void init_battery_adc() {
+  adc_cali_curve_fitting_config_t cali = {};
+  cali.unit_id = ADC_UNIT_1;
+  cali.atten = ADC_ATTEN_DB_11;
+  cali.bitwidth = ADC_BITWIDTH_12;
+  if (adc_cali_create_scheme_curve_fitting(&cali, &adc_cali) != ESP_OK) adc_cali = nullptr;
+
+  // GPIO37은 RTC 핀이 아니라 ULP가 켜고 끌 수 없음 → 분압 회로를 계속 연결 (분압 전류 수 uA)
+  pinMode(ADC_CTL, OUTPUT);
+  digitalWrite(ADC_CTL, HIGH);
+  gpio_hold_en((gpio_num_t)ADC_CTL);
+}
+
+// ADC 카운트 → 배터리 전압 (V)
+float batteryRawToVoltage(uint32_t raw) {
+  int voltage_mv = 0;
+  if (!adc_cali || adc_cali_raw_to_voltage(adc_cali, (int)raw, &voltage_mv) != ESP_OK) {
+    voltage_mv = (int)(raw * 3100 / 4095);   // 보정 없음: 11dB 감쇠 대략 범위
+  }
+  return voltage_mv * BATTERY_DIVIDER_FACTOR / 1000.0f;
+}
+
+// 배터리 전압 → ADC 카운트 (ULP 임계값 설정용, 보정 곡선이 단조 증가라 이분 탐색)
+uint32_t batteryVoltageToRaw(float voltage) {
+  uint32_t low = 0, high = 4095;
+  while (low < high) {
+    uint32_t mid = (low + high) / 2;
+    if (batteryRawToVoltage(mid) < voltage) low = mid + 1;
+    else high = mid;
+  }
+  return low;
+}
+
+float readBatteryVoltage() {
+  UlpSample latest = ulpScreenLatest((const UlpScreenState*)&ulp_screen_state);
+  return latest.battery_raw ? batteryRawToVoltage(latest.battery_raw) : 0.0f;
+}
+#else
+static esp_adc_cal_characteristics_t adc_chars;
+
+// Meshtastic 방식 ADC 초기화
+void init_battery_adc() {
+  adc1_config_width(ADC_WIDTH_BIT_12); // 12비트 해상도 설정
+  adc1_config_channel_atten(ADC1_CHANNEL_0, ADC_ATTEN_DB_11); // GPIO1 (ADC1_CH0), 0-3.6V 범위
+  esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, 1100, &adc_chars);
+}
+
+// 배터리 전압 측정 함수
+float readBatteryVoltage() {
+  pinMode(ADC_CTL, OUTPUT);
+  digitalWrite(ADC_CTL, HIGH);
+  delay(1);
+
+  uint32_t raw_total = 0;
+  for (int i = 0; i < BATTERY_ADC_SAMPLES; i++) {
+    raw_total += adc1_get_raw(ADC1_CHANNEL_0);
+  }
+  uint32_t raw_avg = raw_total / BATTERY_ADC_SAMPLES;
+
+  digitalWrite(ADC_CTL, LOW);
+
+  uint32_t voltage_mv = esp_adc_cal_raw_to_voltage(raw_avg, &adc_chars);
+  return voltage_mv * BATTERY_DIVIDER_FACTOR / 1000.0;
+}
+#endif
+
+// 배터리 잔량 퍼센트 계산 함수
+int calculateBatteryPercentage(float voltage) {
+  if (voltage < 3.30) return 0;
+  if (voltage < 3.50) return 10;
+  if (voltage < 3.70) return 25;
+  if (voltage < 3.90) return 50;
+  if (voltage < 4.10) return 75;
+  return 100; // 4.22V 이상(충전 중)도 100% 표시
+}
+
+// 배터리 상태 업데이트 함수
+void updateBatteryStatus() {
+  battery_voltage = readBatteryVoltage();
+  battery_percentage = calculateBatteryPercentage(battery_voltage);
+}
+
+#endif
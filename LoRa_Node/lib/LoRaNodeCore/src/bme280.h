@@ -0,0 +1,190 @@
+#ifndef _BME280_H
+#define _BME280_H
+
+#include "sensor_driver.h"
+
+// ============================================================================
+// BME280 레지스터 드라이버 (Forced 모드, 정적 할당)
+// trigger()로 한 번 변환을 시작하고 collect()에서 결과를 읽어 보정함
+// 보정 공식은 Bosch BME280 데이터시트 4.2.3 정수 연산 버전
+// ============================================================================
+
+#define BME280_ADDRESS 0x76
+#define BME280_CHIP_ID 0x60
+#define BME280_I2C_KHZ 400        // Fast mode (sensorBus에 주소별로 등록, AM1008W와 같은 버스여도 400kHz)
+
+#define BME280_REG_CALIB_TP 0x88   // dig_T1 ~ dig_P9 (24바이트)
+#define BME280_REG_CALIB_H1 0xA1
+#define BME280_REG_CHIP_ID 0xD0
+#define BME280_REG_RESET 0xE0
+#define BME280_REG_CALIB_H2 0xE1   // dig_H2 ~ dig_H6 (7바이트)
+#define BME280_REG_CTRL_HUM 0xF2
+#define BME280_REG_STATUS 0xF3
+#define BME280_REG_CTRL_MEAS 0xF4
+#define BME280_REG_CONFIG 0xF5
+#define BME280_REG_DATA 0xF7       // press[3] temp[3] hum[2]
+
+// 오버샘플링: 온도 x2, 압력 x4, 습도 x1 (기압 고도는 BMP390이 담당)
+#define BME280_OSRS_T 0x02
+#define BME280_OSRS_P 0x03
+#define BME280_OSRS_H 0x01
+#define BME280_MODE_FORCED 0x01
+#define BME280_MEASURE_MS 19       // 1.25 + 2.3*2 + (2.3*4+0.575) + (2.3*1+0.575) = 18.5ms (데이터시트 최대)
+
+struct Bme280Calib {
+  uint16_t t1;
+  int16_t t2, t3;
+  uint16_t p1;
+  int16_t p2, p3, p4, p5, p6, p7, p8, p9;
+  uint8_t h1;
+  int16_t h2;
+  uint8_t h3;
+  int16_t h4, h5;
+  int8_t h6;
+};
+
+struct Bme280Result {
+  float temperature;  // °C
+  float humidity;     // %RH
+  float pressure;     // hPa
+};
+
+class Bme280 {
+ public:
+  static bool begin(I2cBus &i2c, uint8_t address = BME280_ADDRESS) {
+    bus = &i2c;
+    addr = address;
+    bus->setDeviceClock(addr, BME280_I2C_KHZ);
+
+    uint8_t id = 0;
+    if (!bus->readRegs(addr, BME280_REG_CHIP_ID, &id, 1) || id != BME280_CHIP_ID) return false;
+
+    // 소프트 리셋 후 NVM 보정값 복사 완료(im_update=0)까지 대기
+    bus->writeReg(addr, BME280_REG_RESET, 0xB6);
+    delay(2);
+    uint8_t status = 0x01;
+    for (uint8_t i = 0; i < 10 && (status & 0x01); i++) {
+      if (!bus->readRegs(addr, BME280_REG_STATUS, &status, 1)) return false;
+      delay(1);
+    }
+
+    if (!readCalibration()) return false;
+
+    // 필터 끔 (Forced 모드에서는 측정 간격이 길어 의미 없음), ctrl_hum은 ctrl_meas보다 먼저 써야 적용됨
+    return bus->writeReg(addr, BME280_REG_CONFIG, 0x00) &&
+           bus->writeReg(addr, BME280_REG_CTRL_HUM, BME280_OSRS_H);
+  }
+
+  static bool trigger() {
+    return bus->writeReg(addr, BME280_REG_CTRL_MEAS,
+                       (BME280_OSRS_T << 5) | (BME280_OSRS_P << 2) | BME280_MODE_FORCED);
+  }
+
+  static uint16_t i2cKhz() { return bus->deviceClock(addr); }
+
+  static bool sleepOk() { return true; }
+
+  static uint32_t readyInMs() { return BME280_MEASURE_MS; }
+
+  static bool collect() {
+    uint8_t raw[8];
+    if (!bus->readRegs(addr, BME280_REG_DATA, raw, sizeof(raw))) return false;
+
+    int32_t adc_p = ((uint32_t)raw[0] << 12) | ((uint32_t)raw[1] << 4) | (raw[2] >> 4);
+    int32_t adc_t = ((uint32_t)raw[3] << 12) | ((uint32_t)raw[4] << 4) | (raw[5] >> 4);
+    int32_t adc_h = ((uint32_t)raw[6] << 8) | raw[7];
+
+    // 변환 전 리셋값(0x80000)이면 아직 측정되지 않은 것
+    if (adc_t == 0x80000) return false;
+
+    int32_t t_fine;
+    result.temperature = compensateTemperature(adc_t, t_fine) / 100.0f;
+    result.pressure = compensatePressure(adc_p, t_fine) / 25600.0f;  // Q24.8 Pa → hPa
+    result.humidity = compensateHumidity(adc_h, t_fine) / 1024.0f;   // Q22.10 %RH
+    return true;
+  }
+
+  static const Bme280Result& data() { return result; }
+
+ private:
+  static I2cBus* bus;
+  static uint8_t addr;
+  static Bme280Calib calib;
+  static Bme280Result result;
+
+  static bool readCalibration() {
+    uint8_t tp[24];
+    uint8_t h[7];
+    if (!bus->readRegs(addr, BME280_REG_CALIB_TP, tp, sizeof(tp)) ||
+        !bus->readRegs(addr, BME280_REG_CALIB_H1, &calib.h1, 1) ||
+        !bus->readRegs(addr, BME280_REG_CALIB_H2, h, sizeof(h))) {
+      return false;
+    }
+
+    calib.t1 = (uint16_t)(tp[1] << 8 | tp[0]);
+    calib.t2 = (int16_t)(tp[3] << 8 | tp[2]);
+    calib.t3 = (int16_t)(tp[5] << 8 | tp[4]);
+    calib.p1 = (uint16_t)(tp[7] << 8 | tp[6]);
+    calib.p2 = (int16_t)(tp[9] << 8 | tp[8]);
+    calib.p3 = (int16_t)(tp[11] << 8 | tp[10]);
+    calib.p4 = (int16_t)(tp[13] << 8 | tp[12]);
+    calib.p5 = (int16_t)(tp[15] << 8 | tp[14]);
+    calib.p6 = (int16_t)(tp[17] << 8 | tp[16]);
+    calib.p7 = (int16_t)(tp[19] << 8 | tp[18]);
+    calib.p8 = (int16_t)(tp[21] << 8 | tp[20]);
+    calib.p9 = (int16_t)(tp[23] << 8 | tp[22]);
+
+    calib.h2 = (int16_t)(h[1] << 8 | h[0]);
+    calib.h3 = h[2];
+    calib.h4 = (int16_t)((int8_t)h[3] * 16 | (h[4] & 0x0F));
+    calib.h5 = (int16_t)((int8_t)h[5] * 16 | (h[4] >> 4));
+    calib.h6 = (int8_t)h[6];
+    return true;
+  }
+
+  // 0.01°C 단위
+  static int32_t compensateTemperature(int32_t adc_t, int32_t &t_fine) {
+    int32_t var1 = ((((adc_t >> 3) - ((int32_t)calib.t1 << 1))) * ((int32_t)calib.t2)) >> 11;
+    int32_t var2 = (((((adc_t >> 4) - ((int32_t)calib.t1)) * ((adc_t >> 4) - ((int32_t)calib.t1))) >> 12) *
+                    ((int32_t)calib.t3)) >> 14;
+    t_fine = var1 + var2;
+    return (t_fine * 5 + 128) >> 8;
+  }
+
+  // Q24.8 Pa
+  static uint32_t compensatePressure(int32_t adc_p, int32_t t_fine) {
+    int64_t var1 = ((int64_t)t_fine) - 128000;
+    int64_t var2 = var1 * var1 * (int64_t)calib.p6;
+    var2 = var2 + ((var1 * (int64_t)calib.p5) << 17);
+    var2 = var2 + (((int64_t)calib.p4) << 35);
+    var1 = ((var1 * var1 * (int64_t)calib.p3) >> 8) + ((var1 * (int64_t)calib.p2) << 12);
+    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)calib.p1) >> 33;
+    if (var1 == 0) return 0;  // 0으로 나누기 방지
+
+    int64_t p = 1048576 - adc_p;
+    p = (((p << 31) - var2) * 3125) / var1;
+    var1 = (((int64_t)calib.p9) * (p >> 13) * (p >> 13)) >> 25;
+    var2 = (((int64_t)calib.p8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (((int64_t)calib.p7) << 4);
+    return (uint32_t)p;
+  }
+
+  // Q22.10 %RH
+  static uint32_t compensateHumidity(int32_t adc_h, int32_t t_fine) {
+    int32_t v = t_fine - ((int32_t)76800);
+    v = (((((adc_h << 14) - (((int32_t)calib.h4) << 20) - (((int32_t)calib.h5) * v)) + ((int32_t)16384)) >> 15) *
+         (((((((v * ((int32_t)calib.h6)) >> 10) * (((v * ((int32_t)calib.h3)) >> 11) + ((int32_t)32768))) >> 10) +
+            ((int32_t)2097152)) * ((int32_t)calib.h2) + 8192) >> 14));
+    v = v - (((((v >> 15) * (v >> 15)) >> 7) * ((int32_t)calib.h1)) >> 4);
+    v = v < 0 ? 0 : v;
+    v = v > 419430400 ? 419430400 : v;
+    return (uint32_t)(v >> 12);
+  }
+};
+
+I2cBus* Bme280::bus = &sensorBus;
+uint8_t Bme280::addr = BME280_ADDRESS;
+Bme280Calib Bme280::calib;
+Bme280Result Bme280::result;
+
+#endif
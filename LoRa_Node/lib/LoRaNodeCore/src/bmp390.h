@@ -0,0 +1,153 @@
+#ifndef _BMP390_H
+#define _BMP390_H
+
+#include "sensor_driver.h"
+
+// ============================================================================
+// BMP390 레지스터 드라이버 (Forced 모드, 정적 할당)
+// trigger()로 한 번 변환을 시작하고 collect()에서 결과를 읽어 보정함
+// 보정 공식은 Bosch BMP390 데이터시트 8.4/8.5 부동소수점 버전
+// ============================================================================
+
+#define BMP390_ADDRESS 0x77
+#define BMP390_CHIP_ID 0x60
+#define BMP390_I2C_KHZ 400        // Fast mode (sensorBus에 주소별로 등록, AM1008W와 같은 버스여도 400kHz)
+
+#define BMP390_REG_CHIP_ID 0x00
+#define BMP390_REG_STATUS 0x03     // bit5 drdy_press, bit6 drdy_temp
+#define BMP390_REG_DATA 0x04       // press[3] temp[3] (LSB 먼저)
+#define BMP390_REG_PWR_CTRL 0x1B
+#define BMP390_REG_OSR 0x1C
+#define BMP390_REG_CONFIG 0x1F
+#define BMP390_REG_CALIB 0x31      // NVM_PAR_T1 ~ NVM_PAR_P11 (21바이트)
+#define BMP390_REG_CMD 0x7E
+
+// 오버샘플링: 압력 x4, 온도 x8 / IIR 계수 3 (기존 Adafruit 설정과 동일)
+#define BMP390_OSR_P 0x02
+#define BMP390_OSR_T 0x03
+#define BMP390_IIR_COEF_3 0x02
+#define BMP390_PWR_FORCED 0x13     // press_en | temp_en | forced 모드
+#define BMP390_MEASURE_MS 26       // 234 + (392 + 4*2020) + (163 + 8*2020)us = 25.0ms (데이터시트 3.9.2)
+
+struct Bmp390Calib {
+  double t1, t2, t3;
+  double p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11;
+};
+
+struct Bmp390Result {
+  float temperature;  // °C
+  float pressure;     // hPa
+};
+
+class Bmp390 {
+ public:
+  static bool begin(I2cBus &i2c, uint8_t address = BMP390_ADDRESS) {
+    bus = &i2c;
+    addr = address;
+    bus->setDeviceClock(addr, BMP390_I2C_KHZ);
+
+    uint8_t id = 0;
+    if (!bus->readRegs(addr, BMP390_REG_CHIP_ID, &id, 1) || id != BMP390_CHIP_ID) return false;
+
+    bus->writeReg(addr, BMP390_REG_CMD, 0xB6);  // 소프트 리셋
+    delay(2);
+
+    if (!readCalibration()) return false;
+
+    return bus->writeReg(addr, BMP390_REG_OSR, (BMP390_OSR_T << 3) | BMP390_OSR_P) &&
+           bus->writeReg(addr, BMP390_REG_CONFIG, BMP390_IIR_COEF_3 << 1);
+  }
+
+  static bool trigger() {
+    return bus->writeReg(addr, BMP390_REG_PWR_CTRL, BMP390_PWR_FORCED);
+  }
+
+  static uint16_t i2cKhz() { return bus->deviceClock(addr); }
+
+  static bool sleepOk() { return true; }
+
+  static uint32_t readyInMs() { return BMP390_MEASURE_MS; }
+
+  static bool collect() {
+    uint8_t status = 0;
+    if (!bus->readRegs(addr, BMP390_REG_STATUS, &status, 1) || (status & 0x60) != 0x60) return false;
+
+    uint8_t raw[6];
+    if (!bus->readRegs(addr, BMP390_REG_DATA, raw, sizeof(raw))) return false;
+
+    uint32_t adc_p = (uint32_t)raw[2] << 16 | (uint32_t)raw[1] << 8 | raw[0];
+    uint32_t adc_t = (uint32_t)raw[5] << 16 | (uint32_t)raw[4] << 8 | raw[3];
+
+    double t_lin = compensateTemperature(calib, adc_t);
+    result.temperature = (float)t_lin;
+    result.pressure = (float)(compensatePressure(calib, adc_p, t_lin) / 100.0);  // Pa → hPa
+    return true;
+  }
+
+  // 버스트 샘플링/기준 보정용 단일 측정 (변환 시간만큼 대기)
+  static bool readBlocking() {
+    if (!trigger()) return false;
+    delay(BMP390_MEASURE_MS);
+    return collect();
+  }
+
+  static const Bmp390Result& data() { return result; }
+
+  // 보정 계수/보상 계산은 버스와 무관 (ULP가 읽는 원시값 환산에도 씀, ulp_monitor.h)
+  static void decodeCalibration(const uint8_t c[21], Bmp390Calib &out) {
+    // NVM 정수값 → 부동소수점 계수 (데이터시트 8.4)
+    out.t1 = (uint16_t)(c[1] << 8 | c[0]) * 256.0;                        // / 2^-8
+    out.t2 = (uint16_t)(c[3] << 8 | c[2]) / 1073741824.0;                 // / 2^30
+    out.t3 = (int8_t)c[4] / 281474976710656.0;                            // / 2^48
+    out.p1 = ((int16_t)(c[6] << 8 | c[5]) - 16384) / 1048576.0;           // (- 2^14) / 2^20
+    out.p2 = ((int16_t)(c[8] << 8 | c[7]) - 16384) / 536870912.0;         // (- 2^14) / 2^29
+    out.p3 = (int8_t)c[9] / 4294967296.0;                                 // / 2^32
+    out.p4 = (int8_t)c[10] / 137438953472.0;                              // / 2^37
+    out.p5 = (uint16_t)(c[12] << 8 | c[11]) * 8.0;                        // / 2^-3
+    out.p6 = (uint16_t)(c[14] << 8 | c[13]) / 64.0;                       // / 2^6
+    out.p7 = (int8_t)c[15] / 256.0;                                       // / 2^8
+    out.p8 = (int8_t)c[16] / 32768.0;                                     // / 2^15
+    out.p9 = (int16_t)(c[18] << 8 | c[17]) / 281474976710656.0;           // / 2^48
+    out.p10 = (int8_t)c[19] / 281474976710656.0;                          // / 2^48
+    out.p11 = (int8_t)c[20] / 36893488147419103232.0;                     // / 2^65
+  }
+
+  // °C
+  static double compensateTemperature(const Bmp390Calib &calib, uint32_t adc_t) {
+    double d1 = (double)adc_t - calib.t1;
+    double d2 = d1 * calib.t2;
+    return d2 + d1 * d1 * calib.t3;
+  }
+
+  // Pa
+  static double compensatePressure(const Bmp390Calib &calib, uint32_t adc_p, double t_lin) {
+    double t2 = t_lin * t_lin;
+    double t3 = t2 * t_lin;
+    double p = (double)adc_p;
+
+    double out1 = calib.p5 + calib.p6 * t_lin + calib.p7 * t2 + calib.p8 * t3;
+    double out2 = p * (calib.p1 + calib.p2 * t_lin + calib.p3 * t2 + calib.p4 * t3);
+    double out3 = p * p * (calib.p9 + calib.p10 * t_lin) + p * p * p * calib.p11;
+    return out1 + out2 + out3;
+  }
+
+ private:
+  static I2cBus* bus;
+  static uint8_t addr;
+  static Bmp390Calib calib;
+  static Bmp390Result result;
+
+  static bool readCalibration() {
+    uint8_t c[21];
+    if (!bus->readRegs(addr, BMP390_REG_CALIB, c, sizeof(c))) return false;
+    decodeCalibration(c, calib);
+    return true;
+  }
+};
+
+I2cBus* Bmp390::bus = &sensorBus;
+uint8_t Bmp390::addr = BMP390_ADDRESS;
+Bmp390Calib Bmp390::calib;
+Bmp390Result Bmp390::result;
+
+#endif
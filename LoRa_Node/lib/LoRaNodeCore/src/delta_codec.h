@@ -0,0 +1,121 @@
+#ifndef _DELTA_CODEC_H
+#define _DELTA_CODEC_H
+
+#include <stdint.h>
+#include <string.h>
+
+// ============================================================================
+// 측정 프레임 묶음 델타 압축 (무선 묶음 업링크, 플래시 기록 공용)
+//
+// 연속 측정값은 거의 변하지 않으므로 첫 프레임만 그대로 두고 이후는 필드별 차이만 보냄:
+//   [디스크립터][샘플 수]
+//   첫 샘플:  [시각 varint][측정 데이터 그대로]
+//   이후:     [앞 샘플 후 경과 초 varint][변경 비트맵][바뀐 필드마다 zigzag 델타 varint]
+//
+//  - 필드 경계는 16비트 필드 시작 위치 비트 마스크(센서의 DELTA_U16_FIELDS)로 정하고
+//    나머지 바이트는 8비트 필드 (필드 n개면 비트맵 (n + 7) / 8 바이트, 필드 0번이 첫 바이트 bit0)
+//  - 델타는 필드 폭으로 감싼 부호 있는 차이 → zigzag → 7비트씩 varint (±63 이내면 1바이트)
+//  - 안 바뀐 필드는 비트맵 1비트만 차지 (CO2 ±10ppm, 온도 ±0.1°C 정도면 프레임당 수 바이트)
+//  - 시각의 의미는 쓰는 쪽이 정함 (무선: 첫 샘플 측정 후 경과 초, 플래시: Unix 초 또는 전원 인가 후 초)
+//  - 디스크립터가 다르면 (버전/종류/부팅 플래그) 같은 묶음에 넣지 않음
+//
+// 호스트 해석: LoRa_Decoder/include/delta_decoder.h
+// Arduino 의존성이 없어 LoRa_Decoder 벤치마크도 이 파일로 인코딩함
+// ============================================================================
+
+#define DELTA_MAX_FRAME 32                                 // 디스크립터 뺀 측정 데이터 최대 크기
+#define DELTA_MAX_BITMAP ((DELTA_MAX_FRAME + 7) / 8)
+#define DELTA_MAX_SAMPLE (5 + DELTA_MAX_BITMAP + DELTA_MAX_FRAME * 3)  // 샘플 하나 최악의 크기
+#define DELTA_HEADER_SIZE 2                                // [디스크립터][샘플 수]
+
+struct DeltaBlock {
+  uint8_t* out;
+  uint16_t capacity;
+  uint16_t len;
+  uint8_t count;
+  uint8_t frame_size;       // 디스크립터 뺀 크기
+  uint32_t u16_fields;      // 16비트 필드 시작 위치 마스크
+  uint32_t last_time;
+  uint8_t prev[DELTA_MAX_FRAME];
+};
+
+inline uint16_t zigzagEncode(int16_t v) { return (uint16_t)((uint16_t)v << 1) ^ (uint16_t)(v >> 15); }
+
+inline uint8_t writeVarint(uint8_t* out, uint32_t v) {
+  uint8_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (uint8_t)v;
+  return n;
+}
+
+// out[capacity]에 새 묶음 시작 (capacity는 DELTA_HEADER_SIZE보다 커야 함)
+inline void deltaBegin(DeltaBlock &block, uint8_t* out, uint16_t capacity, uint32_t u16_fields) {
+  block.out = out;
+  block.capacity = capacity;
+  block.len = 0;
+  block.count = 0;
+  block.frame_size = 0;
+  block.u16_fields = u16_fields;
+  block.last_time = 0;
+}
+
+// [디스크립터][측정 데이터] 프레임 하나를 묶음에 추가
+// 자리가 없거나 디스크립터/크기가 다르면 false (묶음은 그대로라서 내보낸 뒤 새로 시작하면 됨)
+inline bool deltaAdd(DeltaBlock &block, const uint8_t* frame, uint8_t size, uint32_t time) {
+  if (size < 2 || size - 1 > DELTA_MAX_FRAME) return false;
+  const uint8_t* data = frame + 1;
+  uint8_t data_size = size - 1;
+  uint8_t sample[DELTA_HEADER_SIZE + DELTA_MAX_SAMPLE];
+  uint16_t n = 0;
+
+  if (block.count == 0) {
+    sample[n++] = frame[0];
+    sample[n++] = 1;
+    n += writeVarint(sample + n, time);
+    memcpy(sample + n, data, data_size);
+    n += data_size;
+  } else {
+    if (block.count == 0xFF || frame[0] != block.out[0] || data_size != block.frame_size) return false;
+    n += writeVarint(sample, time - block.last_time);
+
+    uint8_t* bitmap = sample + n;
+    uint8_t field = 0;
+    for (uint8_t i = 0; i < data_size; i++, field++) {
+      if ((block.u16_fields >> i) & 1) i++;
+    }
+    uint8_t bitmap_size = (field + 7) / 8;
+    memset(bitmap, 0, bitmap_size);
+    n += bitmap_size;
+
+    field = 0;
+    for (uint8_t i = 0; i < data_size; i++, field++) {
+      int16_t delta;
+      if (((block.u16_fields >> i) & 1) && i + 1 < data_size) {
+        uint16_t cur = (uint16_t)(data[i] << 8 | data[i + 1]);
+        uint16_t prev = (uint16_t)(block.prev[i] << 8 | block.prev[i + 1]);
+        delta = (int16_t)(uint16_t)(cur - prev);
+        i++;
+      } else {
+        delta = (int8_t)(uint8_t)(data[i] - block.prev[i]);
+      }
+      if (delta == 0) continue;
+      bitmap[field >> 3] |= 1 << (field & 7);
+      n += writeVarint(sample + n, zigzagEncode(delta));
+    }
+  }
+
+  if (block.len + n > block.capacity) return false;
+  memcpy(block.out + block.len, sample, n);
+  block.len += n;
+  block.count++;
+  block.out[1] = block.count;
+  block.frame_size = data_size;
+  block.last_time = time;
+  memcpy(block.prev, data, data_size);
+  return true;
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef _DEVICE_REGISTRY_H
+#define _DEVICE_REGISTRY_H
+
+#include <LittleFS.h>
+#include <esp_system.h> // ESP.getEfuseMac() 사용을 위해 추가
+
+// ============================================================================
+// Chip ID → Device ID 조회 (LittleFS /device_registry.json)
+//
+// 레지스트리는 { "칩 ID": "Device ID", ... } 형태의 평평한 객체뿐이므로
+// JSON 라이브러리 없이 따옴표 문자열만 순서대로 읽어 키/값 쌍으로 비교함
+// ============================================================================
+
+#define DEVICE_ID_UNKNOWN "LoRa-XXX"
+#define REGISTRY_MAX_STRING 32        // 키/값 문자열 최대 길이
+
+// 다음 따옴표 문자열을 읽음 (파일 끝이면 false)
+bool readQuotedString(File &file, String &out) {
+  out = "";
+  int c;
+  while ((c = file.read()) >= 0 && c != '"') {}
+  if (c < 0) return false;
+
+  while ((c = file.read()) >= 0 && c != '"') {
+    if (out.length() < REGISTRY_MAX_STRING) out += (char)c;
+  }
+  return c == '"';
+}
+
+// Device ID 가져오기 함수
+String getDeviceID() {
+  // LittleFS 시작
+  if (!LittleFS.begin(true)) {
+    Serial.println("LittleFS 시작 실패. 기본 DeviceID 사용");
+    return DEVICE_ID_UNKNOWN;
+  }
+
+  File file = LittleFS.open("/device_registry.json", "r");
+  if (!file) {
+    Serial.println("device_registry.json 파일 열기 실패");
+    LittleFS.end(); // 메모리 누수 방지
+    return DEVICE_ID_UNKNOWN;
+  }
+
+  uint64_t chipid = ESP.getEfuseMac();
+  String chipidStr = String((uint32_t)(chipid >> 32), HEX) + String((uint32_t)chipid, HEX);
+  chipidStr.toUpperCase();
+
+  Serial.println("Chip ID: " + chipidStr);
+
+  String id = DEVICE_ID_UNKNOWN;
+  bool found = false;
+  String key, value;
+  while (readQuotedString(file, key) && readQuotedString(file, value)) {
+    if (key == chipidStr) {
+      id = value;
+      found = true;
+      break;
+    }
+  }
+  file.close();
+  LittleFS.end(); // 메모리 누수 방지
+
+  if (!found) {
+    Serial.println("등록되지 않은 MAC 주소");
+  }
+  return id;
+}
+
+#endif
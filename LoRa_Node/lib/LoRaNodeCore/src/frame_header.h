@@ -0,0 +1,43 @@
+#ifndef _FRAME_HEADER_H
+#define _FRAME_HEADER_H
+
+// ============================================================================
+// 업링크 FPort 할당과 프레임 디스크립터
+//
+// FPort는 프레임 종류별로 고정 (수집 서버는 포트 표 한 번으로 앞 헤더를 벗겨냄):
+//   1  측정 데이터        [디스크립터][측정 데이터]
+//   2  밀린 측정값        [경과 시간(분) u16][디스크립터][측정 데이터] (uplink_queue.h)
+//   3  진단 (예약)        [디스크립터][진단 데이터]
+//   4  밀린 측정값 묶음   [디스크립터][샘플 수][델타 압축 샘플...] (delta_codec.h)
+//   10 설정 명령 (다운링크, remote_config.h)
+//   11 설정 응답 + 측정   [트랜잭션 ID][상태][실패 명령][디스크립터][측정 데이터]
+//
+// 디스크립터 1바이트: bit7 항상 1 | bit6-4 레이아웃 버전 | bit3-1 프레임 종류 | bit0 부팅 후 첫 측정
+// 구 펌웨어 프레임은 첫 바이트가 온도 상위 바이트(0x00~0x04) 또는 0xFF라서, bit7이 켜져 있고
+// 0xFF가 아니면 디스크립터로 구분됨 (종류 7은 쓰지 않으므로 디스크립터는 0xFF가 될 수 없음)
+// 드라이버 바이트 배치를 바꾸면 FRAME_VERSION을 올리고 LoRa_Decoder 필드 표에 추가
+// ============================================================================
+
+#define DATA_FPORT 1                    // 측정 데이터 업링크 포트
+#define BACKLOG_FPORT 2                 // 밀린 측정값 업링크 포트
+#define DIAG_FPORT 3                    // 진단 프레임 업링크 포트 (예약)
+#define BATCH_FPORT 4                   // 밀린 측정값 델타 압축 묶음 업링크 포트
+#define CONFIG_FPORT 10                 // 설정 명령 다운링크 포트
+#define CONFIG_ACK_FPORT 11             // 설정 응답이 앞에 붙은 업링크 포트
+
+#define FRAME_DESCRIPTOR_SIZE 1
+#define FRAME_MARKER 0x80
+
+// 프레임 종류 (0~6)
+#define FRAME_TYPE_STAIR 0
+#define FRAME_TYPE_AM1008W 1
+#define FRAME_TYPE_AIR_STATION 2
+#define FRAME_TYPE_DIAGNOSTIC 6
+
+#define FRAME_FLAG_BOOT 0x01            // 부팅 후 첫 측정 (센서 예열, 측정 공백 해석용)
+
+uint8_t frameDescriptor(uint8_t type, uint8_t version, uint8_t flags) {
+  return FRAME_MARKER | (version & 0x07) << 4 | (type & 0x07) << 1 | (flags & 0x01);
+}
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef _HISTORY_LOG_H
+#define _HISTORY_LOG_H
+
+#include <LittleFS.h>
+#include "delta_codec.h"
+#include "network_time.h"   // 측정 시각 (재시작에도 이어지는 시스템 시계)
+
+// ============================================================================
+// 플래시 측정 기록 (LittleFS /history.bin, NODE_HISTORY)
+//
+// 측정 프레임을 RAM 묶음(HISTORY_BLOCK_SIZE)에 델타 압축으로 모았다가 가득 차면
+// [묶음 길이 u16][묶음] 하나로 파일 끝에 이어 씀 (묶음 형식은 delta_codec.h)
+//  - 측정마다 쓰는 것보다 쓰기 횟수(블록 소거)와 쓰는 양이 모두 줄어듦
+//  - 파일이 HISTORY_MAX_BYTES를 넘으면 /history.old로 돌리고 새로 시작 (최대 약 2배 사용)
+//  - 시각 = networkTimeSeconds(): 네트워크 시각 동기화 후에는 Unix 초(HISTORY_UNIX_TIME_MIN 이상),
+//    그 전에는 전원 인가 후 초 (ESP.restart()에도 이어짐). 시계 기준이 바뀌거나 동기화로
+//    시각이 뒤로 가면 새 묶음에서 시작
+//  - 부팅 후 첫 측정은 디스크립터 부팅 플래그가 달라 새 묶음에서 시작함
+//  - 전원이 끊기면 아직 쓰지 않은 RAM 묶음은 잃음
+//
+// 호스트 해석: LoRa_Decoder/include/delta_decoder.h nextHistoryBlock(), decodeDeltaBlock()
+// ============================================================================
+
+#define HISTORY_PATH "/history.bin"
+#define HISTORY_OLD_PATH "/history.old"
+#define HISTORY_BLOCK_SIZE 512            // RAM 묶음 크기 (AM1008W 기준 측정 약 60개)
+#define HISTORY_MAX_BYTES (64 * 1024UL)   // 파일 교체 크기
+#define HISTORY_UNIX_TIME_MIN 1577836800UL // 이 이상이면 Unix 초 (2020-01-01)
+
+uint8_t history_buffer[HISTORY_BLOCK_SIZE];
+DeltaBlock history_block = {};
+bool history_ready = false;
+
+// LittleFS 마운트 (getDeviceID()가 마운트를 해제하므로 그 뒤에 호출)
+bool initHistory() {
+  if (!LittleFS.begin(true)) {
+    Serial.println("✗ History: LittleFS mount failed - flash history disabled");
+    return false;
+  }
+  history_ready = true;
+
+  File file = LittleFS.open(HISTORY_PATH, "r");
+  size_t size = file ? file.size() : 0;
+  if (file) file.close();
+  Serial.println("✓ History: " + String(size) + " bytes in " HISTORY_PATH);
+  return true;
+}
+
+// RAM 묶음을 파일 끝에 쓰고 비움
+void flushHistory() {
+  if (!history_ready || history_block.count == 0) return;
+
+  File file = LittleFS.open(HISTORY_PATH, "a");
+  if (!file) {
+    Serial.println("✗ History: open failed - block dropped");
+    history_block.count = 0;
+    return;
+  }
+  uint8_t header[2] = {(uint8_t)(history_block.len >> 8), (uint8_t)(history_block.len & 0xFF)};
+  file.write(header, sizeof(header));
+  file.write(history_block.out, history_block.len);
+  size_t size = file.size();
+  file.close();
+
+  Serial.println("History block written: " + String(history_block.count) + " readings, " +
+                 String(history_block.len) + " bytes (file " + String(size) + " bytes)");
+  history_block.count = 0;
+
+  if (size >= HISTORY_MAX_BYTES) {
+    LittleFS.remove(HISTORY_OLD_PATH);
+    LittleFS.rename(HISTORY_PATH, HISTORY_OLD_PATH);
+    Serial.println("History rotated to " HISTORY_OLD_PATH);
+  }
+}
+
+// [디스크립터][측정 데이터] 프레임 하나를 기록 (묶음이 차면 먼저 파일에 씀)
+void recordHistory(const uint8_t* frame, uint8_t size, uint32_t u16_fields) {
+  if (!history_ready) return;
+
+  uint32_t time_s = networkTimeSeconds();
+  if (history_block.count > 0 && (time_s < history_block.last_time ||
+      (time_s >= HISTORY_UNIX_TIME_MIN) != (history_block.last_time >= HISTORY_UNIX_TIME_MIN))) {
+    flushHistory();
+  }
+  if (history_block.count == 0) deltaBegin(history_block, history_buffer, HISTORY_BLOCK_SIZE, u16_fields);
+  if (deltaAdd(history_block, frame, size, time_s)) return;
+
+  flushHistory();
+  deltaBegin(history_block, history_buffer, HISTORY_BLOCK_SIZE, u16_fields);
+  deltaAdd(history_block, frame, size, time_s);
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef _I2C_BUS_H
+#define _I2C_BUS_H
+
+#include <Wire.h>
+#include "power_manager.h"  // 트랜잭션 동안 PM 잠금 (NODE_PM_DFS)
+
+// ============================================================================
+// 센서 I2C 버스 관리 (장치 주소별 최대 클럭, 트랜잭션마다 클럭 전환)
+//
+// AM1008W-K-P는 ≤30kHz(기본 10kHz)만 지원하지만 Bosch 센서는 400kHz까지 됨.
+// 버스 전체를 가장 느린 장치에 맞추는 대신 주소별 최대 클럭을 등록해 두고,
+// 각 트랜잭션 직전에 그 주소의 클럭으로 바꿈 (같은 클럭이면 setClock 생략)
+//  - 25바이트 읽기: 10kHz ≈ 25ms, 400kHz ≈ 0.6ms
+//  - 등록되지 않은 주소(스캔, 주소 감지)는 probe 클럭 사용
+// 버퍼는 모두 호출자가 제공 (동적 할당 없음)
+// 트랜잭션마다 PM_LOCK_I2C를 잡아 DFS/자동 Light Sleep이 전송 도중 APB 클록을 바꾸지 않게 함
+// ============================================================================
+
+#define I2C_BUS_DEVICES_MAX 8
+#define I2C_BUS_DEFAULT_KHZ 100     // 등록되지 않은 주소의 기본 클럭 (Standard mode)
+
+class I2cBus {
+ public:
+  explicit I2cBus(TwoWire &wire) : wire(wire) {}
+
+  // 버스 시작 (Wire.begin은 클럭을 기본값으로 되돌리므로 현재 클럭도 초기화)
+  void begin(int sda, int scl) {
+    wire.begin(sda, scl);
+    bus_khz = 0;
+  }
+
+  // 장치 최대 클럭 등록/변경
+  void setDeviceClock(uint8_t address, uint16_t max_khz) {
+    for (uint8_t i = 0; i < device_count; i++) {
+      if (devices[i].address == address) {
+        devices[i].max_khz = max_khz;
+        return;
+      }
+    }
+    if (device_count < I2C_BUS_DEVICES_MAX) {
+      devices[device_count].address = address;
+      devices[device_count].max_khz = max_khz;
+      device_count++;
+    } else {
+      Serial.printf("✗ I2C bus: device table full, 0x%02X uses probe clock\n", address);
+    }
+  }
+
+  uint16_t deviceClock(uint8_t address) const {
+    for (uint8_t i = 0; i < device_count; i++) {
+      if (devices[i].address == address) return devices[i].max_khz;
+    }
+    return probe_khz;
+  }
+
+  // 스캔/주소 감지처럼 등록되지 않은 주소에 쓸 클럭 (반환: 이전 값, 복원용)
+  uint16_t setProbeClock(uint16_t khz) {
+    uint16_t previous = probe_khz;
+    probe_khz = khz;
+    return previous;
+  }
+
+  uint16_t currentClock() const { return bus_khz; }
+
+  // 주소 응답(ACK) 확인, 실패 시 Wire 오류 코드
+  uint8_t probe(uint8_t address) {
+    pmAcquire(PM_LOCK_I2C);
+    select(address);
+    wire.beginTransmission(address);
+    uint8_t result = wire.endTransmission();
+    pmRelease(PM_LOCK_I2C);
+    return result;
+  }
+
+  bool write(uint8_t address, const uint8_t* data, size_t len) {
+    pmAcquire(PM_LOCK_I2C);
+    select(address);
+    wire.beginTransmission(address);
+    wire.write(data, len);
+    bool ok = wire.endTransmission() == 0;
+    pmRelease(PM_LOCK_I2C);
+    return ok;
+  }
+
+  // 반환: 실제로 받은 바이트 수
+  size_t read(uint8_t address, uint8_t* buffer, size_t len) {
+    pmAcquire(PM_LOCK_I2C);
+    select(address);
+    wire.requestFrom(address, (uint8_t)len);
+    size_t count = 0;
+    while (wire.available() && count < len) {
+      buffer[count++] = wire.read();
+    }
+    pmRelease(PM_LOCK_I2C);
+    return count;
+  }
+
+  bool writeReg(uint8_t address, uint8_t reg, uint8_t value) {
+    uint8_t data[2] = {reg, value};
+    return write(address, data, sizeof(data));
+  }
+
+  bool readRegs(uint8_t address, uint8_t reg, uint8_t* buffer, uint8_t len) {
+    pmAcquire(PM_LOCK_I2C);   // 반복 시작(repeated start) 사이에도 유지
+    select(address);
+    wire.beginTransmission(address);
+    wire.write(reg);
+    bool ok = wire.endTransmission(false) == 0 && read(address, buffer, len) == len;
+    pmRelease(PM_LOCK_I2C);
+    return ok;
+  }
+
+ private:
+  struct Device {
+    uint8_t address;
+    uint16_t max_khz;
+  };
+
+  TwoWire &wire;
+  Device devices[I2C_BUS_DEVICES_MAX];
+  uint8_t device_count = 0;
+  uint16_t bus_khz = 0;                     // 현재 클럭 (0: 아직 설정 안 함)
+  uint16_t probe_khz = I2C_BUS_DEFAULT_KHZ;
+
+  void select(uint8_t address) {
+    uint16_t khz = deviceClock(address);
+    if (khz == bus_khz) return;
+    wire.setClock(khz * 1000UL);
+    bus_khz = khz;
+  }
+};
+
+I2cBus sensorBus(Wire);  // GPIO41/42 센서 버스
+
+#endif
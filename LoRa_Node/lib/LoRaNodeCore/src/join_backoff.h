@@ -0,0 +1,67 @@
+#ifndef _JOIN_BACKOFF_H
+#define _JOIN_BACKOFF_H
+
+// ============================================================================
+// 재조인 무작위 지수 백오프
+//
+// 조인에 실패할 때마다 대기 시간을 두 배로 늘리고(기본값: 원격 설정 rejoin_delay_s),
+// 그 절반~전체 사이에서 무작위로 골라 여러 노드가 같은 시각에 재조인하지 않게 함.
+// LoRaWAN 재전송 백오프 규정(조인 요청 airtime: 1시간 36초, 10시간까지 시간당 36초,
+// 이후 24시간당 8.7초)을 SF12 조인 요청(약 1.8초) 기준으로 지키도록 상한을 둠.
+// 상한에 닿은 뒤에는 상한을 최소 대기로 삼고 위로만 흩뜨림 (6시간 이상 간격 → 하루 4회, 7.2초)
+// 상태는 RAM에 유지되므로 Light Sleep 주기를 넘어 이어짐 (재부팅 없음)
+// ============================================================================
+
+#define JOIN_BACKOFF_MAX_S 3600UL          // 장애 후 11시간까지 대기 상한 (시간당 최대 1회)
+#define JOIN_BACKOFF_LONG_MAX_S 21600UL    // 11시간 이후 대기 상한 (6시간당 최대 1회)
+#define JOIN_BACKOFF_LONG_AFTER_MS (11UL * 3600UL * 1000UL)
+
+struct JoinBackoff {
+  uint8_t attempts;          // 연속 실패한 조인 시도 횟수 (0이면 정상)
+  uint32_t outage_start_ms;  // 첫 실패 시각
+  uint32_t next_attempt_ms;  // 다음 시도 가능 시각
+};
+
+JoinBackoff join_backoff = {0, 0, 0};
+
+// 지금 조인을 시도해도 되는지
+bool joinBackoffDue() {
+  return join_backoff.attempts == 0 || (int32_t)(millis() - join_backoff.next_attempt_ms) >= 0;
+}
+
+// 다음 시도까지 남은 시간 (초)
+uint32_t joinBackoffRemaining() {
+  if (joinBackoffDue()) return 0;
+  return (join_backoff.next_attempt_ms - millis()) / 1000;
+}
+
+// 조인 실패 기록 후 다음 시도 시각 계산, 대기 시간(초) 반환
+uint32_t joinBackoffFailed(uint16_t base_s) {
+  uint32_t now = millis();
+  if (join_backoff.attempts == 0) join_backoff.outage_start_ms = now;
+  if (join_backoff.attempts < 255) join_backoff.attempts++;
+
+  uint32_t cap = (now - join_backoff.outage_start_ms) < JOIN_BACKOFF_LONG_AFTER_MS ?
+                 JOIN_BACKOFF_MAX_S : JOIN_BACKOFF_LONG_MAX_S;
+  uint8_t shift = min(join_backoff.attempts - 1, 16);
+  uint32_t wait_s = (uint32_t)base_s << shift;
+
+  if (wait_s >= cap) {
+    // 상한 도달: 상한 ~ 1.5배 (간격이 상한보다 짧아지지 않음)
+    wait_s = cap + random(cap / 2 + 1);
+  } else {
+    // 절반은 고정, 나머지 절반은 무작위 (노드 간 동기화 방지)
+    wait_s = wait_s / 2 + random(wait_s / 2 + 1);
+  }
+  join_backoff.next_attempt_ms = now + wait_s * 1000UL;
+  return wait_s;
+}
+
+// 조인/세션 복원 성공 시 초기화
+void joinBackoffReset() {
+  join_backoff.attempts = 0;
+  join_backoff.outage_start_ms = 0;
+  join_backoff.next_attempt_ms = 0;
+}
+
+#endif
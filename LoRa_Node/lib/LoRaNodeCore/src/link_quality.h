@@ -0,0 +1,171 @@
+#ifndef _LINK_QUALITY_H
+#define _LINK_QUALITY_H
+
+// ============================================================================
+// ADR/데이터레이트 관리 및 링크 품질 측정
+//
+// - 업링크 LINK_CHECK_INTERVAL회마다 (또는 전송 실패 직후) LinkCheckReq 요청
+// - 다운링크 수신 시 RSSI/SNR, LinkCheckAns 마진/게이트웨이 수 기록
+// - LinkCheckReq가 LINK_CHECK_MAX_UNANSWERED번 이상 연속 응답 없고, 마지막 다운링크(LinkCheckAns 포함)
+//   이후 NODE_SESSION_LOSS_S가 지나면 서버가 세션을 잃은 것으로 봄
+//   (비확인형 업링크는 서버가 세션을 버려도 계속 성공하므로 이것 말고는 알 방법이 없음).
+//   게이트웨이 장애/수신 실패도 노드 쪽에서는 똑같이 보이므로, 보통의 장애보다 충분히 길게 잡아
+//   짧은 장애는 재조인 없이 넘기고 다운링크가 하나라도 오면 다시 셈
+// - 연속 실패가 쌓이면 DR을 한 단계씩 낮춤 (SF 증가 → 링크 버짓 확보)
+//   ADR 사용 시 복귀는 네트워크(LinkADRReq)에 맡기고, ADR 미사용 시 연속 성공 후 한 단계씩 복귀
+//
+// 링크 품질 바이트 (업링크 페이로드에 포함):
+//   bit7-6: 실패 단계 (0: 없음, 1: 1회, 2: 2~3회, 3: 4회 이상)
+//   bit5-3: 링크 마진 단계 (3dB 단위 0~6, 7 = 알 수 없음)
+//   bit2-0: 마지막 업링크 DR (7 = 알 수 없음)
+//
+// lorawan_config.h의 radio, node 객체를 사용하므로 lorawan_config.h 다음에 포함해야 함
+// ============================================================================
+
+#define LINK_CHECK_INTERVAL 10        // LinkCheckReq 요청 주기 (업링크 횟수)
+#define LINK_CHECK_MAX_UNANSWERED 3   // 세션 손실로 보기 위한 최소 연속 무응답 LinkCheckReq 수
+
+#ifndef NODE_SESSION_LOSS_S
+#define NODE_SESSION_LOSS_S 7200      // 다운링크 없이 이만큼 지나야 세션 손실 (초, 게이트웨이 장애보다 길게)
+#endif
+#define LINK_FALLBACK_FAILURES 2      // 이 횟수만큼 연속 실패할 때마다 DR 한 단계 낮춤
+#define LINK_RECOVERY_SUCCESSES 10    // ADR 미사용 시 이 횟수만큼 연속 성공하면 DR 한 단계 복귀
+#define LINK_MIN_DATARATE 0           // KR920 DR0 (SF12)
+#define LINK_MAX_DATARATE 5           // KR920 DR5 (SF7)
+#define LINK_DATARATE_UNSET 0xFF      // 스택 기본값 사용 / 아직 모름
+
+struct LinkStats {
+  int16_t rssi;                // 마지막 다운링크 RSSI (dBm)
+  float snr;                   // 마지막 다운링크 SNR (dB)
+  bool signal_valid;
+  uint8_t margin_db;           // 마지막 LinkCheckAns 마진 (게이트웨이 측, dB)
+  uint8_t gateway_count;       // 마지막 LinkCheckAns 수신 게이트웨이 수
+  bool margin_valid;
+  uint8_t datarate;            // 마지막 업링크 DR
+  uint8_t fallback_steps;      // 실패로 낮춘 DR 단계 수
+  uint8_t success_streak;      // DR 복귀 판단용 연속 성공 횟수
+  uint8_t uplinks_since_check; // 마지막 LinkCheckReq 이후 업링크 횟수
+  bool check_in_flight;        // 다음 업링크에 LinkCheckReq가 실림
+  uint8_t checks_unanswered;   // 연속으로 응답 없는 LinkCheckReq 수
+  uint32_t last_downlink_ms;   // 마지막 다운링크/LinkCheckAns 또는 조인 시각
+};
+
+LinkStats link_stats = {0, 0.0f, false, 0, 0, false, LINK_DATARATE_UNSET, 0, 0, LINK_CHECK_INTERVAL, false, 0, 0};
+
+// 업링크 전: 주기가 되면 LinkCheckReq를 MAC 명령 큐에 추가 (다음 업링크에 실림)
+void requestLinkCheckIfDue() {
+  if (link_stats.uplinks_since_check < LINK_CHECK_INTERVAL) return;
+
+  if (node.sendMacCommandReq(RADIOLIB_LORAWAN_MAC_LINK_CHECK) == RADIOLIB_ERR_NONE) {
+    link_stats.uplinks_since_check = 0;
+    link_stats.check_in_flight = true;
+    Serial.println("LinkCheckReq queued");
+  }
+}
+
+// 업링크 성공 후: DR, RSSI/SNR, LinkCheckAns 마진 갱신
+void updateLinkStats(bool downlinkReceived, const LoRaWANEvent_t &uplink) {
+  link_stats.datarate = uplink.datarate;
+  if (link_stats.uplinks_since_check < 255) link_stats.uplinks_since_check++;
+
+  // LinkCheckAns는 페이로드 없는 MAC 전용 다운링크로도 오므로 별도로 확인
+  uint8_t margin = 0, gwCnt = 0;
+  bool linkCheckAnswered = node.getMacLinkCheckAns(&margin, &gwCnt) == RADIOLIB_ERR_NONE;
+  if (linkCheckAnswered) {
+    link_stats.margin_db = margin;
+    link_stats.gateway_count = gwCnt;
+    link_stats.margin_valid = true;
+  } else if (link_stats.check_in_flight && link_stats.checks_unanswered < 255) {
+    link_stats.checks_unanswered++;
+    Serial.println("LinkCheckReq unanswered (" + String(link_stats.checks_unanswered) + "/" +
+                   String(LINK_CHECK_MAX_UNANSWERED) + ")");
+  }
+  link_stats.check_in_flight = false;
+
+  if (downlinkReceived || linkCheckAnswered) {
+    // 다운링크가 왔다면 서버가 세션을 알고 있음
+    link_stats.checks_unanswered = 0;
+    link_stats.last_downlink_ms = millis();
+    link_stats.rssi = (int16_t)radio.getRSSI();
+    link_stats.snr = radio.getSNR();
+    link_stats.signal_valid = true;
+  }
+
+  Serial.printf("Link - DR%d, RSSI: %d dBm, SNR: %.1f dB, Margin: %d dB (%d GW)%s\n",
+                link_stats.datarate, link_stats.rssi, link_stats.snr,
+                link_stats.margin_db, link_stats.gateway_count,
+                link_stats.margin_valid ? "" : " [no LinkCheckAns yet]");
+}
+
+// 서버가 세션을 잃었는지 (LinkCheckReq가 연속으로 응답 없고 NODE_SESSION_LOSS_S 동안 다운링크 없음)
+bool linkCheckSessionLost() {
+  return link_stats.checks_unanswered >= LINK_CHECK_MAX_UNANSWERED &&
+         millis() - link_stats.last_downlink_ms >= NODE_SESSION_LOSS_S * 1000UL;
+}
+
+// 조인/재조인/세션 복원 후: 새 세션에서 다시 셈
+void linkCheckReset() {
+  link_stats.check_in_flight = false;
+  link_stats.checks_unanswered = 0;
+  link_stats.last_downlink_ms = millis();
+}
+
+// 전송 실패 시: 다음 업링크에 링크 체크를 요청하고, 실패가 쌓이면 DR을 낮춤
+void onLinkFailure(uint8_t consecutiveFailures) {
+  link_stats.success_streak = 0;
+  link_stats.uplinks_since_check = LINK_CHECK_INTERVAL;
+
+  if (consecutiveFailures == 0 || consecutiveFailures % LINK_FALLBACK_FAILURES != 0) return;
+  if (link_stats.datarate == LINK_DATARATE_UNSET || link_stats.datarate <= LINK_MIN_DATARATE) return;
+
+  uint8_t dr = link_stats.datarate - 1;
+  if (node.setDatarate(dr) == RADIOLIB_ERR_NONE) {
+    link_stats.datarate = dr;
+    link_stats.fallback_steps++;
+    Serial.println("Datarate fallback: DR" + String(dr + 1) + " → DR" + String(dr));
+  }
+}
+
+// 전송 성공 시: 낮춘 DR 복귀 (ADR 사용 중이면 네트워크가 조정)
+void onLinkSuccess(bool adrEnabled) {
+  if (link_stats.fallback_steps == 0) return;
+
+  if (adrEnabled) {
+    link_stats.fallback_steps = 0;
+    link_stats.success_streak = 0;
+    return;
+  }
+
+  if (++link_stats.success_streak < LINK_RECOVERY_SUCCESSES) return;
+  link_stats.success_streak = 0;
+
+  uint8_t dr = link_stats.datarate + 1;
+  if (dr <= LINK_MAX_DATARATE && node.setDatarate(dr) == RADIOLIB_ERR_NONE) {
+    link_stats.datarate = dr;
+    link_stats.fallback_steps--;
+    Serial.println("Datarate recovered: DR" + String(dr - 1) + " → DR" + String(dr));
+  }
+}
+
+// 링크 품질 1바이트 요약
+// 마진은 LinkCheckAns 값을 우선 사용하고, 없으면 다운링크 SNR과 SF별 복조 한계로 추정
+uint8_t encodeLinkQuality(uint8_t consecutiveFailures) {
+  uint8_t failLevel = consecutiveFailures == 0 ? 0 :
+                      consecutiveFailures == 1 ? 1 :
+                      consecutiveFailures <= 3 ? 2 : 3;
+
+  uint8_t marginLevel = 7;
+  if (link_stats.margin_valid) {
+    marginLevel = min(link_stats.margin_db / 3, 6);
+  } else if (link_stats.signal_valid && link_stats.datarate <= LINK_MAX_DATARATE) {
+    float demodFloor = -20.0f + 2.5f * link_stats.datarate; // DR0(SF12) -20dB ~ DR5(SF7) -7.5dB
+    float margin = link_stats.snr - demodFloor;
+    marginLevel = margin <= 0 ? 0 : min((int)(margin / 3), 6);
+  }
+
+  uint8_t dr = link_stats.datarate <= LINK_MAX_DATARATE ? link_stats.datarate : 7;
+
+  return (failLevel << 6) | (marginLevel << 3) | dr;
+}
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef _LORA_SLEEP_HAL_H
+#define _LORA_SLEEP_HAL_H
+
+#include <RadioLib.h>
+#include "esp_sleep.h"
+#include "driver/gpio.h"
+#include "power_manager.h"  // SPI 트랜잭션/수신 윈도우 동안 PM 잠금
+
+// ============================================================================
+// 수신 윈도우 대기 중 MCU Light Sleep (RadioLib HAL 확장)
+//
+// LoRaWAN Class A는 업링크 후 RX1(1초), RX2(2초) 수신 윈도우까지 고정 지연이 있고,
+// RadioLib은 이 지연을 hal->delay()로 기다림. arm() 된 동안(업링크/조인)에는
+// 긴 delay를 타이머 + SX1262 DIO1 인터럽트로 깨어나는 Light Sleep으로 대체함.
+//  - 윈도우가 열리기 LIGHT_SLEEP_GUARD_MS 전에 깨어나 나머지는 일반 delay로 맞춤
+//  - 윈도우 안에서 RX 완료/타임아웃(DIO1)이 발생하면 즉시 깨어나 RadioLib 콜백을 호출
+// 라디오 타이밍은 바뀌지 않으므로 Class A 동작은 그대로 유지됨
+// ============================================================================
+
+#define LIGHT_SLEEP_MIN_MS 20      // 이보다 짧은 delay는 그대로 대기 (깨어나는 비용이 더 큼)
+#define LIGHT_SLEEP_GUARD_MS 5     // 깨어난 뒤 클럭 안정화 및 타이밍 보정 여유
+
+class LoRaSleepHal : public ArduinoHal {
+ public:
+  explicit LoRaSleepHal(uint8_t dio1Pin) : dio1Pin(dio1Pin) {}
+
+  // sendReceive()/activateOTAA() 호출 구간에서만 Light Sleep 사용
+  // (그동안 자동 Light Sleep은 막고 수신 윈도우 대기는 아래 delay()가 직접 재움)
+  void arm(bool enable) {
+    if (enable == armed) return;
+    armed = enable;
+    if (enable) pmAcquire(PM_LOCK_RX_WINDOW);
+    else pmRelease(PM_LOCK_RX_WINDOW);
+  }
+
+  // SX1262 SPI 전송 중에는 APB 클록 고정 (Arduino SPI는 DFS 클록 변경을 따라가지 않음)
+  void spiBeginTransaction() override {
+    pmAcquire(PM_LOCK_RADIO);
+    ArduinoHal::spiBeginTransaction();
+  }
+
+  void spiEndTransaction() override {
+    ArduinoHal::spiEndTransaction();
+    pmRelease(PM_LOCK_RADIO);
+  }
+
+  // DIO1 콜백을 기억해 두었다가 Light Sleep 중 발생한 인터럽트를 대신 전달
+  void attachInterrupt(uint32_t interruptNum, void (*interruptCb)(void), uint32_t mode) override {
+    if (interruptNum == digitalPinToInterrupt(dio1Pin)) dio1Callback = interruptCb;
+    ArduinoHal::attachInterrupt(interruptNum, interruptCb, mode);
+  }
+
+  void detachInterrupt(uint32_t interruptNum) override {
+    if (interruptNum == digitalPinToInterrupt(dio1Pin)) dio1Callback = nullptr;
+    ArduinoHal::detachInterrupt(interruptNum);
+  }
+
+  void delay(unsigned long ms) override {
+    if (!armed || ms < LIGHT_SLEEP_MIN_MS) {
+      ArduinoHal::delay(ms);
+      return;
+    }
+
+    unsigned long start = ::millis();
+    gpio_num_t dio1 = (gpio_num_t)dio1Pin;
+
+    // DIO1이 이미 HIGH면 레벨 웨이크업이 바로 걸리므로 타이머로만 깨어남
+    bool wakeOnDio1 = digitalRead(dio1Pin) == LOW;
+
+    esp_sleep_enable_timer_wakeup((ms - LIGHT_SLEEP_GUARD_MS) * 1000ULL);
+    if (wakeOnDio1) {
+      // 웨이크업 설정 시 인터럽트 타입이 레벨로 바뀌므로 슬립 동안 CPU 인터럽트는 막아 둠
+      gpio_intr_disable(dio1);
+      gpio_wakeup_enable(dio1, GPIO_INTR_HIGH_LEVEL);
+      esp_sleep_enable_gpio_wakeup();
+    }
+
+    esp_light_sleep_start();
+
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+    if (wakeOnDio1) {
+      gpio_wakeup_disable(dio1);
+      esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+      gpio_set_intr_type(dio1, GPIO_INTR_POSEDGE);
+      gpio_intr_enable(dio1);
+
+      // 슬립 중 RX 완료/타임아웃 발생: RadioLib에 알리고 바로 반환
+      if (digitalRead(dio1Pin) == HIGH) {
+        if (dio1Callback) dio1Callback();
+        return;
+      }
+    }
+
+    unsigned long elapsed = ::millis() - start;
+    if (elapsed < ms) ArduinoHal::delay(ms - elapsed);
+  }
+
+ private:
+  uint8_t dio1Pin;
+  bool armed = false;
+  void (*dio1Callback)(void) = nullptr;
+};
+
+#endif
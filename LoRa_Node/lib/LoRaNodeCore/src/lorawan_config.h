@@ -2,12 +2,17 @@
 #define _RADIOLIB_EX_LORAWAN_CONFIG_H
 
 #include <RadioLib.h>
+#include "lora_sleep_hal.h" // 수신 윈도우 대기 중 Light Sleep
+#ifdef NODE_HW_AES
+#include "radiolib_aes_hook.h" // RadioLib AES/CMAC → 하드웨어 AES (링커 --wrap)
+#endif
 
 // first you have to set your radio model and pin configuration
 // this is provided just as a default example
 // Heltec WiFi LoRa 32 V3 핀맵 (SX1262)
-SX1262 radio = new Module(8, 14, 12, 13);
-//                       NSS, DIO1, RST, BUSY
+LoRaSleepHal loraHal(14);  // DIO1 (GPIO14)로 수신 윈도우 중 Light Sleep에서 깨어남
+SX1262 radio = new Module(&loraHal, 8, 14, 12, 13);
+//                                 NSS, DIO1, RST, BUSY
 
 // if you have RadioBoards (https://github.com/radiolib-org/RadioBoards)
 // and are using one of the supported boards, you can do the following:
@@ -18,32 +23,25 @@ SX1262 radio = new Module(8, 14, 12, 13);
 Radio radio = new RadioModule();
 */
 
-// how often to send an uplink - consider legal & FUP constraints - see notes
-const uint32_t uplinkIntervalSeconds = 1UL * 10UL; // 10초 단위
+// EUI와 키는 장치마다 다르므로 platformio.ini의 환경별 build_flags로 지정
+// (예: -DRADIOLIB_LORAWAN_APP_KEY=0x4B,0x5C,... 쉼표 사이 공백 없이)
 // joinEUI - previous versions of LoRaWAN called this AppEUI
-// for development purposes you can use all zeros - see wiki for details
-#define RADIOLIB_LORAWAN_JOIN_EUI  0x22BC781E8AD1DE60 // TTN Application : JOIN_EUI
+#ifndef RADIOLIB_LORAWAN_JOIN_EUI
+#error "RADIOLIB_LORAWAN_JOIN_EUI is not set - add it to build_flags in platformio.ini"
+#endif
 
 #ifndef RADIOLIB_LORAWAN_DEV_EUI
-#define RADIOLIB_LORAWAN_DEV_EUI   0x0000249B6ABA2050 // TTN Device : DEV_EUI
+#error "RADIOLIB_LORAWAN_DEV_EUI is not set - add it to build_flags in platformio.ini"
 #endif
-// LoRa-001: 0x0000249B6ABA2010
-// LoRa-002: 0x000038FD66BA2010
-// LoRa-003: 0x0000500367BA2010
-// LoRa-004: 0x0000489A6ABA2010
-// LoRa-005: 0x0000F8F966BA2010
 
 #ifndef RADIOLIB_LORAWAN_APP_KEY
-#define RADIOLIB_LORAWAN_APP_KEY   0x4B, 0x5C, 0x5D, 0x83, 0x36, 0xB7, 0x8C, 0xBB, 0xB0, 0x33, 0x1F, 0xE6, 0xEF, 0x33, 0x9E, 0x08 // Device APP_KEY
+#error "RADIOLIB_LORAWAN_APP_KEY is not set - add it to build_flags in platformio.ini"
 #endif
 
 #ifndef RADIOLIB_LORAWAN_NWK_KEY
-#define RADIOLIB_LORAWAN_NWK_KEY   0x29, 0x30, 0x5B, 0x81, 0x66, 0x1D, 0x2D, 0x5C, 0xB1, 0x54, 0xE4, 0x2C, 0x80, 0x11, 0x28, 0x1C // Device NWK_KEY
+#error "RADIOLIB_LORAWAN_NWK_KEY is not set - add it to build_flags in platformio.ini"
 #endif
 
-// for the curious, the #ifndef blocks allow for automated testing &/or you can
-// put your EUI & keys in to your platformio.ini - see wiki for more tips
-
 // regional choices: EU868, US915, AU915, AS923, AS923_2, AS923_3, AS923_4, IN865, KR920, CN470
 const LoRaWANBand_t Region = KR920;
 
@@ -74,8 +72,13 @@ String stateDecode(const int16_t result) {
     return "ERR_PACKET_TOO_LONG";
   case RADIOLIB_ERR_RX_TIMEOUT:
     return "ERR_RX_TIMEOUT";
+#if RADIOLIB_VERSION_MAJOR >= 7
   case RADIOLIB_ERR_MIC_MISMATCH:
     return "ERR_MIC_MISMATCH";
+#else
+  case RADIOLIB_ERR_CRC_MISMATCH:
+    return "ERR_CRC_MISMATCH";
+#endif
   case RADIOLIB_ERR_INVALID_BANDWIDTH:
     return "ERR_INVALID_BANDWIDTH";
   case RADIOLIB_ERR_INVALID_SPREADING_FACTOR:
@@ -110,16 +113,25 @@ String stateDecode(const int16_t result) {
     return "RADIOLIB_ERR_DWELL_TIME_EXCEEDED";
   case RADIOLIB_ERR_CHECKSUM_MISMATCH:
     return "RADIOLIB_ERR_CHECKSUM_MISMATCH";
+#if RADIOLIB_VERSION_MAJOR >= 7
   case RADIOLIB_ERR_NO_JOIN_ACCEPT:
     return "RADIOLIB_ERR_NO_JOIN_ACCEPT";
+#endif
   case RADIOLIB_LORAWAN_SESSION_RESTORED:
     return "RADIOLIB_LORAWAN_SESSION_RESTORED";
   case RADIOLIB_LORAWAN_NEW_SESSION:
     return "RADIOLIB_LORAWAN_NEW_SESSION";
+#if RADIOLIB_VERSION_MAJOR >= 7
   case RADIOLIB_ERR_NONCES_DISCARDED:
     return "RADIOLIB_ERR_NONCES_DISCARDED";
   case RADIOLIB_ERR_SESSION_DISCARDED:
     return "RADIOLIB_ERR_SESSION_DISCARDED";
+#else
+  case RADIOLIB_LORAWAN_NONCES_DISCARDED:
+    return "RADIOLIB_LORAWAN_NONCES_DISCARDED";
+  case RADIOLIB_LORAWAN_SESSION_DISCARDED:
+    return "RADIOLIB_LORAWAN_SESSION_DISCARDED";
+#endif
   }
   return "See https://jgromes.github.io/RadioLib/group__status__codes.html";
 }
@@ -147,4 +159,40 @@ void arrayDump(uint8_t *buffer, uint16_t len) {
   Serial.println();
 }
 
+// ============================================================================
+// RadioLib 6.x / 7.x 호환 (AM1008W 환경은 6.6.x, 계단 센서 환경은 7.x 사용)
+
+// 노드 초기화 (6.x의 beginOTAA()는 반환값이 없음)
+int16_t beginNode() {
+#if RADIOLIB_VERSION_MAJOR >= 7
+  return node.beginOTAA(joinEUI, devEUI, nwkKey, appKey);
+#else
+  node.beginOTAA(joinEUI, devEUI, nwkKey, appKey);
+  return RADIOLIB_ERR_NONE;
+#endif
+}
+
+// 업링크 성공 여부 (7.x의 sendReceive()는 다운링크 수신 시 수신 윈도우 번호(1, 2)를 반환)
+bool uplinkSucceeded(int16_t state) {
+  return state >= RADIOLIB_ERR_NONE || state == RADIOLIB_LORAWAN_NEW_SESSION;
+}
+
+// 이번 업링크의 수신 윈도우에서 다운링크를 받았는지
+bool downlinkReceived(int16_t state, size_t size) {
+#if RADIOLIB_VERSION_MAJOR >= 7
+  return state > 0 && size > 0;
+#else
+  return size > 0;
+#endif
+}
+
+// 다운링크 FPort (6.x는 port, 7.x는 fPort 필드)
+uint8_t downlinkPort(const LoRaWANEvent_t &event) {
+#if RADIOLIB_VERSION_MAJOR >= 7
+  return event.fPort;
+#else
+  return event.port;
+#endif
+}
+
 #endif
@@ -0,0 +1,325 @@
+#ifndef _LORAWAN_CRYPTO_H
+#define _LORAWAN_CRYPTO_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef NODE_HW_AES
+#include "mbedtls/aes.h"
+#endif
+
+// ============================================================================
+// LoRaWAN 1.0.x 암호 연산 (AES-128 블록 암복호화, AES-CMAC, 프레임 MIC/페이로드 암호화)
+//
+// 블록 연산 구현은 두 가지
+//  - 소프트웨어 기준 구현: 표 하나(S-box)로 바이트 단위 계산, 어디서나 빌드됨
+//    (LoRa_TestNetwork의 시뮬레이션 노드/네트워크 서버도 이 구현을 씀)
+//  - NODE_HW_AES: mbedTLS AES (ESP32-S3에서는 ESP-IDF가 하드웨어 AES 엔진으로 연결)
+//    CMAC의 연속 블록은 CBC 한 번으로 넘겨 블록마다 엔진을 잡고 놓는 비용을 줄임
+// RadioLib 내부 연산을 이쪽으로 돌리는 훅은 radiolib_aes_hook.h
+// ============================================================================
+
+#define AES_BLOCK_SIZE 16
+#define LORAWAN_MIC_SIZE 4
+#define LORAWAN_DIR_UPLINK 0
+#define LORAWAN_DIR_DOWNLINK 1
+
+#define AES_BACKEND_SOFT 0
+#define AES_BACKEND_HW 1
+
+// 블록 연산 구현 선택 (벤치마크가 바꿔 가며 잼)
+#ifdef NODE_HW_AES
+uint8_t aes_backend = AES_BACKEND_HW;
+#else
+uint8_t aes_backend = AES_BACKEND_SOFT;
+#endif
+
+uint32_t aes_blocks = 0;   // 처리한 AES 블록 수 (부분 키 계산 포함)
+
+namespace lorawan_crypto {
+
+static const uint8_t SBOX[256] = {
+  0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+  0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+  0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+  0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+  0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+  0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+  0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+  0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+  0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+  0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+  0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+  0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+  0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+  0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+  0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+  0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+inline uint8_t xtime(uint8_t x) { return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1B : 0x00)); }
+
+inline uint8_t gmul(uint8_t a, uint8_t b) {
+  uint8_t p = 0;
+  while (b) {
+    if (b & 1) p ^= a;
+    a = xtime(a);
+    b >>= 1;
+  }
+  return p;
+}
+
+// 라운드 키 11개 (176바이트)
+inline void expandKey(const uint8_t* key, uint8_t* rk) {
+  memcpy(rk, key, AES_BLOCK_SIZE);
+  uint8_t rcon = 0x01;
+  for (int i = AES_BLOCK_SIZE; i < 176; i += 4) {
+    uint8_t t[4] = {rk[i - 4], rk[i - 3], rk[i - 2], rk[i - 1]};
+    if (i % AES_BLOCK_SIZE == 0) {
+      uint8_t first = t[0];
+      t[0] = SBOX[t[1]] ^ rcon;
+      t[1] = SBOX[t[2]];
+      t[2] = SBOX[t[3]];
+      t[3] = SBOX[first];
+      rcon = xtime(rcon);
+    }
+    for (int j = 0; j < 4; j++) rk[i + j] = rk[i - AES_BLOCK_SIZE + j] ^ t[j];
+  }
+}
+
+inline uint8_t invSbox(uint8_t v) {
+  static uint8_t inv[256];
+  static bool ready = false;
+  if (!ready) {
+    for (int i = 0; i < 256; i++) inv[SBOX[i]] = (uint8_t)i;
+    ready = true;
+  }
+  return inv[v];
+}
+
+inline void shiftSubkey(const uint8_t* in, uint8_t* out) {
+  for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+    out[i] = (uint8_t)(in[i] << 1 | (i + 1 < AES_BLOCK_SIZE ? in[i + 1] >> 7 : 0));
+  }
+  if (in[0] & 0x80) out[AES_BLOCK_SIZE - 1] ^= 0x87;
+}
+
+// ---- 소프트웨어 기준 구현 ----
+
+// 라운드 키는 마지막 키 하나만 보관 (RadioLib처럼 키를 바꿀 때만 다시 확장)
+inline const uint8_t* softRoundKeys(const uint8_t* key) {
+  static uint8_t rk[176], cached[AES_BLOCK_SIZE];
+  static bool ready = false;
+  if (!ready || memcmp(cached, key, AES_BLOCK_SIZE) != 0) {
+    expandKey(key, rk);
+    memcpy(cached, key, AES_BLOCK_SIZE);
+    ready = true;
+  }
+  return rk;
+}
+
+inline void encryptSoft(const uint8_t* key, const uint8_t* in, uint8_t* out) {
+  const uint8_t* rk = softRoundKeys(key);
+  uint8_t s[AES_BLOCK_SIZE];
+  for (int i = 0; i < AES_BLOCK_SIZE; i++) s[i] = in[i] ^ rk[i];
+
+  for (int round = 1; round <= 10; round++) {
+    uint8_t t[AES_BLOCK_SIZE];
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) t[i] = SBOX[s[(i + 4 * (i % 4)) % AES_BLOCK_SIZE]];  // SubBytes + ShiftRows
+    for (int c = 0; c < 4 && round < 10; c++) {                                                   // MixColumns
+      uint8_t* col = t + 4 * c;
+      uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+      col[0] = xtime(a0) ^ xtime(a1) ^ a1 ^ a2 ^ a3;
+      col[1] = a0 ^ xtime(a1) ^ xtime(a2) ^ a2 ^ a3;
+      col[2] = a0 ^ a1 ^ xtime(a2) ^ xtime(a3) ^ a3;
+      col[3] = xtime(a0) ^ a0 ^ a1 ^ a2 ^ xtime(a3);
+    }
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) s[i] = t[i] ^ rk[round * AES_BLOCK_SIZE + i];
+  }
+  memcpy(out, s, AES_BLOCK_SIZE);
+}
+
+inline void decryptSoft(const uint8_t* key, const uint8_t* in, uint8_t* out) {
+  const uint8_t* rk = softRoundKeys(key);
+  uint8_t s[AES_BLOCK_SIZE];
+  for (int i = 0; i < AES_BLOCK_SIZE; i++) s[i] = in[i] ^ rk[10 * AES_BLOCK_SIZE + i];
+
+  for (int round = 9; round >= 0; round--) {
+    uint8_t t[AES_BLOCK_SIZE];
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) t[(i + 4 * (i % 4)) % AES_BLOCK_SIZE] = invSbox(s[i]);  // InvShiftRows + InvSubBytes
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) t[i] ^= rk[round * AES_BLOCK_SIZE + i];
+    for (int c = 0; c < 4 && round > 0; c++) {                                                         // InvMixColumns
+      uint8_t* col = t + 4 * c;
+      uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+      col[0] = gmul(a0, 14) ^ gmul(a1, 11) ^ gmul(a2, 13) ^ gmul(a3, 9);
+      col[1] = gmul(a0, 9) ^ gmul(a1, 14) ^ gmul(a2, 11) ^ gmul(a3, 13);
+      col[2] = gmul(a0, 13) ^ gmul(a1, 9) ^ gmul(a2, 14) ^ gmul(a3, 11);
+      col[3] = gmul(a0, 11) ^ gmul(a1, 13) ^ gmul(a2, 9) ^ gmul(a3, 14);
+    }
+    memcpy(s, t, AES_BLOCK_SIZE);
+  }
+  memcpy(out, s, AES_BLOCK_SIZE);
+}
+
+#ifdef NODE_HW_AES
+// ---- 하드웨어 (mbedTLS) ----
+
+#define AES_HW_CHUNK_BLOCKS 4    // CBC 한 번에 넘기는 블록 수 (출력 버퍼 크기)
+
+// 키/방향이 바뀔 때만 다시 설정 (하드웨어 엔진은 키를 복사만 하지만 소프트웨어 mbedTLS면 확장함)
+inline mbedtls_aes_context* hwContext(const uint8_t* key, int mode) {
+  static mbedtls_aes_context ctx;
+  static uint8_t cached[AES_BLOCK_SIZE];
+  static int cached_mode = -1;
+  if (cached_mode < 0) mbedtls_aes_init(&ctx);
+  if (cached_mode != mode || memcmp(cached, key, AES_BLOCK_SIZE) != 0) {
+    if (mode == MBEDTLS_AES_ENCRYPT) mbedtls_aes_setkey_enc(&ctx, key, 128);
+    else mbedtls_aes_setkey_dec(&ctx, key, 128);
+    memcpy(cached, key, AES_BLOCK_SIZE);
+    cached_mode = mode;
+  }
+  return &ctx;
+}
+
+inline void cryptHw(const uint8_t* key, int mode, const uint8_t* in, uint8_t* out) {
+  mbedtls_aes_crypt_ecb(hwContext(key, mode), mode, in, out);
+}
+
+// CBC-MAC 연속 블록: CBC 암호화의 마지막 암호문 블록(= 갱신된 IV)이 x가 됨
+inline void cbcMacHw(const uint8_t* key, uint8_t* x, const uint8_t* data, size_t blocks) {
+  mbedtls_aes_context* ctx = hwContext(key, MBEDTLS_AES_ENCRYPT);
+  uint8_t scratch[AES_HW_CHUNK_BLOCKS * AES_BLOCK_SIZE];
+  while (blocks > 0) {
+    size_t n = blocks < AES_HW_CHUNK_BLOCKS ? blocks : AES_HW_CHUNK_BLOCKS;
+    mbedtls_aes_crypt_cbc(ctx, MBEDTLS_AES_ENCRYPT, n * AES_BLOCK_SIZE, x, data, scratch);
+    data += n * AES_BLOCK_SIZE;
+    blocks -= n;
+  }
+}
+#endif
+
+// x ← AES(x ^ block), 블록 blocks개
+inline void cbcMac(const uint8_t* key, uint8_t* x, const uint8_t* data, size_t blocks) {
+  aes_blocks += blocks;
+#ifdef NODE_HW_AES
+  if (aes_backend == AES_BACKEND_HW) {
+    cbcMacHw(key, x, data, blocks);
+    return;
+  }
+#endif
+  for (size_t b = 0; b < blocks; b++) {
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) x[i] ^= data[b * AES_BLOCK_SIZE + i];
+    encryptSoft(key, x, x);
+  }
+}
+
+}  // namespace lorawan_crypto
+
+// AES-128 ECB 블록 하나 암호화 (in과 out은 같아도 됨)
+inline void aes128Encrypt(const uint8_t* key, const uint8_t* in, uint8_t* out) {
+  aes_blocks++;
+#ifdef NODE_HW_AES
+  if (aes_backend == AES_BACKEND_HW) {
+    lorawan_crypto::cryptHw(key, MBEDTLS_AES_ENCRYPT, in, out);
+    return;
+  }
+#endif
+  lorawan_crypto::encryptSoft(key, in, out);
+}
+
+// AES-128 ECB 블록 하나 복호화 (조인 수락 암호화에 씀: 서버가 복호화 연산으로 감싸고 노드는 암호화로 풂)
+inline void aes128Decrypt(const uint8_t* key, const uint8_t* in, uint8_t* out) {
+  aes_blocks++;
+#ifdef NODE_HW_AES
+  if (aes_backend == AES_BACKEND_HW) {
+    lorawan_crypto::cryptHw(key, MBEDTLS_AES_DECRYPT, in, out);
+    return;
+  }
+#endif
+  lorawan_crypto::decryptSoft(key, in, out);
+}
+
+// AES-CMAC (RFC 4493), prefix(있으면) 뒤에 data를 이어 붙인 메시지의 16바이트 태그
+// prefix는 블록 단위 (데이터 MIC의 B0), 마지막 블록만 부분 키와 함께 따로 처리
+inline void aesCmac(const uint8_t* key, const uint8_t* prefix, size_t prefix_len, const uint8_t* data, size_t len,
+                    uint8_t* tag) {
+  // 부분 키: K1 = L << 1, K2 = K1 << 1 (L = AES(key, 0), 넘치면 0x87)
+  uint8_t l[AES_BLOCK_SIZE] = {0}, k1[AES_BLOCK_SIZE], k2[AES_BLOCK_SIZE];
+  aes128Encrypt(key, l, l);
+  lorawan_crypto::shiftSubkey(l, k1);
+  lorawan_crypto::shiftSubkey(k1, k2);
+
+  if (len == 0 && prefix_len > 0) {   // 메시지가 prefix뿐이면 prefix 마지막 블록이 마지막 블록
+    prefix_len -= AES_BLOCK_SIZE;
+    data = prefix + prefix_len;
+    len = AES_BLOCK_SIZE;
+  }
+
+  uint8_t x[AES_BLOCK_SIZE] = {0};
+  lorawan_crypto::cbcMac(key, x, prefix, prefix_len / AES_BLOCK_SIZE);
+  size_t full = len == 0 ? 0 : (len - 1) / AES_BLOCK_SIZE;
+  lorawan_crypto::cbcMac(key, x, data, full);
+
+  uint8_t last[AES_BLOCK_SIZE] = {0};
+  size_t rest = len - full * AES_BLOCK_SIZE;
+  memcpy(last, data + full * AES_BLOCK_SIZE, rest);
+  if (rest < AES_BLOCK_SIZE) last[rest] = 0x80;
+  const uint8_t* sub = rest == AES_BLOCK_SIZE ? k1 : k2;
+  for (int i = 0; i < AES_BLOCK_SIZE; i++) x[i] ^= last[i] ^ sub[i];
+  aes128Encrypt(key, x, tag);
+}
+
+// ---- LoRaWAN 1.0.x 프레임 ----
+
+// 데이터 프레임 블록 공통 부분: [tag][0 x4][dir][DevAddr LE][FCnt LE 32비트][0][last]
+inline void lorawanBlock(uint8_t* block, uint8_t tag, uint8_t dir, uint32_t dev_addr, uint32_t fcnt, uint8_t last) {
+  block[0] = tag;
+  memset(block + 1, 0, 4);
+  block[5] = dir;
+  for (int i = 0; i < 4; i++) block[6 + i] = (uint8_t)(dev_addr >> (8 * i));
+  for (int i = 0; i < 4; i++) block[10 + i] = (uint8_t)(fcnt >> (8 * i));
+  block[14] = 0;
+  block[15] = last;
+}
+
+// 데이터 프레임 MIC: CMAC(NwkSKey, B0 | MHDR..FRMPayload)의 앞 4바이트
+inline uint32_t lorawanDataMic(const uint8_t* nwk_skey, uint8_t dir, uint32_t dev_addr, uint32_t fcnt,
+                               const uint8_t* msg, size_t len) {
+  uint8_t b0[AES_BLOCK_SIZE], tag[AES_BLOCK_SIZE];
+  lorawanBlock(b0, 0x49, dir, dev_addr, fcnt, (uint8_t)len);
+  aesCmac(nwk_skey, b0, AES_BLOCK_SIZE, msg, len, tag);
+  return tag[0] | tag[1] << 8 | tag[2] << 16 | (uint32_t)tag[3] << 24;
+}
+
+// 조인 요청/수락 MIC: CMAC(NwkKey, msg)의 앞 4바이트
+inline uint32_t lorawanJoinMic(const uint8_t* nwk_key, const uint8_t* msg, size_t len) {
+  uint8_t tag[AES_BLOCK_SIZE];
+  aesCmac(nwk_key, nullptr, 0, msg, len, tag);
+  return tag[0] | tag[1] << 8 | tag[2] << 16 | (uint32_t)tag[3] << 24;
+}
+
+// FRMPayload 암호화/복호화 (같은 연산, FPort 0이면 NwkSKey, 아니면 AppSKey)
+inline void lorawanCryptPayload(const uint8_t* key, uint8_t dir, uint32_t dev_addr, uint32_t fcnt,
+                                uint8_t* payload, size_t len) {
+  for (size_t i = 0; i < len; i += AES_BLOCK_SIZE) {
+    uint8_t a[AES_BLOCK_SIZE], s[AES_BLOCK_SIZE];
+    lorawanBlock(a, 0x01, dir, dev_addr, fcnt, (uint8_t)(i / AES_BLOCK_SIZE + 1));
+    aes128Encrypt(key, a, s);
+    for (size_t j = 0; j < AES_BLOCK_SIZE && i + j < len; j++) payload[i + j] ^= s[j];
+  }
+}
+
+// 세션 키 (1.0.x): AES(NwkKey, [type][JoinNonce 3][NetID 3][DevNonce 2][0 x7])
+// type 0x01 = NwkSKey, 0x02 = AppSKey
+inline void lorawanSessionKey(const uint8_t* nwk_key, uint8_t type, uint32_t join_nonce, uint32_t net_id,
+                              uint16_t dev_nonce, uint8_t* out) {
+  uint8_t block[AES_BLOCK_SIZE] = {0};
+  block[0] = type;
+  for (int i = 0; i < 3; i++) block[1 + i] = (uint8_t)(join_nonce >> (8 * i));
+  for (int i = 0; i < 3; i++) block[4 + i] = (uint8_t)(net_id >> (8 * i));
+  block[7] = dev_nonce & 0xFF;
+  block[8] = dev_nonce >> 8;
+  aes128Encrypt(nwk_key, block, out);
+}
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef _NETWORK_TIME_H
+#define _NETWORK_TIME_H
+
+#include <sys/time.h>
+#include "esp_attr.h"
+
+// ============================================================================
+// 네트워크 시각 동기화 (LoRaWAN DeviceTimeReq/Ans)
+//
+//  - 시각 기준은 시스템 시계(gettimeofday): RTC 타이머로 유지되어 Light/Deep Sleep과
+//    ESP.restart()에도 이어짐 (millis()는 재시작마다 0, 전원이 끊기면 시스템 시계도 0부터)
+//  - 동기화 전이거나 NETWORK_TIME_RESYNC_S가 지나면 DeviceTimeReq를 다음 업링크에 실음
+//    (응답이 없으면 NETWORK_TIME_RETRY_UPLINKS 업링크마다 다시)
+//  - DeviceTimeAns는 업링크 전송이 끝난 순간의 GPS 시각이므로, 전송 시작 시각 + airtime에 맞춰
+//    settimeofday()로 시스템 시계를 Unix 시각으로 설정
+//  - 동기화 사이 RTC 슬로 클록 오차는 두 동기화 간 어긋난 양(ppm)으로 재서 networkTimeMs()에서 보정
+//  - 동기화 상태는 RTC_NOINIT 메모리에 두어 재시작 후에도 유지
+//
+// lorawan_config.h의 node 객체를 사용하므로 lorawan_config.h 다음에 포함해야 함
+// ============================================================================
+
+#define NETWORK_TIME_RESYNC_S 21600UL       // 동기화 주기 (6시간)
+#define NETWORK_TIME_RETRY_UPLINKS 10       // 응답이 없을 때 재요청 간격 (업링크 횟수)
+#define NETWORK_TIME_DRIFT_MIN_S 3600UL     // 오차 측정에 필요한 최소 동기화 간격
+#define NETWORK_TIME_MAX_DRIFT_PPM 50000    // 이보다 크면 잘못된 응답으로 보고 버림
+#define NETWORK_TIME_UNIX_MIN_MS 1577836800000ULL  // 2020-01-01 (이전이면 동기화 안 된 시계)
+#define NETWORK_TIME_MAGIC 0x4E54494DUL     // RTC 메모리 유효 표시
+
+struct NetworkTimeState {
+  uint32_t magic;
+  uint64_t synced_ms;   // 마지막 동기화 때 맞춘 Unix 시각 (ms)
+  int32_t drift_ppm;    // 시스템 시계가 느린 정도 (+면 느림)
+  uint16_t syncs;       // 동기화 횟수
+};
+
+RTC_NOINIT_ATTR NetworkTimeState network_time;
+uint8_t network_time_uplinks = NETWORK_TIME_RETRY_UPLINKS;   // 마지막 DeviceTimeReq 이후 업링크 횟수
+
+// 시스템 시계 (ms, 보정 전)
+uint64_t systemClockMs() {
+  timeval tv;
+  gettimeofday(&tv, nullptr);
+  return (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000;
+}
+
+// 시스템 시계가 네트워크 시각에 맞춰져 있는지 (전원이 끊겼으면 RTC 메모리가 남아도 무효)
+bool networkTimeValid() {
+  return network_time.magic == NETWORK_TIME_MAGIC && systemClockMs() >= NETWORK_TIME_UNIX_MIN_MS;
+}
+
+// 오차 보정한 시각 (ms): 동기화되었으면 Unix 시각, 아니면 전원 인가 후 시간
+uint64_t networkTimeMs() {
+  uint64_t now = systemClockMs();
+  if (!networkTimeValid() || now < network_time.synced_ms) return now;
+  int64_t since = (int64_t)(now - network_time.synced_ms);
+  return now + since * network_time.drift_ppm / 1000000;
+}
+
+uint32_t networkTimeSeconds() { return (uint32_t)(networkTimeMs() / 1000); }
+
+// 업링크 전: 동기화가 필요하면 DeviceTimeReq를 MAC 명령 큐에 추가 (다음 업링크에 실림)
+void requestNetworkTimeIfDue() {
+  if (network_time_uplinks < NETWORK_TIME_RETRY_UPLINKS) network_time_uplinks++;
+  if (network_time_uplinks < NETWORK_TIME_RETRY_UPLINKS) return;
+  if (networkTimeValid() && systemClockMs() - network_time.synced_ms < NETWORK_TIME_RESYNC_S * 1000ULL) return;
+
+  if (node.sendMacCommandReq(RADIOLIB_LORAWAN_MAC_DEVICE_TIME) == RADIOLIB_ERR_NONE) {
+    network_time_uplinks = 0;
+    Serial.println("DeviceTimeReq queued");
+  }
+}
+
+// 업링크 성공 후: DeviceTimeAns가 왔으면 시스템 시계를 맞추고 오차 갱신
+// tx_start_ms: sendReceive() 직전 systemClockMs()
+void updateNetworkTime(uint64_t tx_start_ms) {
+  if (network_time_uplinks != 0) return;   // 이번 업링크에 요청을 싣지 않았음
+
+  uint32_t unix_s = 0;
+  uint8_t fraction = 0;
+  if (node.getMacDeviceTimeAns(&unix_s, &fraction, true) != RADIOLIB_ERR_NONE) return;
+
+  uint64_t tx_end_ms = tx_start_ms + node.getLastToA();
+  uint64_t network_ms = (uint64_t)unix_s * 1000ULL + fraction * 1000UL / 256;
+  int64_t error_ms = (int64_t)(network_ms - tx_end_ms);
+
+  // 이전 동기화 이후 시스템 시계가 어긋난 양 → ppm (두 번째 측정부터 평균)
+  if (networkTimeValid() && tx_end_ms - network_time.synced_ms >= NETWORK_TIME_DRIFT_MIN_S * 1000ULL) {
+    int64_t ppm = error_ms * 1000000 / (int64_t)(tx_end_ms - network_time.synced_ms);
+    if (ppm >= -NETWORK_TIME_MAX_DRIFT_PPM && ppm <= NETWORK_TIME_MAX_DRIFT_PPM) {
+      network_time.drift_ppm = network_time.syncs > 1 ? (network_time.drift_ppm + (int32_t)ppm) / 2 : (int32_t)ppm;
+    }
+  }
+  if (!networkTimeValid()) {
+    network_time.drift_ppm = 0;
+    network_time.syncs = 0;
+  }
+
+  uint64_t now_ms = network_ms + (systemClockMs() - tx_end_ms);
+  timeval tv = {(time_t)(now_ms / 1000), (suseconds_t)(now_ms % 1000) * 1000};
+  settimeofday(&tv, nullptr);
+  network_time.magic = NETWORK_TIME_MAGIC;
+  network_time.synced_ms = now_ms;
+  if (network_time.syncs < 0xFFFF) network_time.syncs++;
+
+  Serial.println("✓ Network time synced: " + String(unix_s) + " (offset " + String((int32_t)error_ms) +
+                 "ms, drift " + String(network_time.drift_ppm) + "ppm)");
+}
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef _NODE_DISPLAY_H
+#define _NODE_DISPLAY_H
+
+// OLED 디스플레이 라이브러리 (Heltec 대신 직접 SSD1306 사용)
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "node_state.h"
+
+// ============================================================================
+// 내장 OLED (SSD1306, Wire1) 공통 화면
+// 헤더(제목 + 연결 상태/배터리) + Device ID 줄까지 그리고,
+// 아래 네 줄(y = 26, 36, 46, 56)은 센서 드라이버의 draw()가 채움
+// ============================================================================
+
+// VEXT 핀 정의 (Heltec V3 핀맵 기준)
+#define VEXT     36 // Heltec V3의 외부 전원 제어 핀 (VEXT_EN)
+
+// OLED 디스플레이 설정
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 64
+#define OLED_RESET 21
+#define OLED_ADDRESS 0x3C
+
+// OLED I2C 핀 설정 (GPIO17, 18)
+#define OLED_SDA_PIN 17
+#define OLED_SCL_PIN 18
+
+// 센서 행 y 좌표
+#define DISPLAY_ROW_1 26
+#define DISPLAY_ROW_2 36
+#define DISPLAY_ROW_3 46
+#define DISPLAY_ROW_4 56
+
+#ifdef NODE_BATTERY
+#include "battery_monitor.h"
+#endif
+
+// 8x8 픽셀 아이콘 정의 (이모지 스타일로 예쁘게)
+const unsigned char PROGMEM icon_temp[] = {
+  0x10, 0x28, 0x28, 0x28, 0x28, 0x6C, 0x6C, 0x38  // 🌡️ 온도계 (더 둥글고 예쁘게)
+};
+
+const unsigned char PROGMEM icon_humidity[] = {
+  0x10, 0x38, 0x7C, 0x7C, 0xFE, 0xFE, 0x7C, 0x38  // 💧 물방울 (더 통통하게)
+};
+
+const unsigned char PROGMEM icon_lora[] = {
+  0x10, 0x38, 0x54, 0x92, 0x10, 0x10, 0x10, 0x7C  // 안테나 + 받침
+};
+
+const unsigned char PROGMEM icon_paw[] = {
+  0x60, 0x90, 0x90, 0x60, 0x00, 0x66, 0x99, 0x66  // 🐾 발자국
+};
+
+// OLED 객체 생성
+Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire1, OLED_RESET);
+bool oled_available = false;
+
+// 초기화 화면 제목 (센서 드라이버의 SPLASH_TITLE)
+const char* display_splash_title = "LoRa Node";
+
+// 초기화 화면 (아이콘 포함)
+void displayInitScreen(String message) {
+  if (!oled_available) return;
+
+  display.clearDisplay();
+
+  // 제목 (기본 폰트)
+  display.setTextSize(1);
+  display.setTextColor(SSD1306_WHITE);
+  display.setCursor(0, 0);
+  display.println(display_splash_title);
+
+  // 구분선
+  display.drawLine(0, 12, 128, 12, SSD1306_WHITE);
+
+  // 상태 메시지
+  display.setCursor(0, 20);
+  display.println("Initializing...");
+  display.setCursor(0, 35);
+  display.println(message);
+
+  display.display();
+}
+
+// OLED 전원/리셋 및 초기화, 성공하면 시작 화면 표시
+void initDisplay() {
+  // Vext 핀 제어 (GPIO36) - OLED 전원 활성화
+  pinMode(VEXT, OUTPUT);
+  digitalWrite(VEXT, LOW); // LOW = 전원 ON (Heltec 보드 특성)
+  delay(100);
+  Serial.println("Vext (OLED power) enabled");
+
+  // OLED RST 핀 설정 (GPIO21)
+  pinMode(OLED_RESET, OUTPUT);
+  digitalWrite(OLED_RESET, LOW);
+  delay(10);
+  digitalWrite(OLED_RESET, HIGH);
+  delay(100);
+  Serial.println("OLED reset completed");
+
+  // OLED용 I2C 초기화 (GPIO17, 18) - Wire1 사용
+  Wire1.begin(OLED_SDA_PIN, OLED_SCL_PIN);
+  Wire1.setClock(100000); // I2C 클럭 속도 낮춤
+  delay(100);
+
+  // OLED 초기화 시도
+  Serial.println("Attempting OLED initialization...");
+  if (!display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDRESS, false, false)) {
+    oled_available = false;
+    Serial.println("OLED display initialization failed - continuing without display");
+    return;
+  }
+
+  oled_available = true;
+  Serial.println("OLED display initialized successfully!");
+
+  // 예쁜 시작 화면 테스트
+  display.clearDisplay();
+  display.setTextSize(2);
+  display.setTextColor(SSD1306_WHITE);
+  display.setCursor(0, 0);
+  display.println("HELLO!");
+  display.setTextSize(1);
+  display.setCursor(0, 20);
+  display.println("I'm " + device_id + "!");
+  display.setCursor(0, 30);
+  // 아이콘 미리보기
+  display.drawBitmap(50, 45, icon_paw, 8, 8, SSD1306_WHITE);
+  display.display();
+  delay(3000);
+  Serial.println("OLED test screen displayed");
+
+  displayInitScreen("Starting...");
+  delay(1000);
+}
+
+// 제목, 연결 상태(배터리 환경은 잔량), 구분선, Device ID 줄 그리기
+void drawStatusHeader(const char* title, LoRaWANStatus status) {
+  display.clearDisplay();
+
+  // 제목 (기본 폰트 크기)
+  display.setTextSize(1);
+  display.setTextColor(SSD1306_WHITE);
+  display.setCursor(0, 0);
+  display.println(title);
+
+#ifdef NODE_BATTERY
+  // 배터리 상태 (우상단)
+  display.setCursor(110, 0);
+  display.print(battery_percentage);
+  display.println("%");
+#else
+  // LoRa 상태
+  display.setCursor(80, 0);
+  switch(status) {
+    case LORAWAN_CONNECTED:
+      display.println("OK");
+      break;
+    case LORAWAN_CONNECTING:
+      display.println("JOINING...");
+      break;
+    case LORAWAN_SEND_FAILED:
+      display.print("FAIL(");
+      display.print(consecutive_send_failures);
+      display.println(")");
+      break;
+    case LORAWAN_REJOIN_NEEDED:
+      display.println("REJOINING...");
+      break;
+    default:
+      display.println("DISCONNECTED");
+      break;
+  }
+#endif
+
+  // 구분선
+  display.drawLine(0, 12, 128, 12, SSD1306_WHITE);
+
+  // LoRa device_id
+  display.drawBitmap(0, 16, icon_lora, 8, 8, SSD1306_WHITE);
+  display.setCursor(12, 16);
+  display.println(device_id);
+}
+
+// 화면 끄기 (전력 절약)
+void displayOff() {
+  if (!oled_available) return;
+  display.clearDisplay();
+  display.display();
+}
+
+#endif
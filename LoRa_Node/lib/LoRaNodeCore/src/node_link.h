@@ -0,0 +1,302 @@
+#ifndef _NODE_LINK_H
+#define _NODE_LINK_H
+
+#include <Wire.h>
+#include "esp_sleep.h" // ESP32 슬립 관련 헤더 파일
+#include "esp_timer.h" // 64비트 부팅 후 시간 (Light Sleep 중에도 흐름)
+#include "node_state.h"
+#include "node_display.h"
+#include "join_backoff.h"   // 재조인 무작위 지수 백오프
+#include "uplink_queue.h"   // 연결 끊김 동안의 측정값 보관
+#include "radio_recovery.h" // 전송 실패 원인 분류 및 복구
+#include "radio_health.h"   // 업링크 전 SX1262 사전 점검
+#include "uplink_schedule.h" // DevEUI 슬롯 + 무작위 지연 (LoRa_Simulator와 공용)
+#include "network_time.h"    // DeviceTimeReq 네트워크 시각
+
+// ============================================================================
+// LoRaWAN 연결 관리 (조인, 설정 반영, 라디오 복구, 재연결)
+// 센서 종류와 무관하며 sensor_node.h의 setup()/loop()에서 사용
+// ============================================================================
+
+// Light Sleep 함수
+void enterLightSleep(uint32_t sleepTimeMs) {
+  Serial.println("Entering light sleep for " + String(sleepTimeMs / 1000.0, 1) + " seconds...");
+  Serial.flush();
+
+  // 화면 끄기 (전력 절약)
+  displayOff();
+
+  // Light sleep 설정 (RAM 메모리 유지 - JOIN 상태 보존)
+  esp_sleep_enable_timer_wakeup(sleepTimeMs * 1000ULL);
+  esp_light_sleep_start();
+
+  Serial.println("Woke up from light sleep - LoRaWAN session preserved!");
+}
+
+// 다음 업링크 슬롯까지 Light Sleep (uplink_schedule.h)
+void sleepUntilNextSlot(uint16_t interval_s) {
+  uint64_t local_ms = esp_timer_get_time() / 1000;
+  if (networkTimeValid()) setUplinkNetworkTime(networkTimeMs(), local_ms);
+  uint64_t now_ms = uplinkSlotClockMs(local_ms);
+  uint32_t jitter_ms = random(uplinkSlotJitterMaxMs(interval_s) + 1);
+  Serial.println("Uplink slot: offset " + String(uplinkSlotOffsetMs(devEUI, interval_s)) + "ms, jitter " +
+                 String(jitter_ms) + "ms (" + (uplink_clock_synced ? "network time" : "local clock") + ")");
+  enterLightSleep(uplinkSlotSleepMs(now_ms, devEUI, interval_s, jitter_ms));
+}
+
+// 현재 설정 출력
+void printNodeConfig() {
+  Serial.println("Node config - Interval: " + String(node_config.uplink_interval_s) + "s, Max failures: " +
+                 String(node_config.max_send_failures) + ", Rejoin delay: " + String(node_config.rejoin_delay_s) +
+                 "s, TX power: " + String(node_config.tx_power_dbm) + "dBm, ADR: " +
+                 String(node_config.adr_enabled ? "on" : "off") + ", DR: " +
+                 (node_config.datarate == LINK_DATARATE_UNSET ? String("default") : String(node_config.datarate)));
+#ifdef CONFIG_ALTITUDE
+  Serial.println("Altitude config - QNH: " + String(node_config.qnh_hpa, 1) + "hPa, Mode: " +
+                 String(node_config.alt_mode == ALT_MODE_RELATIVE ? "relative" : "absolute") +
+                 ", Baseline: " + String(node_config.alt_baseline_hpa, 2) + "hPa, Burst: " + String(node_config.alt_burst_samples));
+#endif
+#ifdef CONFIG_I2C_CLOCK
+  Serial.println("Sensor I2C clock: " + String(node_config.i2c_clock_khz) + "kHz");
+#endif
+#ifdef CONFIG_PM_MODE
+  Serial.println("PM measurement: " + String(node_config.pm_duty_cycle ? "duty-cycled" : "continuous"));
+#endif
+#ifdef CONFIG_SAMPLE_STATS
+  Serial.println("Sampling window: " + String(node_config.stats_window_s) + "s every " +
+                 String(node_config.stats_period_s) + "s");
+#endif
+}
+
+// 설정값을 라디오/센서 버스에 반영 (조인/세션 복원 후, 설정 변경 후 호출)
+void applyNodeConfig() {
+  int16_t state = node.setTxPower(node_config.tx_power_dbm);
+  if (state != RADIOLIB_ERR_NONE) {
+    Serial.println("TX power setting failed: " + stateDecode(state));
+  }
+
+  // ADR 정책 및 시작 DR (ADR 사용 시 이후 DR은 네트워크가 조정)
+  node.setADR(node_config.adr_enabled);
+  if (node_config.datarate != LINK_DATARATE_UNSET) {
+    state = node.setDatarate(node_config.datarate);
+    if (state == RADIOLIB_ERR_NONE) {
+      link_stats.datarate = node_config.datarate;
+      link_stats.fallback_steps = 0;
+    } else {
+      Serial.println("Datarate setting failed: " + stateDecode(state));
+    }
+  }
+  // 센서 I2C 클럭(CONFIG_I2C_CLOCK)은 다음 측정 주기에 해당 칩 트랜잭션부터 적용됨 (i2c_bus.h)
+  // PM 모드(CONFIG_PM_MODE)도 다음 측정 주기의 trigger()부터 적용됨 (am1008w.h)
+}
+
+// 라디오 하드웨어 재초기화 (LoRaWAN 세션은 node 객체에 그대로 유지됨)
+// radio.begin()이 RST 핀 리셋과 BUSY 대기를 포함하므로 보통은 이것만으로 충분하고,
+// 실패할 때만 SPI 버스까지 다시 시작함
+bool resetRadioHardware() {
+  Serial.println("=== RADIO HARDWARE RESET ===");
+
+  int16_t radioState = radio.begin();
+  if (radioState != RADIOLIB_ERR_NONE) {
+    Serial.println("Radio reset failed (" + stateDecode(radioState) + "), restarting SPI...");
+    SPI.end();
+    SPI.begin(9, 11, 10, 8); // SCK, MISO, MOSI, SS
+    radioState = radio.begin();
+  }
+
+  if (radioState != RADIOLIB_ERR_NONE) {
+    Serial.println("✗ Radio hardware reset failed: " + stateDecode(radioState));
+    return false;
+  }
+
+  radio_health.phy_configured = false; // 다음 업링크에서 LoRaWAN 스택이 다시 설정
+  Serial.println("✓ Radio hardware reset successful (session kept)");
+  return true;
+}
+
+// 업링크 전 라디오 사전 점검, 실패하면 이번 주기에 한 번만 리셋 후 재점검
+// 그래도 실패하면 TX를 건너뛰고 라디오 복구를 smartReconnect() 백오프에 맡김
+bool preflightRadio() {
+  int16_t probeState = probeRadio();
+  if (probeState == RADIOLIB_ERR_NONE) return true;
+
+  radio_health.probe_failures++;
+  Serial.println("✗ Radio pre-flight check failed: " + stateDecode(probeState) + ". Resetting radio...");
+  if (resetRadioHardware() && probeRadio() == RADIOLIB_ERR_NONE) {
+    radio_health.heals++;
+    Serial.println("✓ Radio recovered before transmit (heals: " + String(radio_health.heals) + ")");
+    return true;
+  }
+
+  radio_recovery.radio_fault = true;
+  lorawan_status = LORAWAN_SEND_FAILED;
+  return false;
+}
+
+// LoRaWAN 강제 재조인 함수
+bool forceRejoin() {
+  Serial.println("=== FORCE REJOIN ATTEMPT ===");
+
+  // 라디오 재초기화
+  Serial.println("Reinitializing radio...");
+  int16_t radioState = radio.begin();
+  if (radioState != RADIOLIB_ERR_NONE) {
+    Serial.println("Radio reinitialization failed: " + stateDecode(radioState));
+    return false;
+  }
+  radio_health.phy_configured = false;
+
+  // 노드 재초기화
+  Serial.println("Reinitializing LoRaWAN node...");
+  int16_t nodeState = beginNode();
+  if (nodeState != RADIOLIB_ERR_NONE) {
+    Serial.println("Node reinitialization failed: " + stateDecode(nodeState));
+    return false;
+  }
+
+  // 새로운 조인 시도
+  Serial.println("Attempting fresh OTAA join...");
+  loraHal.arm(true);  // 조인 수신 윈도우 대기 중 Light Sleep
+  int16_t joinState = node.activateOTAA();
+  loraHal.arm(false);
+
+  if (joinState == RADIOLIB_LORAWAN_NEW_SESSION) {
+    Serial.println("✓ Successfully rejoined LoRaWAN network!");
+    consecutive_send_failures = 0;
+    radio_health.phy_configured = true;
+    last_successful_send = millis();
+    linkCheckReset();
+    applyNodeConfig();
+    return true;
+  } else {
+    Serial.println("✗ Rejoin failed: " + stateDecode(joinState));
+    return false;
+  }
+}
+
+// 스마트 재연결 함수 (비차단: 호출마다 최대 한 번만 조인을 시도하고,
+// 실패하면 무작위 지수 백오프가 끝날 때까지 다음 주기들은 바로 반환)
+bool smartReconnect() {
+  // 백오프 대기 중이면 바로 반환 (센서 측정과 측정값 보관은 계속됨)
+  if (!joinBackoffDue()) {
+    Serial.println("Rejoin backoff active, next attempt in " + String(joinBackoffRemaining()) + "s");
+    return false;
+  }
+
+  lorawan_status = LORAWAN_CONNECTING;
+
+  // 라디오 칩 오류: 칩만 리셋하고, 세션이 살아 있으면 재조인 없이 바로 복귀
+  if (radio_recovery.radio_fault) {
+    Serial.println("Radio fault detected. Resetting radio (session kept)...");
+    if (!resetRadioHardware()) {
+      joinBackoffFailed(node_config.rejoin_delay_s);
+      lorawan_status = LORAWAN_DISCONNECTED;
+      return false;
+    }
+    radio_recovery.radio_fault = false;
+
+    if (node.isActivated() && !radio_recovery.session_lost) {
+      consecutive_send_failures = 0;
+      lorawan_status = LORAWAN_CONNECTED;
+      joinBackoffReset();
+      recoveryClear();
+      return true;
+    }
+  }
+
+  // 먼저 세션 복원 시도 (반환값은 RadioLib 버전마다 다르므로 활성화 상태로 직접 확인)
+  if (!node.isActivated()) {
+    Serial.println("Session not active. Attempting session restore...");
+    beginNode();
+
+    if (node.isActivated()) {
+      Serial.println("✓ Session restored successfully!");
+      consecutive_send_failures = 0;
+      last_successful_send = millis();
+      linkCheckReset();
+      lorawan_status = LORAWAN_CONNECTED;
+      applyNodeConfig();
+      joinBackoffReset();
+      recoveryClear();
+      return true;
+    }
+  }
+
+  // 세션 복원 실패 시 강제 재조인 (이번 주기에는 한 번만 시도)
+  Serial.println("Session restore failed. Attempting force rejoin...");
+  lorawan_status = LORAWAN_REJOIN_NEEDED;
+  Serial.println("Rejoin attempt " + String(join_backoff.attempts + 1));
+
+  if (forceRejoin()) {
+    joinBackoffReset();
+    recoveryClear();
+    lorawan_status = LORAWAN_CONNECTED;
+    return true;
+  }
+
+  // 재부팅하지 않고 백오프 후 다음 주기에 재시도 (RAM 상태와 보관된 측정값 유지)
+  uint32_t wait_s = joinBackoffFailed(node_config.rejoin_delay_s);
+  Serial.println("✗ Rejoin failed - next attempt in " + String(wait_s) + "s, readings are queued meanwhile");
+  lorawan_status = LORAWAN_DISCONNECTED;
+  return false;
+}
+
+// 라디오 초기화 및 첫 OTAA 조인 (조인 실패 시 멈추지 않고 loop()의 smartReconnect()가 백오프로 재시도)
+void initLoRaWAN() {
+  displayInitScreen("Init LoRa radio...");
+
+  // SPI 핀 명시적 재설정 (딥슬립 후 복구)
+  SPI.begin(9, 11, 10, 8); // SCK, MISO, MOSI, SS for Heltec V3
+  delay(100);
+
+  // LoRa 모듈 전원 확인 및 리셋
+  pinMode(12, OUTPUT); // RST 핀
+  digitalWrite(12, LOW);
+  delay(100);
+  digitalWrite(12, HIGH);
+  delay(100);
+  Serial.println("LoRa module reset completed");
+
+  // LoRaWAN 초기화 (lorawan_config.h에서 정의된 radio 객체 사용)
+  Serial.println("Initialise the radio");
+  int16_t state = radio.begin();
+  debug(state != RADIOLIB_ERR_NONE, F("Initialise radio failed"), state, true);
+
+  displayInitScreen("Init LoRaWAN node...");
+
+  // LoRaWAN 노드 설정
+  state = beginNode();
+  debug(state != RADIOLIB_ERR_NONE, F("Initialise node failed"), state, true);
+
+  // LoRaWAN 네트워크 조인 (첫 부팅 시에만)
+  Serial.println("Join ('login') the LoRaWAN Network");
+  displayInitScreen("Joining LoRaWAN...");
+
+  loraHal.arm(true);  // 조인 수신 윈도우 대기 중 Light Sleep
+  state = node.activateOTAA();
+  loraHal.arm(false);
+  if (state != RADIOLIB_LORAWAN_NEW_SESSION) {
+    // 게이트웨이가 아직 없거나 조인 응답을 놓쳐도 측정은 계속하고 측정값은 보관
+    uint32_t wait_s = joinBackoffFailed(node_config.rejoin_delay_s);
+    Serial.println("✗ Join failed: " + stateDecode(state) + " - next attempt in " + String(wait_s) + "s");
+    lorawan_status = LORAWAN_DISCONNECTED;
+    displayInitScreen("Join failed, retrying");
+    delay(2000);
+    return;
+  }
+
+  Serial.println("Ready! LoRaWAN Network Joined Successfully!");
+
+  // 초기 연결 성공
+  lorawan_status = LORAWAN_CONNECTED;
+  consecutive_send_failures = 0;
+  last_successful_send = millis();
+  radio_health.phy_configured = true;
+  linkCheckReset();
+  applyNodeConfig();
+
+  displayInitScreen("LoRaWAN Joined!");
+  delay(2000);
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef _NODE_STATE_H
+#define _NODE_STATE_H
+
+// ============================================================================
+// 노드 공통 상태 및 원격 설정 기본값
+//
+// 센서 종류에 따라 달라지는 기본값은 platformio.ini의 환경별 build_flags로 지정
+//  - NODE_UPLINK_INTERVAL_S : 업링크 주기 (초)
+//  - NODE_I2C_CLOCK_KHZ     : 센서 I2C 클럭 (kHz)
+//  - NODE_PM_DUTY_CYCLE     : AM1008W PM 측정 듀티 사이클 (0: 연속, 1: 측정 때만)
+//  - NODE_STATS_WINDOW_S    : 구간 통계 수집 시간 (초, 0: 단일 샘플)
+// ============================================================================
+
+#include "lorawan_config.h" // LoRaWAN 설정 및 라디오/노드 객체
+#include "remote_config.h"  // 다운링크 원격 설정 (NVS 저장)
+#include "link_quality.h"   // ADR/데이터레이트 관리 및 링크 품질 측정
+
+#ifndef NODE_UPLINK_INTERVAL_S
+#define NODE_UPLINK_INTERVAL_S 60     // how often to send an uplink - consider legal & FUP constraints
+#endif
+
+#ifndef NODE_I2C_CLOCK_KHZ
+#define NODE_I2C_CLOCK_KHZ 100
+#endif
+
+#ifndef NODE_PM_DUTY_CYCLE
+#define NODE_PM_DUTY_CYCLE 0
+#endif
+
+#ifndef NODE_STATS_WINDOW_S
+#define NODE_STATS_WINDOW_S 0
+#endif
+#define STATS_PERIOD_SECONDS 1        // 구간 통계 샘플 간격 (AM1008W 갱신 주기)
+
+// 재연결 관련 설정
+#define MAX_SEND_FAILURES 5         // 연속 전송 실패 허용 횟수
+#define REJOIN_DELAY_MS 30000       // 재조인 백오프 기본 간격 (30초, 실패마다 2배)
+
+// 다운링크/원격 설정 관련 (명령 형식은 remote_config.h 참고)
+#define DOWNLINK_BUFFER_SIZE 242      // KR920 최대 애플리케이션 페이로드 (DR5)
+#define DEFAULT_TX_POWER_DBM 14       // KR920 최대 EIRP
+#define DISPLAY_HOLD_SECONDS 5        // 전송 후 화면 표시 시간
+
+// 연결 상태 enum
+enum LoRaWANStatus {
+  LORAWAN_DISCONNECTED,
+  LORAWAN_CONNECTING,
+  LORAWAN_CONNECTED,
+  LORAWAN_SEND_FAILED,
+  LORAWAN_REJOIN_NEEDED
+};
+
+String device_id = "";  // Device ID (device_registry.json)
+
+// 상태 변수들
+uint8_t consecutive_send_failures = 0;
+uint32_t last_successful_send = 0;
+LoRaWANStatus lorawan_status = LORAWAN_DISCONNECTED;
+
+// 원격 설정 (펌웨어 기본값 + NVS에 저장된 현재값)
+const NodeConfig default_node_config = {
+  CONFIG_LAYOUT_VERSION,
+  NODE_UPLINK_INTERVAL_S,
+  MAX_SEND_FAILURES,
+  REJOIN_DELAY_MS / 1000,
+  DEFAULT_TX_POWER_DBM,
+  NODE_I2C_CLOCK_KHZ,     // 원격 변경은 CONFIG_I2C_CLOCK 환경에서만 지원
+  DISPLAY_HOLD_SECONDS,
+  STANDARD_QNH_HPA,       // 고도 설정은 CONFIG_ALTITUDE 환경에서만 사용
+  ALT_MODE_ABSOLUTE,
+  NAN,
+  0,
+  1,                      // ADR 사용
+  LINK_DATARATE_UNSET,    // 시작 DR은 스택 기본값
+  NODE_PM_DUTY_CYCLE,     // 원격 변경은 CONFIG_PM_MODE 환경에서만 지원
+  NODE_STATS_WINDOW_S,    // 구간 통계는 CONFIG_SAMPLE_STATS 환경에서만 원격 변경
+  STATS_PERIOD_SECONDS
+};
+NodeConfig node_config = default_node_config;
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef _POWER_MANAGER_H
+#define _POWER_MANAGER_H
+
+#include <Arduino.h>
+#ifdef NODE_PM_DFS
+#include "esp_pm.h"
+#include "esp_idf_version.h"
+#endif
+
+// ============================================================================
+// CPU 전원 관리: ESP-IDF 동적 주파수 조절(DFS) + 자동 Light Sleep (NODE_PM_DFS)
+//
+// esp_pm_configure()로 일이 없을 때는 NODE_PM_MIN_MHZ까지 내리고, FreeRTOS tickless idle이면
+// delay()/대기 중에도 자동으로 Light Sleep. 주변 장치는 동작 중에만 PM 잠금(APB 최대)을 잡음
+//  - PM_LOCK_RADIO : SX1262 SPI 트랜잭션 (lora_sleep_hal.h, Arduino SPI는 IDF 드라이버가 아니라 잠금이 없음)
+//  - PM_LOCK_I2C   : 센서 I2C 트랜잭션 (i2c_bus.h)
+//  - PM_LOCK_UART  : AM1008W-K-P 명령 ~ 응답 수신 (Light Sleep 중 UART 수신 바이트 유실)
+//  - PM_LOCK_RX_WINDOW : 업링크/조인 ~ RX2 (자동 Light Sleep만 막음, 깨어나는 지연이 수신 윈도우 시각을 밀지 않게)
+// 업링크 주기 끝/수신 윈도우의 명시적 Light Sleep은 그대로 (타이머 + DIO1로 더 길게 잠)
+//
+// Arduino 기본 sdkconfig는 tickless idle이 꺼져 있어 자동 Light Sleep은 ESP_ERR_NOT_SUPPORTED →
+// DFS만 켜고, PM 자체가 꺼진 빌드면 NODE_CPU_MHZ 고정 클록으로 되돌아감
+// ============================================================================
+
+#ifndef NODE_PM_MAX_MHZ
+#define NODE_PM_MAX_MHZ 160
+#endif
+
+#ifndef NODE_PM_MIN_MHZ
+#define NODE_PM_MIN_MHZ 10
+#endif
+
+#define PM_LOCK_RADIO 0
+#define PM_LOCK_I2C 1
+#define PM_LOCK_UART 2
+#define PM_LOCK_RX_WINDOW 3
+#define PM_LOCK_COUNT 4
+
+#define PM_MODE_FIXED 0         // 고정 클록 (NODE_CPU_MHZ 또는 기본 240MHz)
+#define PM_MODE_DFS 1           // 동적 주파수만
+#define PM_MODE_AUTO_SLEEP 2    // 동적 주파수 + 자동 Light Sleep
+
+uint8_t pm_mode = PM_MODE_FIXED;
+
+#ifdef NODE_PM_DFS
+esp_pm_lock_handle_t pm_locks[PM_LOCK_COUNT] = {nullptr, nullptr, nullptr, nullptr};
+
+// 잠금은 횟수를 세므로 중첩 호출 가능 (readRegs → read 등)
+inline void pmAcquire(uint8_t lock) {
+  if (pm_locks[lock]) esp_pm_lock_acquire(pm_locks[lock]);
+}
+
+inline void pmRelease(uint8_t lock) {
+  if (pm_locks[lock]) esp_pm_lock_release(pm_locks[lock]);
+}
+
+static bool configurePowerManagement() {
+#if ESP_IDF_VERSION_MAJOR >= 5
+  esp_pm_config_t config = {};
+#else
+  esp_pm_config_esp32s3_t config = {};
+#endif
+  config.max_freq_mhz = NODE_PM_MAX_MHZ;
+  config.min_freq_mhz = NODE_PM_MIN_MHZ;
+  config.light_sleep_enable = true;
+
+  esp_err_t err = esp_pm_configure(&config);
+  if (err == ESP_ERR_NOT_SUPPORTED) {   // tickless idle 없음 → DFS만
+    config.light_sleep_enable = false;
+    err = esp_pm_configure(&config);
+  }
+  if (err != ESP_OK) {
+    Serial.printf("✗ esp_pm_configure failed (%d) - CONFIG_PM_ENABLE off?\n", err);
+    return false;
+  }
+
+  static const char* names[PM_LOCK_COUNT] = {"radio", "i2c", "uart", "rx_window"};
+  for (uint8_t i = 0; i < PM_LOCK_COUNT; i++) {
+    esp_pm_lock_type_t type = i == PM_LOCK_RX_WINDOW ? ESP_PM_NO_LIGHT_SLEEP : ESP_PM_APB_FREQ_MAX;
+    if (esp_pm_lock_create(type, 0, names[i], &pm_locks[i]) != ESP_OK) {
+      Serial.printf("✗ PM lock '%s' not created\n", names[i]);
+      pm_locks[i] = nullptr;
+    }
+  }
+
+  pm_mode = config.light_sleep_enable ? PM_MODE_AUTO_SLEEP : PM_MODE_DFS;
+  Serial.printf("✓ Power management: %d-%dMHz DFS, automatic light sleep %s\n", NODE_PM_MIN_MHZ, NODE_PM_MAX_MHZ,
+                pm_mode == PM_MODE_AUTO_SLEEP ? "on" : "off (no tickless idle)");
+  return true;
+}
+#else
+inline void pmAcquire(uint8_t) {}
+inline void pmRelease(uint8_t) {}
+#endif
+
+// 부팅 시 한 번 (DFS가 안 되면 NODE_CPU_MHZ 고정 클록)
+void initPowerManagement() {
+#ifdef NODE_PM_DFS
+  if (configurePowerManagement()) return;
+#endif
+#ifdef NODE_CPU_MHZ
+  // CPU 클록 최적화 (240MHz → NODE_CPU_MHZ, 센서 버스/라디오 타이밍에 영향 없음)
+  Serial.printf("CPU 클록 변경 전: %dMHz\n", getCpuFrequencyMhz());
+  setCpuFrequencyMhz(NODE_CPU_MHZ);
+  Serial.printf("CPU 클록 변경 후: %dMHz\n", getCpuFrequencyMhz());
+#endif
+}
+
+#endif
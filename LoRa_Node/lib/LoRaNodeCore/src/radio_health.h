@@ -0,0 +1,54 @@
+#ifndef _RADIO_HEALTH_H
+#define _RADIO_HEALTH_H
+
+// ============================================================================
+// 업링크 전 SX1262 사전 점검
+//
+// TX를 시도하기 전에 SPI로 LoRa 동기 워드 레지스터(0x0740)를 읽어 칩 상태를 확인함
+// (4바이트 SPI 전송 1회, 수십 µs)
+//  - RadioLib이 응답 상태 바이트를 검사하므로 명령 타임아웃/오류, 응답 없음(0x00/0xFF)을 잡아냄
+//  - 읽은 뒤 BUSY가 바로 LOW로 돌아오는지 확인 (멈춘 칩은 BUSY가 HIGH로 남음)
+//  - LoRaWAN 설정 후에는 공개 동기 워드(0x3444)여야 함. 리셋 기본값(0x1424)이 보이면
+//    브라운아웃/ESD로 칩이 스스로 리셋되어 TCXO 등 설정을 잃은 것으로 봄
+//
+// lorawan_config.h의 radio 객체를 사용하므로 lorawan_config.h 다음에 포함해야 함
+// ============================================================================
+
+#define RADIO_BUSY_PIN 13                 // SX1262 BUSY
+#define RADIO_PROBE_BUSY_TIMEOUT_US 200   // 레지스터 읽기 후 BUSY 해제 대기 한도
+#define SX1262_REG_LORA_SYNC_WORD 0x0740  // LoRa 동기 워드 MSB (LSB는 0x0741)
+#define SYNC_WORD_LORAWAN 0x3444          // LoRaWAN 공개 네트워크 동기 워드
+#define SYNC_WORD_RESET 0x1424            // 칩 리셋 / radio.begin() 직후 값
+
+struct RadioHealth {
+  bool phy_configured;      // LoRaWAN 스택이 라디오를 설정했는지 (조인/업링크 성공 후 true)
+  uint16_t probe_failures;  // 사전 점검 실패 횟수
+  uint16_t heals;           // 리셋으로 복구된 횟수
+};
+
+RadioHealth radio_health = {false, 0, 0};
+
+// 라디오 상태 점검 (정상이면 RADIOLIB_ERR_NONE)
+int16_t probeRadio() {
+  uint8_t sync[2] = {0, 0};
+  int16_t state = radio.getMod()->SPIreadRegisterBurst(SX1262_REG_LORA_SYNC_WORD, 2, sync);
+  if (state != RADIOLIB_ERR_NONE) return state;
+
+  uint32_t start = micros();
+  while (digitalRead(RADIO_BUSY_PIN) == HIGH) {
+    if (micros() - start > RADIO_PROBE_BUSY_TIMEOUT_US) {
+      Serial.println("Radio probe: BUSY stuck high");
+      return RADIOLIB_ERR_SPI_CMD_TIMEOUT;
+    }
+  }
+
+  uint16_t syncWord = ((uint16_t)sync[0] << 8) | sync[1];
+  if (syncWord == SYNC_WORD_LORAWAN) return RADIOLIB_ERR_NONE;
+  if (syncWord == SYNC_WORD_RESET && !radio_health.phy_configured) return RADIOLIB_ERR_NONE;
+
+  Serial.printf("Radio probe: unexpected sync word 0x%04X\n", syncWord);
+  if (syncWord == 0x0000 || syncWord == 0xFFFF) return RADIOLIB_ERR_CHIP_NOT_FOUND;
+  return RADIOLIB_ERR_SPI_CMD_FAILED;
+}
+
+#endif
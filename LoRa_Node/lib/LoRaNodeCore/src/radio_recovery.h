@@ -0,0 +1,108 @@
+#ifndef _RADIO_RECOVERY_H
+#define _RADIO_RECOVERY_H
+
+// ============================================================================
+// 전송 실패 원인 분류 및 복구 방법 선택
+//
+// RadioLib 상태 코드로 실패 원인을 나누어 필요한 만큼만 복구함
+//  - 라디오 (칩 응답 없음, SPI 오류, TX 타임아웃): SX1262만 리셋, LoRaWAN 세션은 유지
+//  - 세션 (미조인, 조인 거부, 세션 폐기): 세션 복원 → 안 되면 재조인 (join_backoff.h)
+//  - 일시적 (듀티 사이클, 수신 오류 등): 리셋/재조인 없이 다음 전송만 미룸
+//    (1, 2, 4, 8주기 순으로 늘림). 일시적 실패가 max_send_failures회 이어지면
+//    그때 세션을 잃은 것으로 봄
+//  - 업링크는 성공하지만 LinkCheckReq가 계속 응답 없음 (서버 세션 DB 초기화 등, link_quality.h):
+//    세션 손실로 보고 재조인
+// ============================================================================
+
+#define TRANSIENT_BACKOFF_MAX_CYCLES 8   // 일시적 실패 후 최대 대기 주기 수
+
+enum LinkFailureClass {
+  LINK_FAILURE_TRANSIENT,
+  LINK_FAILURE_RADIO,
+  LINK_FAILURE_SESSION
+};
+
+struct RadioRecovery {
+  bool radio_fault;      // 라디오 리셋 필요
+  bool session_lost;     // 세션 복원/재조인 필요
+  uint8_t skip_cycles;   // 일시적 실패 후 전송을 건너뛸 남은 주기 수
+};
+
+RadioRecovery radio_recovery = {false, false, 0};
+
+// RadioLib 상태 코드 → 실패 원인
+LinkFailureClass classifyLinkFailure(int16_t state) {
+  switch (state) {
+    case RADIOLIB_ERR_CHIP_NOT_FOUND:
+    case RADIOLIB_ERR_SPI_WRITE_FAILED:
+    case RADIOLIB_ERR_SPI_CMD_TIMEOUT:
+    case RADIOLIB_ERR_SPI_CMD_INVALID:
+    case RADIOLIB_ERR_SPI_CMD_FAILED:
+    case RADIOLIB_ERR_TX_TIMEOUT:          // TX 완료 인터럽트가 오지 않음 = 칩 멈춤
+      return LINK_FAILURE_RADIO;
+
+    case RADIOLIB_ERR_NETWORK_NOT_JOINED:
+    case RADIOLIB_ERR_JOIN_NONCE_INVALID:
+#ifdef RADIOLIB_ERR_NO_JOIN_ACCEPT
+    case RADIOLIB_ERR_NO_JOIN_ACCEPT:
+#endif
+#ifdef RADIOLIB_LORAWAN_SESSION_DISCARDED
+    case RADIOLIB_LORAWAN_SESSION_DISCARDED:
+#endif
+      return LINK_FAILURE_SESSION;
+
+    default:
+      return LINK_FAILURE_TRANSIENT;
+  }
+}
+
+const char* linkFailureName(LinkFailureClass cls) {
+  switch (cls) {
+    case LINK_FAILURE_RADIO: return "radio";
+    case LINK_FAILURE_SESSION: return "session";
+    default: return "transient";
+  }
+}
+
+// 전송 실패 기록 후 필요한 복구 표시, 실패 원인 반환
+LinkFailureClass recordLinkFailure(int16_t state, uint8_t consecutiveFailures, uint8_t maxFailures) {
+  LinkFailureClass cls = classifyLinkFailure(state);
+
+  if (cls == LINK_FAILURE_RADIO) {
+    radio_recovery.radio_fault = true;
+  } else if (cls == LINK_FAILURE_SESSION) {
+    radio_recovery.session_lost = true;
+  } else if (consecutiveFailures >= maxFailures) {
+    radio_recovery.session_lost = true;
+  } else {
+    uint8_t shift = min(consecutiveFailures - 1, 3);
+    radio_recovery.skip_cycles = min(1 << shift, TRANSIENT_BACKOFF_MAX_CYCLES) - 1;
+  }
+
+  String action = radio_recovery.radio_fault ? "radio reset" :
+                  radio_recovery.session_lost ? "session recovery" :
+                  "skip " + String(radio_recovery.skip_cycles) + " cycle(s)";
+  Serial.println("Failure class: " + String(linkFailureName(cls)) + " → " + action);
+  return cls;
+}
+
+// 라디오 리셋 또는 세션 복구가 필요한지
+bool recoveryPending() {
+  return radio_recovery.radio_fault || radio_recovery.session_lost;
+}
+
+// 이번 주기 전송을 건너뛰어야 하는지 (호출마다 남은 주기 수 감소)
+bool transientBackoffActive() {
+  if (radio_recovery.skip_cycles == 0) return false;
+  radio_recovery.skip_cycles--;
+  return true;
+}
+
+// 전송 성공 또는 재조인 성공 시 초기화
+void recoveryClear() {
+  radio_recovery.radio_fault = false;
+  radio_recovery.session_lost = false;
+  radio_recovery.skip_cycles = 0;
+}
+
+#endif
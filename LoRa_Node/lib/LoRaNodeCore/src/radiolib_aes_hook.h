@@ -0,0 +1,72 @@
+#ifndef _RADIOLIB_AES_HOOK_H
+#define _RADIOLIB_AES_HOOK_H
+
+#include <RadioLib.h>
+#include "lorawan_crypto.h"
+
+// ============================================================================
+// RadioLib LoRaWAN 암호 연산을 lorawan_crypto.h(하드웨어 AES)로 돌리는 훅 (NODE_HW_AES)
+//
+// RadioLib은 MIC/페이로드/조인 수락 암호 연산을 모두 전역 RadioLibAES128Instance의
+// 비가상 함수로 소프트웨어 계산하고 교체 지점이 없음. 그래서 링커 --wrap으로
+// LoRaWAN.cpp → Cryptography.cpp 호출만 가로챔 (platformio.ini의 -Wl,--wrap=... 다섯 줄)
+//  - 심볼은 RadioLib 7.x 시그니처 기준 (size_t = unsigned int, 6.x는 확인 안 됨)
+//  - --wrap이 빠지면 __real_ 심볼이 없어 링크가 실패하고, 시그니처가 달라 일부 심볼이 안 맞으면
+//    그 연산만 RadioLib 소프트웨어 구현으로 남음 (aes_hook_calls로 확인, 벤치마크가 표시)
+//  - init()은 원래 함수도 불러 RadioLib 내부 상태(키 확장)를 그대로 맞춰 둠
+// ============================================================================
+
+#if RADIOLIB_VERSION_MAJOR < 7
+#error "NODE_HW_AES wraps RadioLib 7.x symbols - remove it from build_flags for RadioLib 6.x environments"
+#endif
+
+uint32_t aes_hook_calls = 0;          // 훅으로 처리한 RadioLib 호출 수
+static const uint8_t* aes_hook_key = nullptr;
+
+extern "C" {
+
+void __real__ZN14RadioLibAES1284initEPh(void* self, uint8_t* key);
+
+// void RadioLibAES128::init(uint8_t* key)
+void __wrap__ZN14RadioLibAES1284initEPh(void* self, uint8_t* key) {
+  aes_hook_key = key;
+  __real__ZN14RadioLibAES1284initEPh(self, key);
+}
+
+// size_t RadioLibAES128::encryptECB(const uint8_t* in, size_t len, uint8_t* out)
+size_t __wrap__ZN14RadioLibAES12810encryptECBEPKhjPh(void*, const uint8_t* in, size_t len, uint8_t* out) {
+  aes_hook_calls++;
+  size_t blocks = len / AES_BLOCK_SIZE;
+  for (size_t b = 0; b < blocks; b++) {
+    aes128Encrypt(aes_hook_key, in + b * AES_BLOCK_SIZE, out + b * AES_BLOCK_SIZE);
+  }
+  return blocks * AES_BLOCK_SIZE;
+}
+
+// size_t RadioLibAES128::decryptECB(const uint8_t* in, size_t len, uint8_t* out)
+size_t __wrap__ZN14RadioLibAES12810decryptECBEPKhjPh(void*, const uint8_t* in, size_t len, uint8_t* out) {
+  aes_hook_calls++;
+  size_t blocks = len / AES_BLOCK_SIZE;
+  for (size_t b = 0; b < blocks; b++) {
+    aes128Decrypt(aes_hook_key, in + b * AES_BLOCK_SIZE, out + b * AES_BLOCK_SIZE);
+  }
+  return blocks * AES_BLOCK_SIZE;
+}
+
+// void RadioLibAES128::generateCMAC(const uint8_t* in, size_t len, uint8_t* cmac)
+void __wrap__ZN14RadioLibAES12812generateCMACEPKhjPh(void*, const uint8_t* in, size_t len, uint8_t* cmac) {
+  aes_hook_calls++;
+  aesCmac(aes_hook_key, nullptr, 0, in, len, cmac);
+}
+
+// bool RadioLibAES128::verifyCMAC(const uint8_t* in, size_t len, const uint8_t* cmac)
+bool __wrap__ZN14RadioLibAES12810verifyCMACEPKhjS1_(void*, const uint8_t* in, size_t len, const uint8_t* cmac) {
+  aes_hook_calls++;
+  uint8_t tag[AES_BLOCK_SIZE];
+  aesCmac(aes_hook_key, nullptr, 0, in, len, tag);
+  return memcmp(tag, cmac, AES_BLOCK_SIZE) == 0;
+}
+
+}  // extern "C"
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef _REMOTE_CONFIG_H
+#define _REMOTE_CONFIG_H
+
+#include <Preferences.h>
+#include "frame_header.h"  // FPort 할당
+
+// ============================================================================
+// 다운링크 기반 원격 설정 (NVS 저장)
+//
+// 다운링크 형식 (FPort 10): [트랜잭션 ID][명령][인자] [명령][인자] ...
+//  - 한 다운링크에 여러 명령을 담을 수 있음 (값은 모두 빅엔디안)
+//  - 모든 명령이 검증된 뒤에만 한꺼번에 적용/저장됨 (하나라도 실패하면 아무것도 바뀌지 않음)
+//  - 결과는 다음 업링크를 FPort 11로 보내 [트랜잭션 ID][상태][실패 명령] + 측정 데이터로 응답
+//
+// 고도 명령은 CONFIG_ALTITUDE, I2C 클럭 명령은 CONFIG_I2C_CLOCK, PM 모드 명령은 CONFIG_PM_MODE,
+// 구간 통계 명령은 CONFIG_SAMPLE_STATS가 정의된 펌웨어에서만 지원
+// ============================================================================
+
+#define CONFIG_ACK_SIZE 3               // 응답 헤더 크기
+#define CONFIG_LAYOUT_VERSION 4         // NVS 저장 구조 버전 (NodeConfig 변경 시 증가)
+
+// 명령 코드 [인자]
+#define CMD_SET_QNH 0x01                // [u16] QNH x10 (예: 1013.2hPa → 10132)
+#define CMD_SET_ALT_MODE 0x02           // [u8] 0: 절대고도(QNH), 1: 상대고도
+#define CMD_CALIBRATE_BASELINE 0x03     // [] 다음 측정 기압을 상대고도 기준값으로 저장
+#define CMD_SET_BURST 0x04              // [u8] 이벤트 시 버스트 샘플 수, 0 = 사용 안 함
+#define CMD_SET_UPLINK_INTERVAL 0x10    // [u16] 업링크 주기 (초)
+#define CMD_SET_MAX_SEND_FAILURES 0x11  // [u8] 재연결 전 허용 연속 전송 실패 횟수
+#define CMD_SET_REJOIN_DELAY 0x12       // [u16] 재조인 백오프 기본 간격 (초)
+#define CMD_SET_TX_POWER 0x13           // [i8] LoRaWAN TX 출력 (dBm)
+#define CMD_SET_I2C_CLOCK 0x14          // [u16] 센서 I2C 클럭 (kHz)
+#define CMD_SET_DISPLAY_HOLD 0x15       // [u8] 전송 후 화면 표시 시간 (초)
+#define CMD_SET_ADR 0x16                // [u8] 0: ADR 끄기, 1: ADR 켜기
+#define CMD_SET_DATARATE 0x17           // [u8] 업링크 DR (KR920 0~5), 0xFF = 스택 기본값
+#define CMD_SET_PM_MODE 0x18            // [u8] AM1008W PM 측정 0: 연속, 1: 측정 주기마다만 켜기 (듀티 사이클)
+#define CMD_SET_SAMPLING 0x19           // [u8 window][u8 period] 구간 통계 수집 시간/샘플 간격 (초), window 0 = 단일 샘플
+#define CMD_RESET_DEFAULTS 0x1F         // [] 모든 설정을 펌웨어 기본값으로
+
+// 응답 상태 코드
+#define CONFIG_ACK_OK 0x00
+#define CONFIG_ACK_UNKNOWN_CMD 0x01
+#define CONFIG_ACK_BAD_LENGTH 0x02
+#define CONFIG_ACK_OUT_OF_RANGE 0x03
+#define CONFIG_ACK_NOT_SUPPORTED 0x04
+#define CONFIG_ACK_STORAGE_FAILED 0x05
+
+// 설정 적용 후 펌웨어가 수행해야 할 동작 (비트마스크)
+#define CONFIG_ACTION_CALIBRATE 0x01    // 상대고도 기준 기압 재보정
+
+#define STANDARD_QNH_HPA 1013.25f       // 표준 해면기압 (QNH 미설정 시 기본값)
+#define CONFIG_MAX_TX_POWER_DBM 14      // KR920 최대 EIRP (이보다 높은 TX 출력 명령은 거부)
+#define AM1008_PM_WARMUP_MS 8000        // AM1008W PM 예열 시간 (사양서 ≤8초, 입자 측정을 켠 시각 기준)
+                                        // 듀티 사이클이면 매 주기 통계 수집 전에 기다리므로 주기 검증에도 씀
+
+// 고도 모드
+enum AltitudeMode {
+  ALT_MODE_ABSOLUTE = 0,  // QNH 기준 절대고도
+  ALT_MODE_RELATIVE = 1   // 보정된 기준 기압 대비 상대고도
+};
+
+// 원격으로 바꿀 수 있는 설정 (NVS에 한 덩어리로 저장)
+struct NodeConfig {
+  uint8_t layout_version;     // CONFIG_LAYOUT_VERSION
+  uint16_t uplink_interval_s; // 업링크 주기
+  uint8_t max_send_failures;  // 재연결 전 허용 연속 실패
+  uint16_t rejoin_delay_s;    // 재조인 백오프 기본 간격
+  int8_t tx_power_dbm;        // LoRaWAN TX 출력
+  uint16_t i2c_clock_khz;     // 센서 I2C 클럭
+  uint8_t display_hold_s;     // 전송 후 화면 표시 시간
+  float qnh_hpa;              // 현지 해면기압 (QNH)
+  uint8_t alt_mode;           // 고도 모드 (0: 절대, 1: 상대)
+  float alt_baseline_hpa;     // 상대고도 기준 기압 (NAN이면 미보정)
+  uint8_t alt_burst_samples;  // 이벤트 시 버스트 샘플 수
+  uint8_t adr_enabled;        // ADR 사용 여부
+  uint8_t datarate;           // 시작/고정 업링크 DR (0xFF = 스택 기본값)
+  uint8_t pm_duty_cycle;      // AM1008W PM 듀티 사이클 사용 여부
+  uint8_t stats_window_s;     // 구간 통계 수집 시간 (0 = 단일 샘플)
+  uint8_t stats_period_s;     // 구간 통계 샘플 간격
+};
+
+// 다음 업링크에 실어 보낼 설정 응답
+struct ConfigAck {
+  bool pending;
+  uint8_t transaction_id;
+  uint8_t status;
+  uint8_t failed_cmd;
+};
+
+ConfigAck config_ack = {false, 0, CONFIG_ACK_OK, 0};
+
+// NVS에서 설정 불러오기 (없거나 구조 버전이 다르면 기본값)
+void loadNodeConfig(NodeConfig &cfg, const NodeConfig &defaults) {
+  Preferences prefs;
+  cfg = defaults;
+
+  if (!prefs.begin("nodecfg", true)) {
+    Serial.println("Node config: NVS not initialized, using defaults");
+    return;
+  }
+  if (prefs.getBytesLength("cfg") == sizeof(NodeConfig)) {
+    NodeConfig stored;
+    prefs.getBytes("cfg", &stored, sizeof(NodeConfig));
+    if (stored.layout_version == CONFIG_LAYOUT_VERSION) {
+      cfg = stored;
+      // 이전 펌웨어가 저장한 지역 한도 초과 출력은 한도로 낮춤
+      if (cfg.tx_power_dbm > CONFIG_MAX_TX_POWER_DBM) cfg.tx_power_dbm = CONFIG_MAX_TX_POWER_DBM;
+      Serial.println("Node config loaded from NVS");
+    }
+  }
+  prefs.end();
+}
+
+// NVS에 설정 저장 (단일 blob이므로 원자적으로 기록됨)
+bool saveNodeConfig(const NodeConfig &cfg) {
+  Preferences prefs;
+  if (!prefs.begin("nodecfg", false)) return false;
+  size_t written = prefs.putBytes("cfg", &cfg, sizeof(NodeConfig));
+  prefs.end();
+  return written == sizeof(NodeConfig);
+}
+
+// 설정값 전체 범위 검증 (항목 간 관계 포함)
+bool validateNodeConfig(const NodeConfig &cfg) {
+  if (cfg.uplink_interval_s < 10 || cfg.uplink_interval_s <= cfg.display_hold_s) return false;
+  if (cfg.max_send_failures < 1 || cfg.max_send_failures > 50) return false;
+  if (cfg.rejoin_delay_s < 1 || cfg.rejoin_delay_s > 3600) return false;
+  if (cfg.tx_power_dbm < 0 || cfg.tx_power_dbm > CONFIG_MAX_TX_POWER_DBM) return false;
+  if (cfg.i2c_clock_khz < 1 || cfg.i2c_clock_khz > 400) return false;
+  if (cfg.display_hold_s > 60) return false;
+  if (cfg.qnh_hpa < 800 || cfg.qnh_hpa > 1200) return false;
+  if (cfg.alt_mode > 1 || cfg.alt_burst_samples > 64) return false;
+  if (cfg.adr_enabled > 1 || (cfg.datarate > 5 && cfg.datarate != 0xFF)) return false;
+  if (cfg.pm_duty_cycle > 1) return false;
+  if (cfg.stats_period_s < 1 || cfg.stats_period_s > 60) return false;
+  // 한 주기 안에 (PM 예열) + 구간 통계 수집 + 화면 표시가 끝나야 함
+  uint32_t busy_s = cfg.stats_window_s + cfg.display_hold_s;
+  if (cfg.pm_duty_cycle) busy_s += (AM1008_PM_WARMUP_MS + 999) / 1000;
+  if (busy_s >= cfg.uplink_interval_s) return false;
+  return true;
+}
+
+// 명령별 인자 길이 (-1: 알 수 없는 명령)
+int configCommandLength(uint8_t cmd) {
+  switch (cmd) {
+    case CMD_SET_QNH:               return 2;
+    case CMD_SET_ALT_MODE:          return 1;
+    case CMD_CALIBRATE_BASELINE:    return 0;
+    case CMD_SET_BURST:             return 1;
+    case CMD_SET_UPLINK_INTERVAL:   return 2;
+    case CMD_SET_MAX_SEND_FAILURES: return 1;
+    case CMD_SET_REJOIN_DELAY:      return 2;
+    case CMD_SET_TX_POWER:          return 1;
+    case CMD_SET_I2C_CLOCK:         return 2;
+    case CMD_SET_DISPLAY_HOLD:      return 1;
+    case CMD_SET_ADR:               return 1;
+    case CMD_SET_DATARATE:          return 1;
+    case CMD_SET_PM_MODE:           return 1;
+    case CMD_SET_SAMPLING:          return 2;
+    case CMD_RESET_DEFAULTS:        return 0;
+  }
+  return -1;
+}
+
+// 명령 하나를 임시 설정(staged)에 반영 (성공 시 CONFIG_ACK_OK)
+uint8_t applyConfigCommand(uint8_t cmd, const uint8_t *args, NodeConfig &staged,
+                           const NodeConfig &defaults, uint8_t &actions) {
+#ifndef CONFIG_ALTITUDE
+  (void)actions;  // 동작 플래그를 세우는 명령(기준 기압 보정)은 고도 빌드에만 있음
+#endif
+  uint16_t u16 = 0;
+  if (configCommandLength(cmd) == 2) u16 = (args[0] << 8) | args[1];
+
+  switch (cmd) {
+#ifdef CONFIG_ALTITUDE
+    case CMD_SET_QNH:
+      staged.qnh_hpa = u16 / 10.0f;
+      return CONFIG_ACK_OK;
+    case CMD_SET_ALT_MODE:
+      staged.alt_mode = args[0];
+      return CONFIG_ACK_OK;
+    case CMD_CALIBRATE_BASELINE:
+      actions |= CONFIG_ACTION_CALIBRATE;
+      return CONFIG_ACK_OK;
+    case CMD_SET_BURST:
+      staged.alt_burst_samples = args[0];
+      return CONFIG_ACK_OK;
+#endif
+#ifdef CONFIG_I2C_CLOCK
+    case CMD_SET_I2C_CLOCK:
+      staged.i2c_clock_khz = u16;
+      return CONFIG_ACK_OK;
+#endif
+#ifdef CONFIG_PM_MODE
+    case CMD_SET_PM_MODE:
+      staged.pm_duty_cycle = args[0];
+      return CONFIG_ACK_OK;
+#endif
+#ifdef CONFIG_SAMPLE_STATS
+    case CMD_SET_SAMPLING:
+      staged.stats_window_s = args[0];
+      staged.stats_period_s = args[1];
+      return CONFIG_ACK_OK;
+#endif
+    case CMD_SET_UPLINK_INTERVAL:
+      staged.uplink_interval_s = u16;
+      return CONFIG_ACK_OK;
+    case CMD_SET_MAX_SEND_FAILURES:
+      staged.max_send_failures = args[0];
+      return CONFIG_ACK_OK;
+    case CMD_SET_REJOIN_DELAY:
+      staged.rejoin_delay_s = u16;
+      return CONFIG_ACK_OK;
+    case CMD_SET_TX_POWER:
+      staged.tx_power_dbm = (int8_t)args[0];
+      return CONFIG_ACK_OK;
+    case CMD_SET_DISPLAY_HOLD:
+      staged.display_hold_s = args[0];
+      return CONFIG_ACK_OK;
+    case CMD_SET_ADR:
+      staged.adr_enabled = args[0];
+      return CONFIG_ACK_OK;
+    case CMD_SET_DATARATE:
+      staged.datarate = args[0];
+      return CONFIG_ACK_OK;
+    case CMD_RESET_DEFAULTS:
+      staged = defaults;
+      return CONFIG_ACK_OK;
+  }
+  return CONFIG_ACK_NOT_SUPPORTED;
+}
+
+// 설정 다운링크 처리: 전체 검증 후 원자적으로 적용 및 저장, 응답 예약
+// 반환값: 펌웨어가 추가로 수행해야 할 동작 (CONFIG_ACTION_*)
+uint8_t handleConfigDownlink(const uint8_t *payload, size_t len, NodeConfig &cfg, const NodeConfig &defaults) {
+  uint8_t actions = 0;
+  NodeConfig staged = cfg;
+
+  config_ack.pending = true;
+  config_ack.transaction_id = len > 0 ? payload[0] : 0;
+  config_ack.status = CONFIG_ACK_OK;
+  config_ack.failed_cmd = 0;
+
+  if (len < 2) {
+    config_ack.status = CONFIG_ACK_BAD_LENGTH;
+    return 0;
+  }
+
+  size_t pos = 1;
+  while (pos < len) {
+    uint8_t cmd = payload[pos++];
+    int argLen = configCommandLength(cmd);
+    uint8_t status = CONFIG_ACK_OK;
+
+    if (argLen < 0) {
+      status = CONFIG_ACK_UNKNOWN_CMD;
+    } else if (pos + argLen > len) {
+      status = CONFIG_ACK_BAD_LENGTH;
+    } else {
+      status = applyConfigCommand(cmd, &payload[pos], staged, defaults, actions);
+      pos += argLen;
+    }
+
+    if (status != CONFIG_ACK_OK) {
+      config_ack.status = status;
+      config_ack.failed_cmd = cmd;
+      Serial.printf("Config command 0x%02X rejected (status %d) - nothing applied\n", cmd, status);
+      return 0;
+    }
+  }
+
+  if (!validateNodeConfig(staged)) {
+    config_ack.status = CONFIG_ACK_OUT_OF_RANGE;
+    Serial.println("Config rejected: values out of range - nothing applied");
+    return 0;
+  }
+
+  if (!saveNodeConfig(staged)) {
+    config_ack.status = CONFIG_ACK_STORAGE_FAILED;
+    Serial.println("Config rejected: NVS write failed - nothing applied");
+    return 0;
+  }
+
+  cfg = staged;
+  Serial.printf("✓ Config transaction %d applied and saved\n", config_ack.transaction_id);
+  return actions;
+}
+
+// 업링크 페이로드 앞에 설정 응답을 붙임 (응답 대기 중일 때만)
+// 반환값: 사용할 FPort, offset에는 측정 데이터가 시작될 위치가 기록됨
+uint8_t prependConfigAck(uint8_t *buffer, size_t &offset) {
+  offset = 0;
+  if (!config_ack.pending) return DATA_FPORT;
+
+  buffer[0] = config_ack.transaction_id;
+  buffer[1] = config_ack.status;
+  buffer[2] = config_ack.failed_cmd;
+  offset = CONFIG_ACK_SIZE;
+  return CONFIG_ACK_FPORT;
+}
+
+#endif
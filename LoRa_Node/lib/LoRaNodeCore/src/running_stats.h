@@ -0,0 +1,44 @@
+#ifndef _RUNNING_STATS_H
+#define _RUNNING_STATS_H
+
+#include <math.h>
+
+// ============================================================================
+// 구간 통계 (Welford 온라인 알고리즘, 고정 메모리)
+// 샘플을 저장하지 않고 개수/평균/편차 제곱합/최소/최대만 갱신하므로
+// 샘플 수와 관계없이 항목당 20바이트이며, 평균과 분산을 한 번에 구해도
+// 큰 값끼리 빼는 일이 없어 float로도 정밀도가 유지됨
+// ============================================================================
+
+struct RunningStats {
+  uint16_t count;
+  float mean;
+  float m2;     // 평균 편차 제곱합 (분산 = m2 / (count - 1))
+  float min;
+  float max;
+
+  void reset() {
+    count = 0;
+    mean = 0;
+    m2 = 0;
+    min = NAN;
+    max = NAN;
+  }
+
+  void add(float x) {
+    if (count == UINT16_MAX) return;
+    count++;
+    float delta = x - mean;
+    mean += delta / count;
+    m2 += delta * (x - mean);
+    if (count == 1 || x < min) min = x;
+    if (count == 1 || x > max) max = x;
+  }
+
+  // 표본 분산 (샘플이 2개 미만이면 0)
+  float variance() const { return count > 1 ? m2 / (count - 1) : 0; }
+
+  float stddev() const { return sqrtf(variance()); }
+};
+
+#endif
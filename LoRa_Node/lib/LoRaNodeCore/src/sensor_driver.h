@@ -0,0 +1,123 @@
+#ifndef _SENSOR_DRIVER_H
+#define _SENSOR_DRIVER_H
+
+#include "esp_sleep.h"
+#include "i2c_bus.h"
+
+// ============================================================================
+// 센서 칩 드라이버 공통 인터페이스 + 변환 스케줄러
+//
+// 칩 드라이버는 static 멤버만 가진 클래스로 만들고 상태(보정값, 결과)도 정적 할당
+// 측정은 세 단계로 나눔:
+//   bool trigger();        // 변환 시작만 하고 바로 반환 (비차단)
+//   uint32_t readyInMs();  // trigger 후 결과가 준비되기까지 걸리는 시간 (오버샘플링 설정 기준)
+//   bool collect();        // 결과 레지스터/프레임을 읽어 드라이버 내부 결과에 저장
+//   uint16_t i2cKhz();     // 이 칩 트랜잭션의 센서 버스 클럭 (i2c_bus.h 등록값), 버스를 쓰지 않으면 0
+//   bool sleepOk();        // 변환 중 MCU Light Sleep 허용 여부 (UART 응답 수신 중이면 false)
+//
+// pollSensors()는 모든 칩의 변환을 먼저 시작하고 가장 빨리 끝나는 시점까지 잠든 뒤
+// 준비된 것부터 수집함. 한 주기 소요 시간은 칩 변환 시간의 합이 아니라 최댓값이 됨
+// 클럭 전환은 sensorBus가 트랜잭션마다 하고, 여기서는 같은 클럭 칩끼리 이어서
+// 처리하도록 순서만 정하므로 클럭 전환은 주기당 클럭 종류 수만큼만 일어남
+// ============================================================================
+
+#define SENSOR_TASKS_MAX 8          // 한 노드가 동시에 스케줄하는 칩 수 상한 (비트마스크 8비트)
+#define SENSOR_SLEEP_MIN_MS 20      // 이보다 짧은 대기는 delay (Light Sleep 진입/복귀 비용이 더 큼)
+
+struct SensorTask {
+  const char* name;
+  bool (*trigger)();
+  uint32_t (*readyInMs)();
+  bool (*collect)();
+  uint16_t (*i2cKhz)();
+  bool (*sleepOk)();
+};
+
+// 칩 드라이버 클래스로 스케줄 항목 구성
+#define SENSOR_TASK(name, Driver) \
+  { name, Driver::trigger, Driver::readyInMs, Driver::collect, Driver::i2cKhz, Driver::sleepOk }
+
+// mask 중 다음에 처리할 작업: 현재 클럭으로 바로 처리할 수 있는 것 먼저, 없으면 순서대로
+uint8_t nextSensorTask(const SensorTask* tasks, uint8_t count, uint8_t mask) {
+  uint8_t first = count;
+  for (uint8_t i = 0; i < count; i++) {
+    if (!(mask & (1 << i))) continue;
+    uint16_t khz = tasks[i].i2cKhz();
+    if (khz == 0 || khz == sensorBus.currentClock()) return i;
+    if (first == count) first = i;
+  }
+  return first;
+}
+
+// 변환 대기 (Light Sleep은 대기 중인 칩이 모두 허용할 때만)
+void sensorWait(uint32_t ms, bool sleep_ok) {
+  if (!sleep_ok || ms < SENSOR_SLEEP_MIN_MS) {
+    delay(ms);
+    return;
+  }
+
+  Serial.flush();
+  esp_sleep_enable_timer_wakeup(ms * 1000ULL);
+  esp_light_sleep_start();
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+}
+
+// 모든 변환 시작 → 가장 이른 준비 시점까지 대기 → 준비된 칩부터 수집
+// enabled: 이번 주기에 사용할 항목 비트마스크 (없는 센서 제외)
+// 반환: 수집에 성공한 항목 비트마스크 (bit i = tasks[i])
+uint8_t pollSensors(const SensorTask* tasks, uint8_t count, uint8_t enabled = 0xFF) {
+  static uint32_t ready_at[SENSOR_TASKS_MAX];
+  uint8_t pending = 0;
+  uint8_t collected = 0;
+  uint32_t start = millis();
+
+  if (count > SENSOR_TASKS_MAX) count = SENSOR_TASKS_MAX;
+
+  uint8_t untriggered = enabled & ((1 << count) - 1);
+  while (untriggered) {
+    uint8_t i = nextSensorTask(tasks, count, untriggered);
+    untriggered &= ~(1 << i);
+    if (tasks[i].trigger()) {
+      ready_at[i] = millis() + tasks[i].readyInMs();
+      pending |= 1 << i;
+    } else {
+      Serial.printf("✗ %s: trigger failed\n", tasks[i].name);
+    }
+  }
+
+  while (pending) {
+    // 남은 변환 중 가장 먼저 끝나는 시점까지 대기
+    uint32_t now = millis();
+    int32_t wait_ms = INT32_MAX;
+    bool sleep_ok = true;
+    for (uint8_t i = 0; i < count; i++) {
+      if (!(pending & (1 << i))) continue;
+      int32_t remaining = (int32_t)(ready_at[i] - now);
+      if (remaining < wait_ms) wait_ms = remaining;
+      sleep_ok = sleep_ok && tasks[i].sleepOk();
+    }
+    if (wait_ms > 0) sensorWait(wait_ms, sleep_ok);
+
+    now = millis();
+    uint8_t ready = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      if ((pending & (1 << i)) && (int32_t)(ready_at[i] - now) <= 0) ready |= 1 << i;
+    }
+
+    while (ready) {
+      uint8_t i = nextSensorTask(tasks, count, ready);
+      ready &= ~(1 << i);
+      pending &= ~(1 << i);
+      if (tasks[i].collect()) {
+        collected |= 1 << i;
+      } else {
+        Serial.printf("✗ %s: collect failed\n", tasks[i].name);
+      }
+    }
+  }
+
+  Serial.printf("Sensor cycle: %d task(s) in %lums\n", count, millis() - start);
+  return collected;
+}
+
+#endif
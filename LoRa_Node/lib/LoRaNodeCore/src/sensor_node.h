@@ -0,0 +1,314 @@
+#ifndef _SENSOR_NODE_H
+#define _SENSOR_NODE_H
+
+#include "device_registry.h" // Chip ID → Device ID
+#include "power_manager.h"   // DFS/자동 Light Sleep, PM 잠금
+#include "node_state.h"
+#include "node_display.h"
+#include "node_link.h"
+#ifdef NODE_HISTORY
+#include "history_log.h"    // 플래시 측정 기록 (델타 압축)
+#endif
+#ifdef NODE_ULP_SCREEN
+#include "ulp_monitor.h"    // ULP RISC-V 사전 선별 (변화가 있을 때만 메인 CPU 깨움)
+#endif
+#ifdef NODE_WIFI_BACKHAUL
+#include "wifi_backhaul.h"  // 밀린 측정값을 Wi-Fi/MQTT로 한꺼번에 (AP가 보일 때만)
+#endif
+#ifdef NODE_AES_BENCH
+#include "aes_benchmark.h"  // 프레임당 암호 연산 시간/에너지 (소프트웨어 vs 하드웨어 AES)
+#endif
+
+// ============================================================================
+// 센서 노드 공통 setup()/loop()
+//
+// 센서 드라이버는 main.cpp에서 빌드 환경(NODE_SENSOR_*)에 따라 컴파일 타임에 하나만
+// 선택되며, 아래 인터페이스만 맞추면 됨 (가상 함수/동적 할당 없음)
+//
+//   typedef ... Reading;                              // 한 주기의 측정값
+//   static const uint8_t PAYLOAD_SIZE;                // 측정 데이터 크기 (디스크립터 제외)
+//   static const uint8_t FRAME_TYPE;                  // FRAME_TYPE_* (frame_header.h)
+//   static const uint8_t FRAME_VERSION;               // encode() 바이트 배치 버전 (1 = 디스크립터 없던 구 배치)
+//   static const uint32_t DELTA_U16_FIELDS;           // 16비트 필드 시작 위치 비트 마스크 (delta_codec.h)
+//   const char* title();                              // 화면 헤더 제목
+//   const char* splashTitle();                        // 초기화 화면 제목
+//   bool begin();                                     // 센서 버스/센서 초기화
+//   Reading read();                                   // 칩 측정은 pollSensors()로 (sensor_driver.h)
+//   void encode(const Reading&, uint8_t* buffer);     // PAYLOAD_SIZE 바이트 (앞의 디스크립터는 공통 코드가 붙임)
+//   void print(const Reading&);                       // 시리얼 출력
+//   void draw(const Reading&);                        // 화면 센서 행 (DISPLAY_ROW_1~4)
+//   void onConfigActions(uint8_t actions);            // CONFIG_ACTION_* 처리
+// ============================================================================
+
+template <typename Sensor>
+class SensorNode {
+ public:
+  static Sensor sensor;
+  static bool boot_frame;  // 부팅 후 아직 프레임을 만들지 않음 (FRAME_FLAG_BOOT)
+
+  static const uint8_t FRAME_SIZE = FRAME_DESCRIPTOR_SIZE + Sensor::PAYLOAD_SIZE;
+
+  // 업링크 프레임: [디스크립터][측정 데이터] (FRAME_SIZE 바이트)
+  static void encodeFrame(const typename Sensor::Reading &reading, uint8_t* frame) {
+    frame[0] = frameDescriptor(Sensor::FRAME_TYPE, Sensor::FRAME_VERSION, boot_frame ? FRAME_FLAG_BOOT : 0);
+    boot_frame = false;
+    sensor.encode(reading, frame + FRAME_DESCRIPTOR_SIZE);
+  }
+
+  // 다운링크 명령 처리 (원격 설정)
+  static void handleDownlink(uint8_t fPort, const uint8_t* payload, size_t len) {
+    Serial.print("Downlink received on FPort " + String(fPort) + ": ");
+    arrayDump((uint8_t*)payload, len);
+
+    if (fPort != CONFIG_FPORT) {
+      Serial.println("Unknown downlink port - ignored");
+      return;
+    }
+
+    uint8_t actions = handleConfigDownlink(payload, len, node_config, default_node_config);
+    if (config_ack.status != CONFIG_ACK_OK) return;
+
+    sensor.onConfigActions(actions);
+    applyNodeConfig();
+    printNodeConfig();
+  }
+
+  // 업링크 전송 + 결과 처리 (정상 측정값과 밀린 측정값 공통)
+  // 성공: 링크 통계/시간 동기/세션 손실 점검 후 다운링크 처리, 실패: 원인별 복구 (필요하면 바로 재연결)
+  static bool sendUplink(uint8_t* payload, size_t len, uint8_t fPort, uint32_t now) {
+    uint8_t downlinkPayload[DOWNLINK_BUFFER_SIZE];
+    size_t downlinkSize = 0;
+    LoRaWANEvent_t uplinkDetails = {};
+    LoRaWANEvent_t downlinkDetails = {};
+
+    requestLinkCheckIfDue();
+    requestNetworkTimeIfDue();
+    uint64_t txStartMs = systemClockMs();
+    loraHal.arm(true);  // TX 완료 후 RX1/RX2 윈도우까지 Light Sleep
+    int16_t sendState = node.sendReceive(payload, len, fPort,
+                                         downlinkPayload, &downlinkSize, false, &uplinkDetails, &downlinkDetails);
+    loraHal.arm(false);
+
+    if (!uplinkSucceeded(sendState)) {
+      Serial.println("✗ Send failed: " + stateDecode(sendState) + " (" + String(sendState) + ")");
+      consecutive_send_failures++;
+      lorawan_status = LORAWAN_SEND_FAILED;
+      onLinkFailure(consecutive_send_failures);
+
+      Serial.println("Consecutive failures: " + String(consecutive_send_failures) + "/" + String(node_config.max_send_failures));
+
+      // 실패 원인별 복구: 라디오/세션 오류는 바로 복구, 일시적 실패는 백오프만
+      recordLinkFailure(sendState, consecutive_send_failures, node_config.max_send_failures);
+      if (recoveryPending()) {
+        Serial.println("Radio/session fault detected. Attempting immediate recovery...");
+        smartReconnect();
+      }
+      return false;
+    }
+
+    bool downlink = downlinkReceived(sendState, downlinkSize);
+    Serial.println("✓ Data sent successfully! (State: " + stateDecode(sendState) + ")");
+    consecutive_send_failures = 0;
+    recoveryClear();
+    radio_health.phy_configured = true;
+    last_successful_send = now;
+    lorawan_status = LORAWAN_CONNECTED;
+    if (fPort == CONFIG_ACK_FPORT) config_ack.pending = false;
+    updateLinkStats(downlink, uplinkDetails);
+    updateNetworkTime(txStartMs);
+    onLinkSuccess(node_config.adr_enabled);
+
+    // 비확인형 업링크는 서버가 세션을 버려도 성공하므로 LinkCheckAns가 계속 없으면 세션 손실로 보고 재조인
+    if (linkCheckSessionLost()) {
+      Serial.println("✗ No downlink for " + String(NODE_SESSION_LOSS_S) + "s (" + String(link_stats.checks_unanswered) +
+                     " LinkCheckReq unanswered) - session lost on server, rejoining");
+      radio_recovery.session_lost = true;
+      linkCheckReset();
+    }
+
+    if (downlink) {
+      handleDownlink(downlinkPort(downlinkDetails), downlinkPayload, downlinkSize);
+    }
+    return true;
+  }
+
+  // 밀린 측정값 한 프레임 전송 (uplink_queue.h) - 성공한 만큼만 큐에서 제거, 실패하면 다음 주기에 다시
+  static void sendQueuedUplink(uint32_t now) {
+    uint8_t frame[QUEUED_UPLINK_FRAME_SIZE];
+    size_t frameSize;
+    uint8_t fPort;
+    uint8_t count = buildQueuedUplink(frame, frameSize, fPort, Sensor::DELTA_U16_FIELDS);
+    if (count == 0) return;
+
+    if (sendUplink(frame, frameSize, fPort, now)) dropQueuedUplinks(count);
+  }
+
+  // OLED 업데이트 (공통 헤더 + 센서 행)
+  static void updateDisplay(const typename Sensor::Reading &reading) {
+    if (!oled_available) return;
+
+    drawStatusHeader(sensor.title(), lorawan_status);
+    sensor.draw(reading);
+    display.display();
+  }
+
+  static void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+#ifdef NODE_BATTERY
+    init_battery_adc();
+#endif
+#ifdef NODE_ULP_SCREEN
+    initUlpScreen();   // 부팅 중에도 배터리 샘플을 쌓아 첫 주기 전압 표시
+#endif
+    // CPU 클록: DFS + 자동 Light Sleep (NODE_PM_DFS) 또는 고정 클록 (NODE_CPU_MHZ)
+    initPowerManagement();
+
+    Serial.println("\n=== LoRaWAN + Sensors Initializing ===");
+
+    // Device ID 가져오기
+    device_id = getDeviceID();
+    Serial.print("Device ID: ");
+    Serial.println(device_id);
+
+    // 원격 설정 (업링크 주기, 재연결 정책, 고도 기준값 등) 불러오기
+    loadNodeConfig(node_config, default_node_config);
+    printNodeConfig();
+
+#ifdef NODE_HISTORY
+    initHistory();
+#endif
+
+    display_splash_title = sensor.splashTitle();
+    initDisplay();
+
+    // 센서 초기화 (필수 센서가 없으면 드라이버가 재시작)
+    sensor.begin();
+    delay(1000);
+
+    initLoRaWAN();
+    Serial.println("Sensors + LoRaWAN initialized successfully!");
+
+#ifdef NODE_AES_BENCH
+    runAesBenchmark(FRAME_SIZE);
+#endif
+  }
+
+  static void loop() {
+    uint32_t currentTime = millis();
+
+    // 센서 데이터 읽기
+    typename Sensor::Reading reading = sensor.read();
+
+#ifdef NODE_BATTERY
+    // 배터리 상태 업데이트
+    updateBatteryStatus();
+#endif
+
+    // 연결 상태 확인 및 재연결 시도
+    if (!node.isActivated() || recoveryPending()) {
+      Serial.println("=== CONNECTION ISSUE DETECTED ===");
+      Serial.println("Activated: " + String(node.isActivated()));
+      Serial.println("Consecutive failures: " + String(consecutive_send_failures));
+
+      // 스마트 재연결 시도
+      if (smartReconnect()) {
+        Serial.println("✓ Reconnection successful!");
+        lorawan_status = LORAWAN_CONNECTED;
+      } else {
+        Serial.println("✗ Reconnection failed!");
+        lorawan_status = LORAWAN_DISCONNECTED;
+      }
+    } else {
+      lorawan_status = LORAWAN_CONNECTED;
+    }
+
+    // OLED 디스플레이 업데이트 (Device ID + 아이콘)
+    updateDisplay(reading);
+
+    // 시리얼로 센서 데이터 출력
+    Serial.println("=== Sensor Data ===");
+    Serial.println("Device ID: " + device_id);
+    sensor.print(reading);
+
+    uint8_t frame[FRAME_SIZE];
+    encodeFrame(reading, frame);
+#ifdef NODE_HISTORY
+    recordHistory(frame, FRAME_SIZE, Sensor::DELTA_U16_FIELDS);
+#endif
+
+    // LoRaWAN 전송 시도 (연결된 경우에만)
+    // 일시적 실패 후 백오프 중이거나 라디오 사전 점검에 실패하면 이번 주기는 측정값을 보관만 함
+    if (lorawan_status == LORAWAN_CONNECTED && !transientBackoffActive() && preflightRadio()) {
+      // 설정 응답 대기 중이면 앞에 3바이트 응답을 붙여 FPort 11로 전송
+      uint8_t uplinkPayload[CONFIG_ACK_SIZE + FRAME_SIZE];
+      size_t dataOffset = 0;
+      uint8_t uplinkPort = prependConfigAck(uplinkPayload, dataOffset);
+      memcpy(uplinkPayload + dataOffset, frame, FRAME_SIZE);
+
+      Serial.println("Sending sensor data via LoRaWAN...");
+      if (sendUplink(uplinkPayload, dataOffset + FRAME_SIZE, uplinkPort, currentTime)) {
+        // 연결이 복구되었으면 밀린 측정값을 주기마다 한 프레임씩 전송 (세션을 잃었으면 재조인 뒤로 미룸)
+        if (!recoveryPending()) sendQueuedUplink(currentTime);
+      } else {
+        enqueueUplink(frame, FRAME_SIZE);
+      }
+    } else {
+      Serial.println(lorawan_status == LORAWAN_DISCONNECTED ? "⚠ LoRaWAN not connected - queuing reading"
+                                                            : "⚠ Uplink skipped (backoff or radio fault) - queuing reading");
+      enqueueUplink(frame, FRAME_SIZE);
+    }
+
+#ifdef NODE_WIFI_BACKHAUL
+    // LoRa로 주기마다 하나씩 보내기엔 많이 밀렸으면 설정한 AP로 한꺼번에
+    drainBacklogViaWifi(Sensor::DELTA_U16_FIELDS);
+#endif
+
+    // 전송 결과를 반영하여 디스플레이 다시 업데이트
+    updateDisplay(reading);
+
+    // 통계 정보 출력
+    Serial.println("=== Connection Stats ===");
+    Serial.println("Status: " + String(lorawan_status));
+    Serial.println("Consecutive failures: " + String(consecutive_send_failures));
+    Serial.println("Last successful send: " + String((currentTime - last_successful_send) / 1000) + "s ago");
+    Serial.println("Next transmission in " + String(node_config.uplink_interval_s) + " seconds");
+    Serial.println("========================");
+
+#ifdef NODE_BATTERY
+    // 배터리 상태 출력
+    Serial.println("=== Battery Status ===");
+    Serial.println("Voltage: " + String(battery_voltage, 2) + "V");
+    Serial.println("Percentage: " + String(battery_percentage) + "%");
+#endif
+
+    // 화면 표시 시간 (원격 설정값, 기본 5초)
+    Serial.println("Display will stay on for " + String(node_config.display_hold_s) + " seconds...");
+    delay(node_config.display_hold_s * 1000UL);
+
+    if (oled_available) {
+      displayOff();
+      Serial.println("Display turned off for power saving");
+    }
+
+    // Light Sleep으로 전환 (메모리 유지 = 재JOIN 방지)
+    // 다음 주기는 이 장치의 슬롯에서 시작 (동시에 켜진 노드끼리 전송 시각이 겹치지 않게)
+#ifdef NODE_ULP_SCREEN
+    // 밀린 것이 없으면 ULP가 변화(또는 하트비트)를 볼 때까지 잠
+    sleepUntilNextCycle(node_config.uplink_interval_s);
+#else
+    sleepUntilNextSlot(node_config.uplink_interval_s);
+#endif
+
+    // 이제 루프가 다시 시작되지만 LoRaWAN 세션이 유지됨!
+  }
+};
+
+template <typename Sensor>
+Sensor SensorNode<Sensor>::sensor;
+
+template <typename Sensor>
+bool SensorNode<Sensor>::boot_frame = true;
+
+#endif
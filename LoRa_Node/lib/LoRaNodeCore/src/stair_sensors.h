@@ -0,0 +1,371 @@
+#ifndef _STAIR_SENSORS_H
+#define _STAIR_SENSORS_H
+
+#include "bme280.h"
+#include "bmp390.h"
+#include "node_display.h"
+
+// ============================================================================
+// 계단 센서 드라이버 (BME280 필수 + BMP390 선택, 고도/층 이동 감지)
+// NODE_SENSOR_STAIR 환경에서 사용, 인터페이스는 sensor_node.h 참고
+// 두 칩은 pollSensors()로 동시에 변환을 시작하므로 주기당 대기는 BMP390 변환 시간(~25ms)뿐
+//
+// 14바이트 페이로드:
+//   [0-1] BME280 온도  [2-3] 습도  [4-5] BME280 압력
+//   [6-7] BMP390 온도  [8-9] BMP390 압력  [10-11] 고도
+//   [12] 링크 품질 (link_quality.h)  [13] 고도 상태 플래그
+// ============================================================================
+
+// 센서 I2C 핀 설정 (GPIO41, 42)
+#define SENSOR_SDA_PIN 41
+#define SENSOR_SCL_PIN 42
+
+// 고도 계산 관련 설정
+#define ALT_EVENT_THRESHOLD_M 1.5f    // 층 이동(이벤트)으로 판단할 고도 변화량
+#define ALT_CALIBRATION_SAMPLES 16    // 기준 기압 보정 시 평균낼 샘플 수
+
+const unsigned char PROGMEM icon_pressure[] = {
+  0x3C, 0x42, 0x99, 0xA5, 0xA5, 0x99, 0x42, 0x3C  // 🎈 풍선 (압력 대신)
+};
+
+const unsigned char PROGMEM icon_altitude[] = {
+  0x10, 0x38, 0x7C, 0xFE, 0x44, 0x28, 0x10, 0x00  // 🏔️ 산 (더 선명하게)
+};
+
+// 센서 데이터 구조체
+struct StairData {
+  float temperature_bme;  // BME280 온도
+  float humidity;         // BME280 습도
+  float pressure_bme;     // BME280 압력
+  float temperature_bmp;  // BMP390 온도
+  float pressure_bmp;     // BMP390 압력
+  float altitude;         // BMP390 고도 (상대고도 모드에서는 기준점 대비 고도)
+  bool altitude_event;    // 고도 급변 감지 (버스트 샘플링 수행됨)
+};
+
+// 기압 → 고도 변환 (국제 표준 대기 공식, reference_hpa 지점을 0m로 봄)
+float pressureToAltitude(float pressure_hpa, float reference_hpa) {
+  return 44330.0f * (1.0f - powf(pressure_hpa / reference_hpa, 0.1903f));
+}
+
+// 주기 측정 스케줄 (BMP390이 없으면 앞의 BME280만 사용)
+const SensorTask stair_tasks[] = {
+  SENSOR_TASK("BME280", Bme280),
+  SENSOR_TASK("BMP390", Bmp390),
+};
+
+class StairSensors {
+ public:
+  typedef StairData Reading;
+  static const uint8_t PAYLOAD_SIZE = 14;
+  static const uint8_t FRAME_TYPE = FRAME_TYPE_STAIR;
+  static const uint8_t FRAME_VERSION = 2;  // 바이트 배치 변경 시 증가
+  static const uint32_t DELTA_U16_FIELDS = 0x00000555;  // 16비트 필드 시작 위치 [0-10] 짝수 바이트
+
+  const char* title() {
+#ifdef NODE_BATTERY
+    return " Stair-sensors ";
+#else
+    return " LoRa:Stair ";
+#endif
+  }
+
+  const char* splashTitle() { return "LoRa-Stair Sensors"; }
+
+  bool begin() {
+    // 센서용 I2C 초기화 (GPIO41, 42) - sensorBus(Wire) 사용
+    sensorBus.begin(SENSOR_SDA_PIN, SENSOR_SCL_PIN);
+    Serial.println("Sensor I2C initialized");
+    displayInitScreen("I2C initialized");
+    delay(500);
+
+    // BME280 초기화 (주소 0x76)
+    Serial.println("Attempting BME280 initialization...");
+    if (!Bme280::begin(sensorBus, BME280_ADDRESS)) {
+      Serial.println("Critical: BME280 sensor not found at 0x76!");
+      displayInitScreen("BME280 FAIL!");
+      bme280_available = false;
+      delay(3000);
+
+      // BME280 없이는 동작 불가 - 재시작
+      Serial.println("BME280 is required sensor. Restarting...");
+      ESP.restart();
+    } else {
+      Serial.println("BME280 initialized successfully (0x76)");
+      bme280_available = true;
+      displayInitScreen("BME280 OK");
+    }
+    delay(500);
+
+    // BMP390 초기화 전 지연
+    delay(1000);
+    Serial.println("Attempting BMP390 initialization...");
+    displayInitScreen("Checking BMP390...");
+
+    // BMP390 초기화 (주소 0x77)
+    if (!Bmp390::begin(sensorBus, BMP390_ADDRESS)) {
+      Serial.println("BMP390 sensor not found at 0x77!");
+      Serial.println("Continuing with BME280 only...");
+      bmp390_available = false;
+      displayInitScreen("BMP390 not found");
+    } else {
+      Serial.println("BMP390 initialized successfully (0x77)");
+      bmp390_available = true;   // BMP390 사용 가능 표시
+      Serial.println("BMP390 configured (forced mode, P x4, T x8, IIR 3)");
+      displayInitScreen("BMP390 OK");
+    }
+    return bme280_available;
+  }
+
+  // 센서 데이터 읽기 함수 (데이터 유효성 검증 추가)
+  Reading read() {
+    StairData data;
+
+    // 기본값 설정 (센서 오류 시 대비)
+    data.temperature_bme = 0.0;
+    data.humidity = 0.0;
+    data.pressure_bme = 1013.25;
+    data.temperature_bmp = 0.0;
+    data.pressure_bmp = 1013.25;
+    data.altitude = 0.0;
+    data.altitude_event = false;
+
+    // 두 칩 변환을 동시에 시작하고 끝나는 대로 수집
+    uint8_t collected = pollSensors(stair_tasks, bmp390_available ? 2 : 1);
+
+    // BME280 데이터 읽기
+    if (bme280_available && !(collected & 0x01)) {
+      Serial.println("Warning: BME280 reading failed");
+    } else if (bme280_available) {
+      data.temperature_bme = Bme280::data().temperature;
+      data.humidity = Bme280::data().humidity;
+      data.pressure_bme = Bme280::data().pressure;
+
+      // 데이터 유효성 검증
+      if (isnan(data.temperature_bme) || data.temperature_bme < -40 || data.temperature_bme > 85) {
+        Serial.println("Warning: Invalid BME280 temperature reading");
+        data.temperature_bme = 0.0;
+      }
+      if (isnan(data.humidity) || data.humidity < 0 || data.humidity > 100) {
+        Serial.println("Warning: Invalid BME280 humidity reading");
+        data.humidity = 0.0;
+      }
+      if (isnan(data.pressure_bme) || data.pressure_bme < 800 || data.pressure_bme > 1200) {
+        Serial.println("Warning: Invalid BME280 pressure reading");
+        data.pressure_bme = 1013.25;
+      }
+    }
+
+    // BMP390 사용 가능 여부에 따라 분기
+    if (bmp390_available) {
+      // BMP390 새 데이터 읽기
+      if (collected & 0x02) {
+        data.temperature_bmp = Bmp390::data().temperature;
+        data.pressure_bmp = Bmp390::data().pressure;
+
+        // 데이터 유효성 검증
+        if (isnan(data.temperature_bmp) || data.temperature_bmp < -40 || data.temperature_bmp > 85) {
+          Serial.println("Warning: Invalid BMP390 temperature reading");
+          data.temperature_bmp = data.temperature_bme;
+        }
+        if (isnan(data.pressure_bmp) || data.pressure_bmp < 800 || data.pressure_bmp > 1200) {
+          Serial.println("Warning: Invalid BMP390 pressure reading");
+          data.pressure_bmp = data.pressure_bme;
+        }
+
+        // 고도 계산 (읽은 기압으로 직접 계산)
+        readAltitude(data);
+      } else {
+        // BMP390 읽기 실패 시 BME280 값 사용
+        Serial.println("Warning: BMP390 reading failed, using BME280 data");
+        data.temperature_bmp = data.temperature_bme;
+        data.pressure_bmp = data.pressure_bme;
+        data.altitude = 0.0;
+      }
+    } else {
+      // BMP390 없으면 BME280 값으로 대체
+      data.temperature_bmp = data.temperature_bme;   // BME280 온도 사용
+      data.pressure_bmp = data.pressure_bme;         // BME280 압력 사용
+      data.altitude = 0.0;                           // 고도 0으로 설정
+    }
+
+    return data;
+  }
+
+  // 센서 데이터를 바이트 배열로 변환
+  void encode(const Reading &data, uint8_t* buffer) {
+    // 온도: -40~85°C를 0~1250으로 매핑 (0.1°C 정밀도)
+    uint16_t temp_bme = (uint16_t)((data.temperature_bme + 40) * 10);
+    uint16_t temp_bmp = (uint16_t)((data.temperature_bmp + 40) * 10);
+
+    // 습도: 0~100%를 0~1000으로 매핑 (0.1% 정밀도)
+    uint16_t hum = (uint16_t)(data.humidity * 10);
+
+    // 압력: 800~1200hPa를 0~4000으로 매핑 (0.1hPa 정밀도)
+    uint16_t press_bme = (uint16_t)((data.pressure_bme - 800) * 10);
+    uint16_t press_bmp = (uint16_t)((data.pressure_bmp - 800) * 10);
+
+    // 고도: 절대고도 모드는 -500~4000m를 0~4500으로 매핑 (1m 정밀도)
+    //       상대고도 모드는 기준점 대비 0.1m 단위 부호 있는 값 (int16)
+    uint16_t alt;
+    bool relative = node_config.alt_mode == ALT_MODE_RELATIVE && !isnan(node_config.alt_baseline_hpa);
+    if (relative) {
+      alt = (uint16_t)(int16_t)lroundf(data.altitude * 10);
+    } else {
+      alt = (uint16_t)(data.altitude + 500);
+    }
+
+    // 고도 상태 플래그 (비트마스크)
+    uint8_t alt_flags = 0;
+    if (relative) alt_flags |= 0x01;            // bit0: 상대고도 모드
+    if (data.altitude_event) alt_flags |= 0x02; // bit1: 고도 이벤트 (버스트 샘플링)
+    if (node_config.qnh_hpa != STANDARD_QNH_HPA) alt_flags |= 0x04; // bit2: 현지 QNH 적용
+
+    // 12바이트 패킷 구성 + 상태 정보 추가 (14바이트)
+    buffer[0] = temp_bme >> 8;        // BME280 온도 상위
+    buffer[1] = temp_bme & 0xFF;      // BME280 온도 하위
+    buffer[2] = hum >> 8;             // 습도 상위
+    buffer[3] = hum & 0xFF;           // 습도 하위
+    buffer[4] = press_bme >> 8;       // BME280 압력 상위
+    buffer[5] = press_bme & 0xFF;     // BME280 압력 하위
+    buffer[6] = temp_bmp >> 8;        // BMP390 온도 상위
+    buffer[7] = temp_bmp & 0xFF;      // BMP390 온도 하위
+    buffer[8] = press_bmp >> 8;       // BMP390 압력 상위
+    buffer[9] = press_bmp & 0xFF;     // BMP390 압력 하위
+    buffer[10] = alt >> 8;            // 고도 상위
+    buffer[11] = alt & 0xFF;          // 고도 하위
+    buffer[12] = encodeLinkQuality(consecutive_send_failures); // 링크 품질 (link_quality.h 참고)
+    buffer[13] = alt_flags;           // 고도 상태 플래그
+  }
+
+  void print(const Reading &data) {
+    Serial.println("BME280 - Temp: " + String(data.temperature_bme, 1) + "°C, Humidity: " + String(data.humidity, 1) + "%, Pressure: " + String(data.pressure_bme, 1) + "hPa");
+
+    if (bmp390_available) {
+      Serial.println("BMP390 - Temp: " + String(data.temperature_bmp, 1) + "°C, Pressure: " + String(data.pressure_bmp, 1) + "hPa, Altitude: " + String(data.altitude, 1) + "m" +
+                     (node_config.alt_mode == ALT_MODE_RELATIVE ? " (relative)" : " (QNH " + String(node_config.qnh_hpa, 1) + "hPa)"));
+    } else {
+      Serial.println("BMP390 - Not available (using BME280 data)");
+    }
+  }
+
+  void draw(const Reading &data) {
+    // 온도 (왼쪽 - 아이콘 + 텍스트) - BME280 사용
+    display.drawBitmap(0, DISPLAY_ROW_1, icon_temp, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_1);
+    display.print("Temp: ");
+    display.print(data.temperature_bme, 1);
+    display.println(" C");
+
+    // 습도 (왼쪽) - BME280 사용
+    display.drawBitmap(0, DISPLAY_ROW_2, icon_humidity, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_2);
+    display.print("Humi: ");
+    display.print(data.humidity, 1);
+    display.println(" %");
+
+    // 압력 (왼쪽) - BMP390 우선, 없으면 BME280
+    display.drawBitmap(0, DISPLAY_ROW_3, icon_pressure, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_3);
+    display.print("Press: ");
+    if (bmp390_available) {
+      display.print(data.pressure_bmp, 1);
+    } else {
+      display.print(data.pressure_bme, 1);
+    }
+    display.println(" hPa");
+
+    // 고도 - BMP390만 (더 정확함)
+    display.drawBitmap(0, DISPLAY_ROW_4, icon_altitude, 8, 8, SSD1306_WHITE);
+    display.setCursor(12, DISPLAY_ROW_4);
+    if (bmp390_available && node_config.alt_mode == ALT_MODE_RELATIVE) {
+      display.print("dAlt: ");
+      display.print(data.altitude, 1);
+      display.println(" m");
+    } else if (bmp390_available) {
+      display.print("Alt: ");
+      display.print(data.altitude, 0);
+      display.println(" m");
+    } else {
+      display.print("Alt: ");
+      display.println("N/A");
+    }
+  }
+
+  void onConfigActions(uint8_t actions) {
+    if (actions & CONFIG_ACTION_CALIBRATE) {
+      alt_calibrate_pending = true;
+      Serial.println("✓ Baseline calibration scheduled for next cycle");
+    }
+  }
+
+ private:
+  bool bme280_available = false;
+  bool bmp390_available = false;
+
+  // 고도 관련 상태 변수들
+  bool alt_calibrate_pending = false;  // 다음 측정값을 기준 기압으로 사용
+  float last_altitude = NAN;           // 이전 주기 고도 (이벤트 감지용)
+
+  // BMP390 연속 샘플링 후 평균 기압 반환 (실패 시 NAN)
+  float readBurstPressure(uint8_t samples) {
+    float sum = 0.0f;
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < samples; i++) {
+      if (Bmp390::readBlocking()) {
+        sum += Bmp390::data().pressure;
+        count++;
+      }
+    }
+
+    return count > 0 ? sum / count : NAN;
+  }
+
+  // 고도 계산 (절대고도: QNH 기준, 상대고도: 보정된 기준 기압 대비)
+  void readAltitude(StairData &data) {
+    // 기준 기압 보정 요청 처리 (다운링크 또는 상대고도 모드 최초 진입)
+    bool needs_baseline = node_config.alt_mode == ALT_MODE_RELATIVE && isnan(node_config.alt_baseline_hpa);
+    if (alt_calibrate_pending || needs_baseline) {
+      float baseline = readBurstPressure(ALT_CALIBRATION_SAMPLES);
+      if (!isnan(baseline) && baseline >= 800 && baseline <= 1200) {
+        node_config.alt_baseline_hpa = baseline;
+        saveNodeConfig(node_config);
+        last_altitude = NAN;
+        Serial.println("✓ Altitude baseline calibrated: " + String(baseline, 2) + "hPa");
+      }
+      alt_calibrate_pending = false;
+    }
+
+    float reference = node_config.qnh_hpa;
+    float min_alt = -500, max_alt = 4000;
+    if (node_config.alt_mode == ALT_MODE_RELATIVE && !isnan(node_config.alt_baseline_hpa)) {
+      reference = node_config.alt_baseline_hpa;
+      min_alt = -3276, max_alt = 3276; // 0.1m 단위 int16 범위
+    }
+
+    data.altitude = pressureToAltitude(data.pressure_bmp, reference);
+
+    // 층 이동 등 급격한 변화 시 버스트 샘플링으로 노이즈 감소
+    if (node_config.alt_burst_samples > 0 && !isnan(last_altitude) &&
+        fabsf(data.altitude - last_altitude) >= ALT_EVENT_THRESHOLD_M) {
+      float burst_pressure = readBurstPressure(node_config.alt_burst_samples);
+      if (!isnan(burst_pressure)) {
+        data.pressure_bmp = burst_pressure;
+        data.altitude = pressureToAltitude(burst_pressure, reference);
+        data.altitude_event = true;
+        Serial.println("Altitude event detected - burst sampled " + String(node_config.alt_burst_samples) + " readings");
+      }
+    }
+
+    if (isnan(data.altitude) || data.altitude < min_alt || data.altitude > max_alt) {
+      Serial.println("Warning: Invalid BMP390 altitude reading");
+      data.altitude = 0.0;
+      return;
+    }
+
+    last_altitude = data.altitude;
+  }
+};
+
+#endif
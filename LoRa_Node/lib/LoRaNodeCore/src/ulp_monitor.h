@@ -0,0 +1,198 @@
+#ifndef _ULP_MONITOR_H
+#define _ULP_MONITOR_H
+
+#include <Arduino.h>
+#include "esp_sleep.h"
+#include "esp_idf_version.h"
+#include "ulp_riscv.h"
+#include "ulp_riscv_adc.h"
+#ifdef NODE_ULP_BMP390
+#include "ulp_riscv_i2c.h"
+#include "bmp390.h"
+#endif
+#include "ulp_main.h"          // ulp_embed_binary가 만드는 ULP 변수 심볼 (ulp_screen_state 등)
+#include "ulp_screen.h"
+#include "battery_monitor.h"
+#include "node_link.h"
+
+// ============================================================================
+// ULP RISC-V 사전 선별 - 메인 코어 쪽 (NODE_ULP_SCREEN, stair_battery_ulp 환경)
+//
+// 보낼 것이 없는 주기에는 메인 CPU를 깨우지 않음: ULP(LoRa_Node/ulp/main.c)가 업링크 주기마다
+// 배터리 ADC와 선택 BMP390(NODE_ULP_BMP390, RTC I2C)을 읽고 ulp_screen.h로 판단해서 깨움
+//  - 깨우는 조건: 배터리 ±NODE_ULP_BATTERY_DELTA_MV, 저전압 진입, 기압 ±NODE_ULP_PRESSURE_DELTA_PA,
+//    변화가 없어도 NODE_ULP_HEARTBEAT_CYCLES 주기마다 (서버가 노드 생존 확인)
+//  - 밀린 측정값/재연결/백오프 중에는 평소처럼 슬롯마다 깸 (ulpScreenReady())
+//  - ULP가 멈춰도 하트비트 + 1 주기 뒤에는 타이머로 깸
+// Light Sleep이라 LoRaWAN 세션은 그대로. ULP 주기는 슬롯에 맞춰 시작한 주기 끝부터 세므로 위상이 슬롯을 따라감
+// 임계값은 ULP가 읽는 원시 단위로 바꿔 넣음 (배터리: ADC 보정 곡선, 기압: 센서 보정 계수)
+// ============================================================================
+
+#ifndef NODE_BATTERY
+#error "NODE_ULP_SCREEN samples the battery ADC - build it together with NODE_BATTERY"
+#endif
+
+#ifndef NODE_ULP_HEARTBEAT_CYCLES
+#define NODE_ULP_HEARTBEAT_CYCLES 6
+#endif
+
+#ifndef NODE_ULP_BATTERY_DELTA_MV
+#define NODE_ULP_BATTERY_DELTA_MV 50
+#endif
+
+#ifndef NODE_ULP_PRESSURE_DELTA_PA
+#define NODE_ULP_PRESSURE_DELTA_PA 18     // 약 1.5m (ALT_EVENT_THRESHOLD_M)
+#endif
+
+#define ULP_BATTERY_LOW_V 3.50f           // calculateBatteryPercentage() 10% 구간
+#define ULP_BATTERY_REF_V 3.70f           // 변화량 → ADC 카운트 환산 지점
+#define ULP_BMP390_ADDRESS 0x77
+#define ULP_STARTUP_PERIOD_US 500000ULL   // 부팅 중 첫 샘플을 빨리 얻기 위한 주기 (첫 Light Sleep에서 업링크 주기로)
+
+extern const uint8_t ulp_main_bin_start[] asm("_binary_ulp_main_bin_start");
+extern const uint8_t ulp_main_bin_end[] asm("_binary_ulp_main_bin_end");
+
+UlpScreenConfig* const ulp_config = (UlpScreenConfig*)&ulp_screen_config;
+UlpScreenState* const ulp_state = (UlpScreenState*)&ulp_screen_state;
+bool ulp_running = false;
+bool ulp_slot_aligned = false;                // 이번 주기가 슬롯(또는 ULP)에 맞춰 시작했는지
+uint32_t ulp_wake_reason = ULP_WAKE_NONE;     // 이번 주기를 시작한 이유 (타이머로 깨면 heartbeat)
+
+#ifdef NODE_ULP_BMP390
+static void ulpBmpRead(uint8_t reg, uint8_t* data, size_t len) {
+  ulp_riscv_i2c_master_set_slave_addr(ULP_BMP390_ADDRESS);
+  ulp_riscv_i2c_master_set_slave_reg_addr(reg);
+  ulp_riscv_i2c_master_read_from_device(data, len);
+}
+
+static void ulpBmpWrite(uint8_t reg, uint8_t value) {
+  ulp_riscv_i2c_master_set_slave_addr(ULP_BMP390_ADDRESS);
+  ulp_riscv_i2c_master_set_slave_reg_addr(reg);
+  ulp_riscv_i2c_master_write_to_device(&value, 1);
+}
+
+// RTC I2C의 BMP390 설정 + NODE_ULP_PRESSURE_DELTA_PA → 원시값 차이 (센서가 없으면 0)
+static uint32_t setupUlpPressureSensor() {
+  ulp_riscv_i2c_cfg_t i2c = ULP_RISCV_I2C_DEFAULT_CONFIG();   // SDA GPIO3, SCL GPIO2
+  if (ulp_riscv_i2c_master_init(&i2c) != ESP_OK) return 0;
+
+  uint8_t id = 0;
+  ulpBmpRead(BMP390_REG_CHIP_ID, &id, 1);
+  if (id != BMP390_CHIP_ID) return 0;
+
+  ulpBmpWrite(BMP390_REG_CMD, 0xB6);   // 소프트 리셋
+  delay(2);
+  uint8_t c[21];
+  Bmp390Calib calib;
+  ulpBmpRead(BMP390_REG_CALIB, c, sizeof(c));
+  Bmp390::decodeCalibration(c, calib);
+  ulpBmpWrite(BMP390_REG_OSR, (BMP390_OSR_T << 3) | BMP390_OSR_P);
+  ulpBmpWrite(BMP390_REG_CONFIG, BMP390_IIR_COEF_3 << 1);
+
+  // 현재 기압 근처의 원시값 1카운트당 Pa (보상식 기울기)
+  uint8_t raw[6] = {0};
+  ulpBmpWrite(BMP390_REG_PWR_CTRL, BMP390_PWR_FORCED);
+  delay(BMP390_MEASURE_MS);
+  ulpBmpRead(BMP390_REG_DATA, raw, sizeof(raw));
+  uint32_t adc_p = (uint32_t)raw[2] << 16 | (uint32_t)raw[1] << 8 | raw[0];
+  uint32_t adc_t = (uint32_t)raw[5] << 16 | (uint32_t)raw[4] << 8 | raw[3];
+  double t_lin = Bmp390::compensateTemperature(calib, adc_t);
+  double pa_per_count = fabs(Bmp390::compensatePressure(calib, adc_p + 256, t_lin) -
+                             Bmp390::compensatePressure(calib, adc_p, t_lin)) / 256.0;
+  if (pa_per_count <= 0) return 0;
+  return (uint32_t)(NODE_ULP_PRESSURE_DELTA_PA / pa_per_count + 0.5);
+}
+#endif
+
+// setup()에서 init_battery_adc() 뒤에 한 번. 실패하면 평소 슬롯 주기로 동작
+void initUlpScreen() {
+  ulp_riscv_adc_cfg_t adc = {};
+  adc.adc_n = ADC_UNIT_1;
+  adc.channel = ADC_CHANNEL_0;   // GPIO1 (ADC_BAT)
+  adc.atten = ADC_ATTEN_DB_11;
+  adc.width = ADC_BITWIDTH_12;
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+  adc.ulp_mode = ADC_ULP_MODE_RISCV;
+#endif
+  if (ulp_riscv_adc_init(&adc) != ESP_OK) {
+    Serial.println("✗ ULP ADC init failed - pre-screening off");
+    return;
+  }
+
+  uint32_t pressure_delta = 0;
+#ifdef NODE_ULP_BMP390
+  pressure_delta = setupUlpPressureSensor();
+  if (!pressure_delta) Serial.println("⚠ ULP BMP390 not found on RTC I2C (GPIO3/2) - battery only");
+#endif
+
+  // 바이너리 적재가 RTC 메모리의 .bss를 덮으므로 설정/상태는 그 뒤에 씀
+  if (ulp_riscv_load_binary(ulp_main_bin_start, ulp_main_bin_end - ulp_main_bin_start) != ESP_OK) {
+    Serial.println("✗ ULP program load failed - pre-screening off");
+    return;
+  }
+  ulpScreenReset(ulp_state);
+  ulp_state->host_awake = 1;
+  ulp_config->battery_delta_raw = batteryVoltageToRaw(ULP_BATTERY_REF_V + NODE_ULP_BATTERY_DELTA_MV / 1000.0f) -
+                                  batteryVoltageToRaw(ULP_BATTERY_REF_V);
+  ulp_config->battery_low_raw = batteryVoltageToRaw(ULP_BATTERY_LOW_V);
+  ulp_config->pressure_delta_raw = pressure_delta;
+  ulp_config->heartbeat_cycles = NODE_ULP_HEARTBEAT_CYCLES;
+  ulp_bmp390_addr = pressure_delta ? ULP_BMP390_ADDRESS : 0;
+
+  ulp_set_wakeup_period(0, ULP_STARTUP_PERIOD_US);
+  if (ulp_riscv_run() != ESP_OK) {
+    Serial.println("✗ ULP start failed - pre-screening off");
+    return;
+  }
+  ulp_running = true;
+
+  char pressure[40] = "off";
+  if (pressure_delta) snprintf(pressure, sizeof(pressure), "±%dPa (%u counts)", NODE_ULP_PRESSURE_DELTA_PA, (unsigned)pressure_delta);
+  Serial.printf("✓ ULP pre-screening: battery ±%dmV (%u counts), low <%.2fV, pressure %s, heartbeat every %d cycles\n",
+                NODE_ULP_BATTERY_DELTA_MV, (unsigned)ulp_config->battery_delta_raw, ULP_BATTERY_LOW_V, pressure,
+                NODE_ULP_HEARTBEAT_CYCLES);
+}
+
+// 이번 주기 끝에 ULP에 맡겨도 되는지 (밀린 것이 있으면 평소 슬롯 주기로 계속 깨어남)
+bool ulpScreenReady() {
+  return ulp_running && lorawan_status == LORAWAN_CONNECTED && uplink_queue.count == 0 && !recoveryPending() &&
+         !transientBackoffActive();
+}
+
+// ULP가 깨울 때까지 Light Sleep (방금 보낸 측정이 다음 비교 기준)
+void sleepUntilUlpWake(uint16_t interval_s) {
+  ulp_set_wakeup_period(0, interval_s * 1000000ULL);
+  ulpScreenRebase(ulp_state);
+
+  uint32_t backstop_s = (uint32_t)(NODE_ULP_HEARTBEAT_CYCLES + 1) * interval_s;
+  Serial.printf("ULP screening: %u samples, %u wakes so far - sleeping until a change (max %us)\n",
+                (unsigned)ulp_state->samples, (unsigned)ulp_state->wakes, (unsigned)backstop_s);
+  Serial.flush();
+  displayOff();
+
+  esp_sleep_enable_ulp_wakeup();
+  esp_sleep_enable_timer_wakeup(backstop_s * 1000000ULL);
+  ulp_state->host_awake = 0;
+  esp_light_sleep_start();
+  ulp_state->host_awake = 1;
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ULP);   // 수신 윈도우/센서 대기 Light Sleep은 ULP가 깨우지 않게
+
+  bool by_ulp = esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_ULP;
+  ulp_wake_reason = by_ulp ? ulp_state->wake_reason : ULP_WAKE_HEARTBEAT;
+  Serial.println(String("Woke up by ") + (by_ulp ? "ULP" : "backstop timer") + " (" +
+                 ulpWakeReasonName(ulp_wake_reason) + ") - LoRaWAN session preserved!");
+}
+
+// 주기 끝 Light Sleep: ULP에 맡길 수 있으면 변화가 있을 때까지, 아니면 평소 슬롯
+// 부팅 직후 첫 주기는 슬롯에 맞춰 시작하지 않았으므로 한 번은 슬롯으로 잠 (ULP 타이머 위상 맞춤)
+void sleepUntilNextCycle(uint16_t interval_s) {
+  if (ulp_slot_aligned && ulpScreenReady()) {
+    sleepUntilUlpWake(interval_s);
+    return;
+  }
+  sleepUntilNextSlot(interval_s);
+  ulp_slot_aligned = true;
+  ulp_wake_reason = ULP_WAKE_NONE;
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef _ULP_SCREEN_H
+#define _ULP_SCREEN_H
+
+#include <stdint.h>
+
+// ============================================================================
+// ULP 사전 선별 판단 (NODE_ULP_SCREEN)
+//
+// 메인 CPU가 Light Sleep인 동안 ULP RISC-V가 주기마다 배터리 ADC(와 선택 Bosch 기압 센서)를 읽고
+// 마지막으로 보낸 값에서 임계값 이상 바뀌었거나 하트비트 주기가 차면 메인 CPU를 깨움
+// 같은 코드를 세 곳에서 씀 (순수 C, static inline):
+//  - LoRa_Node/ulp/main.c       : ULP RISC-V 프로그램 (RTC 메모리에 상태/기록)
+//  - ulp_monitor.h              : 메인 코어 (설정 기록, 깨어난 이유/기록 읽기)
+//  - LoRa_Simulator --ulp-screen: 호스트 모델 (합성 배터리/기압 신호로 깨어나는 횟수)
+// 단위는 ULP가 읽는 원시값 그대로 (ADC 카운트, BMP390 24비트 기압) - 변환은 메인 코어가 설정 시 한 번
+// ============================================================================
+
+#define ULP_HISTORY_SIZE 16             // RTC 메모리 기록 (원형 버퍼)
+
+#define ULP_WAKE_NONE 0
+#define ULP_WAKE_HEARTBEAT 1            // 변화 없이 heartbeat_cycles 주기 경과
+#define ULP_WAKE_BATTERY 2              // 배터리 전압 변화
+#define ULP_WAKE_PRESSURE 3             // 기압(고도) 변화
+#define ULP_WAKE_LOW_BATTERY 4          // 저전압 진입
+
+typedef struct {
+  uint32_t battery_raw;                 // ADC1_CH0 평균 (12비트)
+  uint32_t pressure_raw;                // BMP390 원시 기압 (0이면 센서 없음)
+} UlpSample;
+
+typedef struct {
+  uint32_t battery_delta_raw;           // 이만큼 바뀌면 깨움 (0: 끔)
+  uint32_t battery_low_raw;             // 이 아래로 내려가면 한 번 깨움 (0: 끔)
+  uint32_t pressure_delta_raw;          // 0: 끔
+  uint32_t heartbeat_cycles;            // 변화가 없어도 이 주기마다 깨움 (0: 안 깨움)
+} UlpScreenConfig;
+
+typedef struct {
+  UlpSample history[ULP_HISTORY_SIZE];
+  UlpSample sent;                       // 마지막으로 메인 CPU를 깨운 샘플 (비교 기준)
+  uint32_t head, count;                 // 다음 기록 위치, 기록 수
+  uint32_t cycles;                      // 마지막으로 깨운 뒤 주기 수
+  uint32_t samples, wakes;              // 누적 (진단용)
+  uint32_t wake_reason;                 // 마지막으로 깨운 이유
+  uint32_t low_reported;                // 저전압 알림을 이미 보냈는지
+  uint32_t host_awake;                  // 메인 CPU 동작 중 (기록만, 깨우지 않음)
+  uint32_t baseline_valid;
+} UlpScreenState;
+
+static inline uint32_t ulpAbsDiff(uint32_t a, uint32_t b) { return a > b ? a - b : b - a; }
+
+static inline void ulpScreenReset(UlpScreenState* s) {
+  uint8_t* p = (uint8_t*)s;
+  for (uint32_t i = 0; i < sizeof(*s); i++) p[i] = 0;
+}
+
+// 가장 최근 샘플 (기록이 없으면 0)
+static inline UlpSample ulpScreenLatest(const UlpScreenState* s) {
+  UlpSample zero = {0, 0};
+  if (s->count == 0) return zero;
+  return s->history[(s->head + ULP_HISTORY_SIZE - 1) % ULP_HISTORY_SIZE];
+}
+
+// 메인 CPU가 직접 전송한 뒤 기준을 최신 샘플로 (하트비트 주기도 처음부터)
+static inline void ulpScreenRebase(UlpScreenState* s) {
+  if (s->count == 0) return;
+  s->sent = ulpScreenLatest(s);
+  s->cycles = 0;
+  s->baseline_valid = 1;
+}
+
+// 샘플 하나 기록하고 메인 CPU를 깨울 이유를 돌려줌 (ULP_WAKE_NONE이면 계속 잠)
+static inline uint32_t ulpScreenStep(UlpScreenState* s, const UlpScreenConfig* c, const UlpSample* sample) {
+  s->history[s->head] = *sample;
+  s->head = (s->head + 1) % ULP_HISTORY_SIZE;
+  if (s->count < ULP_HISTORY_SIZE) s->count++;
+  s->samples++;
+  s->cycles++;
+
+  if (s->host_awake) return ULP_WAKE_NONE;
+  if (!s->baseline_valid) {
+    ulpScreenRebase(s);
+    return ULP_WAKE_NONE;
+  }
+
+  uint32_t reason = ULP_WAKE_NONE;
+  if (c->battery_low_raw && sample->battery_raw < c->battery_low_raw && !s->low_reported) {
+    reason = ULP_WAKE_LOW_BATTERY;
+    s->low_reported = 1;
+  } else if (c->pressure_delta_raw && sample->pressure_raw && s->sent.pressure_raw &&
+             ulpAbsDiff(sample->pressure_raw, s->sent.pressure_raw) >= c->pressure_delta_raw) {
+    reason = ULP_WAKE_PRESSURE;
+  } else if (c->battery_delta_raw && ulpAbsDiff(sample->battery_raw, s->sent.battery_raw) >= c->battery_delta_raw) {
+    reason = ULP_WAKE_BATTERY;
+  } else if (c->heartbeat_cycles && s->cycles >= c->heartbeat_cycles) {
+    reason = ULP_WAKE_HEARTBEAT;
+  }
+
+  // 충전 등으로 저전압에서 벗어나면 다시 알림
+  if (c->battery_low_raw && sample->battery_raw >= c->battery_low_raw + c->battery_delta_raw) s->low_reported = 0;
+
+  if (reason != ULP_WAKE_NONE) {
+    s->sent = *sample;
+    s->cycles = 0;
+    s->wakes++;
+    s->wake_reason = reason;
+  }
+  return reason;
+}
+
+static inline const char* ulpWakeReasonName(uint32_t reason) {
+  switch (reason) {
+    case ULP_WAKE_HEARTBEAT: return "heartbeat";
+    case ULP_WAKE_BATTERY: return "battery";
+    case ULP_WAKE_PRESSURE: return "pressure";
+    case ULP_WAKE_LOW_BATTERY: return "low battery";
+    default: return "none";
+  }
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef _UPLINK_QUEUE_H
+#define _UPLINK_QUEUE_H
+
+#include "frame_header.h"  // FPort 할당, 디스크립터 크기
+#include "delta_codec.h"   // 묶음 델타 압축
+
+// ============================================================================
+// 연결 끊김 동안의 측정값 보관 큐
+//
+// 네트워크에 연결되지 않았거나 전송에 실패한 측정값을 RAM 링 버퍼에 보관하고
+// (가득 차면 가장 오래된 것부터 덮어씀), 연결이 복구되면 정상 업링크 뒤에 주기마다 보냄:
+//  - 2개 이상이면 오래된 것부터 현재 DR 최대 크기에 들어가는 만큼 델타 압축해 FPort 4로
+//    (delta_codec.h, 시각 = 첫 샘플 측정 후 경과 초, 이후는 앞 샘플과의 간격)
+//  - 하나뿐이거나 묶을 수 없으면 FPort 2로: [측정 후 경과 시간(분) u16] + [디스크립터][측정 데이터]
+//
+// 전송은 정상 업링크와 같은 경로(sensor_node.h)로 하므로 링크 통계/시간 동기/실패 복구가 똑같이 적용됨
+// ============================================================================
+
+#define UPLINK_QUEUE_SIZE 16          // 보관할 최대 측정값 수
+#define UPLINK_QUEUE_MAX_PAYLOAD (FRAME_DESCRIPTOR_SIZE + 32) // 디스크립터 + 측정 데이터 최대 크기
+#define BACKLOG_HEADER_SIZE 2         // 경과 시간 헤더 크기
+#define BATCH_MAX_PAYLOAD 242         // 묶음 업링크 최대 크기 (KR920 DR4~5 한도)
+#define QUEUED_UPLINK_FRAME_SIZE (BATCH_MAX_PAYLOAD > BACKLOG_HEADER_SIZE + UPLINK_QUEUE_MAX_PAYLOAD \
+                                  ? BATCH_MAX_PAYLOAD : BACKLOG_HEADER_SIZE + UPLINK_QUEUE_MAX_PAYLOAD)
+#define BATCH_FOPTS_RESERVE 15        // 스택이 붙이는 MAC 명령(FOpts) 자리
+
+// 마지막 업링크 DR의 KR920 최대 페이로드에서 FOpts 자리를 뺀 묶음 크기 (DR을 모르면 DR0 기준)
+uint8_t batchPayloadLimit() {
+  static const uint8_t kr920_max_payload[LINK_MAX_DATARATE + 1] = {51, 51, 51, 115, 242, 242};
+  uint8_t dr = link_stats.datarate <= LINK_MAX_DATARATE ? link_stats.datarate : LINK_MIN_DATARATE;
+  return kr920_max_payload[dr] - BATCH_FOPTS_RESERVE;
+}
+
+struct QueuedUplink {
+  uint32_t captured_ms;                       // 측정 시각 (millis)
+  uint8_t len;
+  uint8_t payload[UPLINK_QUEUE_MAX_PAYLOAD];
+};
+
+struct UplinkQueue {
+  QueuedUplink items[UPLINK_QUEUE_SIZE];
+  uint8_t head;      // 가장 오래된 항목 위치
+  uint8_t count;
+  uint16_t dropped;  // 큐가 가득 차서 버려진 측정값 수
+};
+
+UplinkQueue uplink_queue = {};
+
+// 측정값 보관 (큐가 가득 차면 가장 오래된 것을 버림)
+void enqueueUplink(const uint8_t *payload, uint8_t len) {
+  if (len > UPLINK_QUEUE_MAX_PAYLOAD) return;
+
+  if (uplink_queue.count == UPLINK_QUEUE_SIZE) {
+    uplink_queue.head = (uplink_queue.head + 1) % UPLINK_QUEUE_SIZE;
+    uplink_queue.count--;
+    uplink_queue.dropped++;
+  }
+
+  QueuedUplink &item = uplink_queue.items[(uplink_queue.head + uplink_queue.count) % UPLINK_QUEUE_SIZE];
+  item.captured_ms = millis();
+  item.len = len;
+  memcpy(item.payload, payload, len);
+  uplink_queue.count++;
+
+  Serial.println("Reading queued for later (" + String(uplink_queue.count) + "/" + String(UPLINK_QUEUE_SIZE) +
+                 ", dropped: " + String(uplink_queue.dropped) + ")");
+}
+
+// 오래된 측정값부터 묶음(FPort 4) 또는 하나(FPort 2)로 프레임 구성 (큐는 그대로 둠)
+// u16_fields: 센서의 DELTA_U16_FIELDS (묶음 필드 경계)
+// 반환: 프레임에 담은 측정값 수 (큐가 비었으면 0) - 전송에 성공하면 dropQueuedUplinks()로 제거
+uint8_t buildQueuedUplink(uint8_t *frame, size_t &frameSize, uint8_t &fPort, uint32_t u16_fields) {
+  if (uplink_queue.count == 0) return 0;
+
+  uint8_t sent = 0;
+
+  const QueuedUplink &first = uplink_queue.items[uplink_queue.head];
+  uint32_t age_s = (millis() - first.captured_ms) / 1000UL;
+
+  DeltaBlock batch;
+  deltaBegin(batch, frame, batchPayloadLimit(), u16_fields);
+  while (sent < uplink_queue.count) {
+    const QueuedUplink &item = uplink_queue.items[(uplink_queue.head + sent) % UPLINK_QUEUE_SIZE];
+    if (!deltaAdd(batch, item.payload, item.len, age_s + (item.captured_ms - first.captured_ms) / 1000UL)) break;
+    sent++;
+  }
+
+  if (sent >= 2) {
+    frameSize = batch.len;
+    fPort = BATCH_FPORT;
+    Serial.println("Sending " + String(sent) + " queued readings as batch (" + String(frameSize) + " bytes, " +
+                   String(sent * first.len) + " raw, " + String(uplink_queue.count - sent) + " more queued)...");
+  } else {
+    sent = 1;
+    uint32_t age_min = age_s / 60;
+    if (age_min > 0xFFFF) age_min = 0xFFFF;
+    frame[0] = age_min >> 8;
+    frame[1] = age_min & 0xFF;
+    memcpy(frame + BACKLOG_HEADER_SIZE, first.payload, first.len);
+    frameSize = BACKLOG_HEADER_SIZE + first.len;
+    fPort = BACKLOG_FPORT;
+    Serial.println("Sending queued reading (" + String(age_min) + " min old, " +
+                   String(uplink_queue.count - 1) + " more queued)...");
+  }
+  return sent;
+}
+
+// 전송에 성공한 측정값을 큐 앞에서 제거
+void dropQueuedUplinks(uint8_t sent) {
+  if (sent > uplink_queue.count) sent = uplink_queue.count;
+  uplink_queue.head = (uplink_queue.head + sent) % UPLINK_QUEUE_SIZE;
+  uplink_queue.count -= sent;
+}
+
+#endif
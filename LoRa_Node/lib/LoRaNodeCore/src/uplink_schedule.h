@@ -0,0 +1,72 @@
+#ifndef _UPLINK_SCHEDULE_H
+#define _UPLINK_SCHEDULE_H
+
+#include <stdint.h>
+
+// ============================================================================
+// 업링크 주기 스케줄 (Arduino 의존성 없음, LoRa_Simulator가 그대로 링크함)
+//
+// 주기마다 "끝난 시각 + 남은 시간"만큼 자면 정전 복구처럼 동시에 켜진 노드들이 계속 같은 순간에
+// 전송해 매번 충돌하므로, 주기를 슬롯 격자에 맞춤:
+//  - 슬롯 = 시계 기준 offset + k x 주기, offset은 DevEUI 해시로 정해 장치마다 다르고 재부팅해도 같음
+//  - 슬롯마다 0~UPLINK_SLOT_JITTER_MS 무작위 지연 (해시가 가까운 두 장치도 매번 겹치지 않게, 누적 안 됨)
+//  - 시계: 네트워크 시각을 알면 그 기준(노드 간 정렬, 타이머 오차 누적 없음), 모르면 부팅 후 시간
+//    (동시 부팅이면 부팅 시각이 같으므로 offset만으로 흩어짐)
+// 측정이 길어 이번 슬롯을 놓치면 다음 슬롯으로 넘어감
+// ============================================================================
+
+#define UPLINK_SLOT_JITTER_MS 2000UL     // 슬롯당 최대 무작위 지연
+#define UPLINK_SLOT_JITTER_DIV 10        // 주기의 1/10을 넘지 않음
+#define UPLINK_SLOT_MIN_SLEEP_MS 1000UL  // 이보다 가까운 슬롯은 건너뜀
+
+// 네트워크 시각 (ms) - 로컬 시계 차이, 동기화 전에는 부팅 후 시간을 그대로 씀
+bool uplink_clock_synced = false;
+int64_t uplink_clock_offset_ms = 0;
+
+// 네트워크 시각 기준 설정 (network_ms 시점의 로컬 시계가 local_ms)
+void setUplinkNetworkTime(uint64_t network_ms, uint64_t local_ms) {
+  uplink_clock_offset_ms = (int64_t)(network_ms - local_ms);
+  uplink_clock_synced = true;
+}
+
+// 슬롯 계산에 쓰는 시각 (ms)
+uint64_t uplinkSlotClockMs(uint64_t local_ms) {
+  return uplink_clock_synced ? local_ms + uplink_clock_offset_ms : local_ms;
+}
+
+// DevEUI → 32비트 해시 (splitmix64 마무리 단계, 연속 발급된 EUI도 고르게 흩어짐)
+uint32_t uplinkSlotHash(uint64_t dev_eui) {
+  uint64_t z = dev_eui + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return (uint32_t)((z ^ (z >> 31)) >> 32);
+}
+
+// 주기 안에서 이 장치의 슬롯 위치 (ms)
+uint32_t uplinkSlotOffsetMs(uint64_t dev_eui, uint16_t interval_s) {
+  return uplinkSlotHash(dev_eui) % (interval_s * 1000UL);
+}
+
+// 무작위 지연 상한 (ms)
+uint32_t uplinkSlotJitterMaxMs(uint16_t interval_s) {
+  uint32_t limit = interval_s * 1000UL / UPLINK_SLOT_JITTER_DIV;
+  return limit < UPLINK_SLOT_JITTER_MS ? limit : UPLINK_SLOT_JITTER_MS;
+}
+
+// 다음 슬롯 + jitter_ms까지 잘 시간 (ms, now_ms는 uplinkSlotClockMs() 값)
+uint32_t uplinkSlotSleepMs(uint64_t now_ms, uint64_t dev_eui, uint16_t interval_s, uint32_t jitter_ms) {
+  uint64_t period = interval_s * 1000ULL;
+  uint64_t offset = uplinkSlotOffsetMs(dev_eui, interval_s);
+  uint64_t earliest = now_ms + UPLINK_SLOT_MIN_SLEEP_MS;
+  uint64_t slot = earliest <= offset ? offset : offset + (earliest - offset + period - 1) / period * period;
+  return (uint32_t)(slot - now_ms) + jitter_ms;
+}
+
+// 고정 주기 방식 (슬롯 이전): 이번 주기에 쓴 시간을 빼고 남은 시간 (초, 최소 1초)
+// LoRa_Simulator --no-slots 비교용
+uint32_t uplinkSleepSeconds(uint32_t elapsed_ms, uint16_t interval_s) {
+  uint32_t elapsed_s = elapsed_ms / 1000;
+  return elapsed_s + 1 < interval_s ? interval_s - elapsed_s : 1;
+}
+
+#endif
@@ -0,0 +1,348 @@
+#ifndef _WIFI_BACKHAUL_H
+#define _WIFI_BACKHAUL_H
+
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include <Preferences.h>
+#include "node_link.h"
+#include "uplink_queue.h"
+#include "network_time.h"
+#ifdef NODE_HISTORY
+#include "history_log.h"
+#endif
+
+// ============================================================================
+// Wi-Fi/MQTT 백홀: 밀린 측정값을 LoRa 대신 한꺼번에 비움 (NODE_WIFI_BACKHAUL)
+//
+// LoRa로는 주기마다 묶음 하나씩이라 하루치 밀린 측정값을 보내는 데 며칠이 걸림. 큐에
+// NODE_WIFI_MIN_BACKLOG개 이상 쌓이면 (NODE_WIFI_RETRY_S에 한 번) 설정한 AP만 골라 스캔하고,
+// 보이면 연결 → MQTT로 묶음을 연달아 발행 → Wi-Fi를 끔 (연결 중에만 Wi-Fi 전류)
+//  - 메시지: 토픽 NODE_MQTT_TOPIC/<DevEUI 16진수>/backlog, [메시지 번호 u16][[길이 u16][델타 묶음]...]
+//    묶음 형식은 플래시 기록 파일과 같음 (LoRa_Decoder nextHistoryBlock(), decodeDeltaBlock()으로 해석)
+//  - NODE_HISTORY: 마지막으로 보낸 뒤의 플래시 기록 전부 (RAM 큐를 넘쳐 버려진 것 포함) → RAM 큐는 비움
+//    보낸 위치는 NVS에 (파일 첫 바이트로 /history.old 교체를 알아봄, 재시작에도 이어서)
+//  - 기록이 없으면 RAM 큐를 묶음으로 (시각 = networkTimeSeconds() 기준 측정 시각)
+//  - 전달 확인: PubSubClient는 QoS 0 발행만 되므로 자기 토픽을 구독해 브로커가 되돌려준 메시지
+//    번호/길이로 확인 (한 번에 하나, NODE_MQTT_ACK_MS 안에 안 오면 새 번호로 NODE_MQTT_RETRIES번 재발행)
+//    확인된 것만 기록 위치/큐에서 지우므로 도중에 끊겨도 남은 것은 다음 시도나 LoRa로 감
+//  - 같은 측정값이 LoRa와 Wi-Fi로 모두 갈 수 있음 (서버는 측정 번호로 중복 제거)
+//
+// 빌드: NODE_WIFI_SSID, NODE_WIFI_PASS, NODE_MQTT_HOST를 build_flags에 (문자열, \"...\")
+// ============================================================================
+
+#ifndef NODE_WIFI_SSID
+#error "NODE_WIFI_BACKHAUL needs NODE_WIFI_SSID/NODE_WIFI_PASS/NODE_MQTT_HOST in build_flags"
+#endif
+
+#ifndef NODE_WIFI_PASS
+#define NODE_WIFI_PASS ""
+#endif
+
+#ifndef NODE_MQTT_HOST
+#error "NODE_WIFI_BACKHAUL needs NODE_MQTT_HOST (broker address) in build_flags"
+#endif
+
+#ifndef NODE_MQTT_PORT
+#define NODE_MQTT_PORT 1883
+#endif
+
+#ifndef NODE_MQTT_TOPIC
+#define NODE_MQTT_TOPIC "lora-node"
+#endif
+
+#ifndef NODE_WIFI_MIN_BACKLOG
+#define NODE_WIFI_MIN_BACKLOG 8          // 이만큼 밀리면 Wi-Fi 시도
+#endif
+
+#ifndef NODE_WIFI_RETRY_S
+#define NODE_WIFI_RETRY_S 900            // 시도 간격 (AP가 없을 때 스캔 전류 제한)
+#endif
+
+#ifndef NODE_MQTT_BATCH_BYTES
+#define NODE_MQTT_BATCH_BYTES 2048       // 메시지 하나 최대 크기 (기록 묶음 약 4개)
+#endif
+
+#ifndef NODE_MQTT_ACK_MS
+#define NODE_MQTT_ACK_MS 2000
+#endif
+
+#ifndef NODE_MQTT_RETRIES
+#define NODE_MQTT_RETRIES 3
+#endif
+
+#define WIFI_SCAN_MS_PER_CHANNEL 120     // 능동 스캔, 13채널 약 1.6초
+#define WIFI_CONNECT_TIMEOUT_MS 8000     // 연결 + DHCP
+#define WIFI_POLL_MS 10
+#define WIFI_BATCH_HEADER_SIZE 2         // [메시지 번호 u16]
+#define WIFI_MQTT_OVERHEAD 96            // PubSubClient 버퍼의 고정 헤더 + 토픽 자리
+#define WIFI_FINGERPRINT_SIZE 8          // 기록 파일 첫 바이트 (첫 묶음 헤더 + 시각)
+
+struct WifiBackhaulStats {
+  uint32_t attempts;        // 스캔 횟수
+  uint32_t sessions;        // MQTT 연결까지 된 횟수
+  uint32_t published;       // 발행한 메시지 (재발행 포함)
+  uint32_t acked;           // 브로커가 되돌려 확인된 메시지
+  uint32_t retries;
+  uint32_t readings;        // 확인된 메시지에 담긴 측정값 수
+  uint32_t bytes;           // 확인된 페이로드 바이트
+  uint32_t last_attempt_ms;
+};
+
+// 보낸 기록 위치 (NVS "backhaul"/"cursor")
+struct WifiHistoryCursor {
+  uint8_t fingerprint[WIFI_FINGERPRINT_SIZE];   // 보내던 파일의 첫 바이트
+  uint32_t offset;                              // 그 파일에서 보낸 데까지
+};
+
+WifiBackhaulStats wifi_backhaul = {};
+WiFiClient wifi_client;
+PubSubClient mqtt(wifi_client);
+
+static char wifi_topic[64];
+static char wifi_client_id[24];
+static uint16_t wifi_next_seq = 0;
+static bool wifi_ack_pending = false;
+static uint16_t wifi_ack_seq = 0;
+static size_t wifi_ack_len = 0;
+
+// 자기 토픽으로 되돌아온 메시지 = 브로커가 받은 것
+static void onBackhaulEcho(char* topic, uint8_t* payload, unsigned int len) {
+  if (!wifi_ack_pending || len != wifi_ack_len || strcmp(topic, wifi_topic) != 0) return;
+  if ((uint16_t)(payload[0] << 8 | payload[1]) == wifi_ack_seq) wifi_ack_pending = false;
+}
+
+static bool connectWifi() {
+  WiFi.mode(WIFI_STA);
+  int16_t found = WiFi.scanNetworks(false, false, false, WIFI_SCAN_MS_PER_CHANNEL, 0, NODE_WIFI_SSID);
+  int32_t rssi = found > 0 ? WiFi.RSSI(0) : 0;
+  WiFi.scanDelete();
+  if (found <= 0) {
+    Serial.println("Wi-Fi backhaul: " NODE_WIFI_SSID " not in range");
+    return false;
+  }
+
+  uint32_t start = millis();
+  WiFi.begin(NODE_WIFI_SSID, NODE_WIFI_PASS);
+  while (WiFi.status() != WL_CONNECTED) {
+    if (millis() - start >= WIFI_CONNECT_TIMEOUT_MS) {
+      Serial.printf("✗ Wi-Fi connect to " NODE_WIFI_SSID " timed out (status %d)\n", (int)WiFi.status());
+      return false;
+    }
+    delay(WIFI_POLL_MS);
+  }
+  Serial.printf("✓ Wi-Fi connected to " NODE_WIFI_SSID " (%d dBm) in %lums\n", (int)rssi,
+                (unsigned long)(millis() - start));
+  return true;
+}
+
+static bool connectMqtt() {
+  if (!wifi_topic[0]) {
+    snprintf(wifi_client_id, sizeof(wifi_client_id), "lora-%08lX%08lX", (unsigned long)(devEUI >> 32),
+             (unsigned long)(devEUI & 0xFFFFFFFF));
+    snprintf(wifi_topic, sizeof(wifi_topic), NODE_MQTT_TOPIC "/%s/backlog", wifi_client_id + 5);
+    wifi_next_seq = (uint16_t)esp_random();   // 재시작 전 메시지의 늦은 되돌림과 겹치지 않게
+  }
+  mqtt.setServer(NODE_MQTT_HOST, NODE_MQTT_PORT);
+  mqtt.setCallback(onBackhaulEcho);
+  if (!mqtt.setBufferSize(NODE_MQTT_BATCH_BYTES + WIFI_MQTT_OVERHEAD)) {
+    Serial.println("✗ MQTT buffer allocation failed");
+    return false;
+  }
+  if (!mqtt.connect(wifi_client_id) || !mqtt.subscribe(wifi_topic)) {
+    Serial.printf("✗ MQTT connect to %s:%d failed (state %d)\n", NODE_MQTT_HOST, NODE_MQTT_PORT, mqtt.state());
+    return false;
+  }
+  return true;
+}
+
+static void shutdownWifi() {
+  if (mqtt.connected()) mqtt.disconnect();
+  WiFi.disconnect(true);
+  WiFi.mode(WIFI_OFF);
+}
+
+// msg[0..len) 발행 후 되돌림을 기다림 (끊기면 다시 연결, 재발행마다 새 번호)
+static bool publishBatch(uint8_t* msg, size_t len) {
+  for (uint8_t attempt = 0; attempt <= NODE_MQTT_RETRIES; attempt++) {
+    if (attempt) wifi_backhaul.retries++;
+    if (!mqtt.connected() && !connectMqtt()) continue;
+
+    wifi_ack_seq = wifi_next_seq++;
+    wifi_ack_len = len;
+    wifi_ack_pending = true;
+    msg[0] = wifi_ack_seq >> 8;
+    msg[1] = wifi_ack_seq & 0xFF;
+    if (!mqtt.publish(wifi_topic, msg, len)) continue;
+    wifi_backhaul.published++;
+
+    uint32_t start = millis();
+    while (wifi_ack_pending && millis() - start < NODE_MQTT_ACK_MS && mqtt.loop()) delay(WIFI_POLL_MS);
+    if (!wifi_ack_pending) {
+      wifi_backhaul.acked++;
+      wifi_backhaul.bytes += len;
+      return true;
+    }
+  }
+  wifi_ack_pending = false;
+  return false;
+}
+
+#ifdef NODE_HISTORY
+static bool readFingerprint(const char* path, uint8_t* out) {
+  File file = LittleFS.open(path, "r");
+  if (!file) return false;
+  bool ok = file.read(out, WIFI_FINGERPRINT_SIZE) == WIFI_FINGERPRINT_SIZE;
+  file.close();
+  return ok;
+}
+
+// offset부터 [길이][묶음] 레코드를 out에 capacity까지 (offset은 다음 레코드로, 깨진 레코드면 파일 끝으로)
+static size_t readHistoryRecords(File &file, uint32_t &offset, uint8_t* out, size_t capacity, uint32_t &readings) {
+  size_t n = 0;
+  size_t size = file.size();
+  while (offset + 2 <= size && file.seek(offset)) {
+    uint8_t* record = out + n;
+    if (n + 2 > capacity || file.read(record, 2) != 2) break;
+    size_t len = (size_t)record[0] << 8 | record[1];
+    if (len <= DELTA_HEADER_SIZE || len > HISTORY_BLOCK_SIZE || offset + 2 + len > size) {
+      Serial.printf("⚠ Wi-Fi backhaul: bad history record at %lu - skipped to end\n", (unsigned long)offset);
+      offset = size;
+      break;
+    }
+    if (n + 2 + len > capacity || file.read(record + 2, len) != len) break;
+    readings += record[3];   // [디스크립터][샘플 수]
+    n += 2 + len;
+    offset += 2 + len;
+  }
+  return n;
+}
+
+static void saveCursor(const WifiHistoryCursor &cursor) {
+  Preferences prefs;
+  if (!prefs.begin("backhaul", false)) return;
+  prefs.putBytes("cursor", &cursor, sizeof(cursor));
+  prefs.end();
+}
+
+// path의 남은 레코드를 메시지로 (cursor가 다른 파일을 가리키면 처음부터)
+static bool drainHistoryFile(const char* path, WifiHistoryCursor &cursor, uint8_t* msg) {
+  uint8_t fingerprint[WIFI_FINGERPRINT_SIZE];
+  if (!readFingerprint(path, fingerprint)) return true;   // 없거나 묶음도 안 되는 크기
+  if (memcmp(fingerprint, cursor.fingerprint, WIFI_FINGERPRINT_SIZE) != 0) {
+    memcpy(cursor.fingerprint, fingerprint, WIFI_FINGERPRINT_SIZE);
+    cursor.offset = 0;
+  }
+
+  File file = LittleFS.open(path, "r");
+  if (!file) return false;
+  bool ok = true;
+  while (ok) {
+    uint32_t next = cursor.offset;
+    uint32_t readings = 0;
+    size_t n = readHistoryRecords(file, next, msg + WIFI_BATCH_HEADER_SIZE,
+                                  NODE_MQTT_BATCH_BYTES - WIFI_BATCH_HEADER_SIZE, readings);
+    if (n == 0) {
+      cursor.offset = next;
+      break;
+    }
+    ok = publishBatch(msg, WIFI_BATCH_HEADER_SIZE + n);
+    if (ok) {
+      cursor.offset = next;
+      wifi_backhaul.readings += readings;
+      saveCursor(cursor);
+    }
+  }
+  file.close();
+  return ok;
+}
+
+// 마지막으로 보낸 뒤의 플래시 기록 전부 (교체됐으면 /history.old 나머지부터)
+static bool drainHistory(uint8_t* msg) {
+  flushHistory();   // RAM 묶음도 파일로 (RAM 큐의 측정값이 모두 파일에 있게)
+
+  WifiHistoryCursor cursor = {};
+  Preferences prefs;
+  if (prefs.begin("backhaul", true)) {
+    if (prefs.getBytesLength("cursor") == sizeof(cursor)) prefs.getBytes("cursor", &cursor, sizeof(cursor));
+    prefs.end();
+  }
+
+  uint8_t current[WIFI_FINGERPRINT_SIZE];
+  bool in_current = readFingerprint(HISTORY_PATH, current) &&
+                    memcmp(current, cursor.fingerprint, WIFI_FINGERPRINT_SIZE) == 0;
+  if (!in_current && !drainHistoryFile(HISTORY_OLD_PATH, cursor, msg)) return false;
+  if (!drainHistoryFile(HISTORY_PATH, cursor, msg)) return false;
+
+  uplink_queue.head = 0;
+  uplink_queue.count = 0;
+  return true;
+}
+#endif
+
+// RAM 큐 전체를 메시지 하나로 (큐는 UPLINK_QUEUE_SIZE개라 묶음 한두 개)
+static bool drainQueue(uint8_t* msg, uint32_t u16_fields) {
+  uint8_t* out = msg + WIFI_BATCH_HEADER_SIZE;
+  const size_t capacity = NODE_MQTT_BATCH_BYTES - WIFI_BATCH_HEADER_SIZE;
+  size_t n = 0;
+  uint8_t taken = 0;
+  uint32_t readings = 0;
+  uint32_t now_s = networkTimeSeconds();
+  uint32_t now_ms = millis();
+
+  while (taken < uplink_queue.count && n + 2 + DELTA_HEADER_SIZE + DELTA_MAX_SAMPLE <= capacity) {
+    DeltaBlock block;
+    uint16_t room = capacity - n - 2 < 0xFFFF ? capacity - n - 2 : 0xFFFF;
+    deltaBegin(block, out + n + 2, room, u16_fields);
+    while (taken < uplink_queue.count) {
+      const QueuedUplink &item = uplink_queue.items[(uplink_queue.head + taken) % UPLINK_QUEUE_SIZE];
+      if (!deltaAdd(block, item.payload, item.len, now_s - (now_ms - item.captured_ms) / 1000UL)) break;
+      taken++;
+    }
+    if (block.count == 0) break;
+    out[n] = block.len >> 8;
+    out[n + 1] = block.len & 0xFF;
+    n += 2 + block.len;
+    readings += block.count;
+  }
+  if (taken == 0 || !publishBatch(msg, WIFI_BATCH_HEADER_SIZE + n)) return false;
+
+  uplink_queue.head = (uplink_queue.head + taken) % UPLINK_QUEUE_SIZE;
+  uplink_queue.count -= taken;
+  wifi_backhaul.readings += readings;
+  return true;
+}
+
+// 주기마다 전송/보관 뒤에 호출: 밀린 것이 충분하고 AP가 보이면 비우고 Wi-Fi를 끔
+// u16_fields: 센서의 DELTA_U16_FIELDS (RAM 큐를 묶을 때)
+void drainBacklogViaWifi(uint32_t u16_fields) {
+  if (uplink_queue.count < NODE_WIFI_MIN_BACKLOG) return;
+  if (wifi_backhaul.attempts && millis() - wifi_backhaul.last_attempt_ms < NODE_WIFI_RETRY_S * 1000UL) return;
+  wifi_backhaul.attempts++;
+  wifi_backhaul.last_attempt_ms = millis();
+
+  static uint8_t msg[NODE_MQTT_BATCH_BYTES];
+  uint32_t start = millis();
+  uint32_t readings = wifi_backhaul.readings, acked = wifi_backhaul.acked, bytes = wifi_backhaul.bytes;
+  Serial.println("Wi-Fi backhaul: " + String(uplink_queue.count) + " readings queued - looking for " NODE_WIFI_SSID);
+
+  bool session = connectWifi() && connectMqtt();
+  bool drained = false;
+  if (session) {
+    wifi_backhaul.sessions++;
+#ifdef NODE_HISTORY
+    drained = history_ready ? drainHistory(msg) : drainQueue(msg, u16_fields);
+#else
+    drained = drainQueue(msg, u16_fields);
+#endif
+  }
+  shutdownWifi();
+  if (!session) return;
+
+  // 못 비운 것은 큐/기록 위치에 그대로 남아 다음 시도나 LoRa로 감
+  Serial.printf("%s Wi-Fi backhaul: %lu readings in %lu messages (%lu bytes) in %lums, %u still queued\n",
+                drained ? "✓" : "✗", (unsigned long)(wifi_backhaul.readings - readings),
+                (unsigned long)(wifi_backhaul.acked - acked), (unsigned long)(wifi_backhaul.bytes - bytes),
+                (unsigned long)(millis() - start), uplink_queue.count);
+}
+
+#endif
@@ -0,0 +1,36 @@
+// ============================================================================
+// LoRaWAN 센서 노드 (Heltec WiFi LoRa 32 V3)
+//
+// 센서 종류는 platformio.ini의 빌드 환경으로 선택 (선택되지 않은 드라이버는 링크되지 않음)
+//  - stair / stair_battery : BME280 + BMP390 계단 센서 (NODE_SENSOR_STAIR)
+//  - am1008w_i2c           : AM1008W-K-P I2C (NODE_SENSOR_AM1008W_I2C)
+//  - am1008w_uart          : AM1008W-K-P UART (NODE_SENSOR_AM1008W_UART)
+//  - air_station           : AM1008W-K-P + BME280 + BMP390 한 I2C 버스 (NODE_SENSOR_AIR_STATION)
+// 공통 로직은 lib/LoRaNodeCore 참고
+// ============================================================================
+
+#include "sensor_node.h"
+
+#if defined(NODE_SENSOR_STAIR)
+#include "stair_sensors.h"
+typedef SensorNode<StairSensors> Node;
+#elif defined(NODE_SENSOR_AM1008W_I2C)
+#include "am1008w_i2c_bus.h"
+typedef SensorNode<Am1008w<Am1008I2cBus> > Node;
+#elif defined(NODE_SENSOR_AM1008W_UART)
+#include "am1008w_uart_bus.h"
+typedef SensorNode<Am1008w<Am1008UartBus> > Node;
+#elif defined(NODE_SENSOR_AIR_STATION)
+#include "air_station.h"
+typedef SensorNode<AirStation> Node;
+#else
+#error "No sensor selected - build one of the environments in platformio.ini"
+#endif
+
+void setup() {
+  Node::setup();
+}
+
+void loop() {
+  Node::loop();
+}
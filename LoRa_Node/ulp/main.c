@@ -0,0 +1,55 @@
+// ============================================================================
+// ULP RISC-V 사전 선별 프로그램 (stair_battery_ulp 환경, src/CMakeLists.txt의 ulp_embed_binary로 빌드)
+//
+// ULP 타이머(업링크 주기)마다 한 번 실행되고 main()이 끝나면 다음 타이머까지 멈춤
+//  1. 배터리: ADC1_CH0(GPIO1) ULP_ADC_SAMPLES번 평균 (ADC_CTL=GPIO37은 RTC 핀이 아니라 메인 코어가 HIGH로 유지)
+//  2. 기압 (bmp390_addr != 0): RTC I2C(SDA GPIO3, SCL GPIO2)의 BMP390을 강제 측정 모드로 한 번 변환
+//  3. ulp_screen.h 판단 → 이유가 있으면 메인 CPU를 깨움
+// 변수는 메인 코어에서 ulp_ 접두어 심볼로 보임 (ulp_monitor.h)
+// ============================================================================
+
+#include <stdint.h>
+#include "ulp_riscv_utils.h"
+#include "ulp_riscv_adc_ulp_core.h"
+#include "ulp_riscv_i2c_ulp_core.h"
+#include "../lib/LoRaNodeCore/src/ulp_screen.h"
+
+#define ULP_ADC_SAMPLES 16
+#define ULP_BMP390_REG_DATA 0x04
+#define ULP_BMP390_REG_PWR_CTRL 0x1B
+#define ULP_BMP390_PWR_FORCED 0x13
+#define ULP_BMP390_MEASURE_MS 26
+
+UlpScreenConfig screen_config;
+UlpScreenState screen_state;
+uint32_t bmp390_addr;           // 0이면 기압 센서 없음 (메인 코어가 확인 후 기록)
+
+static uint32_t readPressureRaw(void) {
+  uint8_t cmd = ULP_BMP390_PWR_FORCED;
+  uint8_t raw[3];
+
+  ulp_riscv_i2c_master_set_slave_addr((uint8_t)bmp390_addr);
+  ulp_riscv_i2c_master_set_slave_reg_addr(ULP_BMP390_REG_PWR_CTRL);
+  ulp_riscv_i2c_master_write_to_device(&cmd, 1);
+  ulp_riscv_delay_cycles(ULP_BMP390_MEASURE_MS * ULP_RISCV_CYCLES_PER_MS);
+
+  ulp_riscv_i2c_master_set_slave_reg_addr(ULP_BMP390_REG_DATA);
+  ulp_riscv_i2c_master_read_from_device(raw, sizeof(raw));
+  return (uint32_t)raw[2] << 16 | (uint32_t)raw[1] << 8 | raw[0];
+}
+
+int main(void) {
+  UlpSample sample;
+
+  uint32_t total = 0;
+  for (int i = 0; i < ULP_ADC_SAMPLES; i++) {
+    total += (uint32_t)ulp_riscv_adc_read_channel(ADC_UNIT_1, ADC_CHANNEL_0);
+  }
+  sample.battery_raw = total / ULP_ADC_SAMPLES;
+  sample.pressure_raw = bmp390_addr ? readPressureRaw() : 0;
+
+  if (ulpScreenStep(&screen_state, &screen_config, &sample) != ULP_WAKE_NONE) {
+    ulp_riscv_wakeup_main_processor();
+  }
+  return 0;
+}
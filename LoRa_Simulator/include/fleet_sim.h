@@ -0,0 +1,512 @@
+#ifndef _FLEET_SIM_H
+#define _FLEET_SIM_H
+
+#include <deque>
+#include <queue>
+#include <vector>
+
+#include "sim_arduino.h"        // join_backoff.h보다 먼저 (millis/random/min 대체)
+#include "join_backoff.h"       // 펌웨어 재조인 백오프
+#include "uplink_schedule.h"    // 펌웨어 업링크 슬롯 스케줄
+#include "frame_header.h"       // 디스크립터 크기
+#include "payload_decoder.h"    // 센서별 프레임 크기 (LoRa_Decoder 필드 표)
+#include "lora_airtime.h"
+#include "ulp_screen.h"         // 펌웨어 ULP 사전 선별 판단 (--ulp-screen)
+
+// ============================================================================
+// 노드 군집 이산 사건 시뮬레이션
+//
+// 노드마다 펌웨어와 같은 순서로 움직임:
+//   부팅 → setup() → OTAA 조인 (실패 시 펌웨어처럼 join_backoff.h 백오프로 재시도)
+//   → loop(): 측정 → 업링크 → RX1/RX2 → 화면 표시 → 다음 슬롯까지 Light Sleep (uplinkSlotSleepMs())
+// Light Sleep 타이머는 노드마다 ±drift_ppm 오차 (RTC 슬로 클록)
+// 슬롯 시계는 부팅 후 시간(노드 시계, 오차 포함) 또는 --network-time이면 오차 없는 공통 시각
+// --no-slots는 슬롯 이전 고정 주기 방식(uplinkSleepSeconds())
+// DevEUI는 실제 발급처럼 연속 번호 (SIM_DEV_EUI_BASE + 노드 번호)
+// --ulp-screen: 조인 후 첫 슬롯 주기부터 ULP가 주기마다 합성 배터리/기압 신호를 ulp_screen.h로 판단해
+//   변화나 하트비트가 있을 때만 loop()를 돌리고 (ULP 타이머 주기, 슬롯 재계산 없음) 나머지 주기는 샘플 비용만 씀
+//   배터리: 남은 용량에 비례하는 3.3~4.2V + 잡음, 기압: 날씨 랜덤 워크 + 시간당 ulp_events회 계단식 변화 + 잡음
+//
+// 무선 모델:
+//  - 노드/게이트웨이는 반경 radius_m 원 안에 무작위 배치, 경로 손실 128.1 + 37.6 log10(d km) + 고정 음영(정규분포)
+//  - DR은 ADR이 수렴했다고 보고, 가장 잘 들리는 게이트웨이에서 adr_margin_db 여유를 남기는 가장 빠른 DR
+//  - 채널은 업링크마다 무작위 (KR920 기본 3채널)
+//  - 게이트웨이별 수신: 감도 이상 + 같은 채널·같은 SF로 겹친 전송보다 capture_db 이상 세야 살아남음
+//    (SF가 다르면 직교로 봄) + 동시 복조 경로 SIM_GATEWAY_PATHS개 + 게이트웨이 송신 중에는 못 받음
+//  - 하나라도 받은 게이트웨이가 있으면 전달 성공
+//  - 다운링크: 조인 승인(5초 후 RX1), LinkCheckAns(LINK_CHECK_INTERVAL 업링크마다, 1초 후 RX1)
+//    가장 세게 받은 게이트웨이가 보내며 그 게이트웨이가 이미 송신 중이면 못 보냄
+// ============================================================================
+
+#define SIM_MAX_GATEWAYS 16
+#define SIM_GATEWAY_PATHS 8             // SX1302 동시 복조 경로
+#define SIM_CAPTURE_DB 6.0              // 같은 SF 간섭을 이기는 전력 차
+#define SIM_TX_POWER_DBM 14.0           // DEFAULT_TX_POWER_DBM (node_state.h)
+#define SIM_JOIN_ACCEPT_DELAY_MS 5000.0 // JOIN_ACCEPT_DELAY1
+#define SIM_RX1_DELAY_MS 1000.0         // RECEIVE_DELAY1
+#define SIM_RX2_DELAY_MS 2000.0
+#define SIM_LINK_CHECK_INTERVAL 10      // LINK_CHECK_INTERVAL (link_quality.h, RadioLib 의존이라 값만 옮김)
+#define SIM_REJOIN_DELAY_S 30           // REJOIN_DELAY_MS / 1000 (node_state.h)
+#define SIM_DISPLAY_HOLD_MS 5000.0      // DISPLAY_HOLD_SECONDS (node_state.h)
+#define SIM_DEV_EUI_BASE 0x70B3D57ED0060000ULL
+
+// setup() 소요 시간: Serial 대기 2초 + 센서 초기화 후 1초 + 라디오 리셋 약 0.4초
+#define SIM_SETUP_MS 3500.0
+#define SIM_JOINED_HOLD_MS 2000.0       // 조인 성공 화면 후 delay(2000)
+#define SIM_LOOP_OVERHEAD_MS 150.0      // 시리얼 출력, 화면 갱신, 라디오 사전 점검
+#define SIM_WAKE_MS 5.0                 // Light Sleep 복귀
+
+// 평균 전류 (mA, 3.7V 배터리 기준 대략 값 - 실측값으로 바꿔 쓸 것)
+#define SIM_SLEEP_MA 2.0                // Light Sleep (ESP32-S3 + SX1262 대기 + 레귤레이터)
+#define SIM_ACTIVE_MA 35.0              // CPU 80~240MHz 동작
+#define SIM_DISPLAY_MA 50.0             // 화면 표시 중 (OLED + CPU delay)
+#define SIM_TX_MA 120.0                 // 14dBm 송신
+#define SIM_RX_MA 15.0                  // 수신 윈도우 (CPU Light Sleep)
+#define SIM_ULP_MA 0.3                  // ULP RISC-V 동작 중 추가 전류
+#define SIM_ULP_SAMPLE_MS 1.0           // ADC 16회 평균
+#define SIM_ULP_BMP390_MS 30.0          // + 선별용 BMP390 강제 측정 (변환 26ms + I2C)
+#define SIM_ULP_DIVIDER_MA 0.0086       // ADC_CTL을 켜 둔 배터리 분압 회로 (4.2V / 490kΩ)
+
+// ULP 원시값 환산 (ulp_monitor.h가 보정값으로 하는 일을 대략 값으로)
+#define SIM_BATTERY_V_PER_COUNT (4.9 * 3.1 / 4095.0)   // BATTERY_DIVIDER_FACTOR x 11dB 범위 / 12비트
+#define SIM_BMP390_PA_PER_COUNT 0.0103                 // BMP390 24비트 원시 기압 기울기 (대략)
+#define SIM_BATTERY_NOISE_V 0.003
+#define SIM_PRESSURE_NOISE_PA 1.5
+#define SIM_WEATHER_PA_PER_SQRT_MIN 0.6                // 날씨 기압 랜덤 워크 (분당 표준편차)
+
+struct SensorProfile {
+  FrameKind kind;
+  const char* name;
+  uint16_t interval_s;    // platformio.ini 환경 기본값
+  double measure_ms;      // read() 소요 시간
+  double measure_ma;      // 그동안 평균 전류 (센서 포함)
+};
+
+// AM1008W 계열: PM 듀티 사이클 예열 8초 + 구간 통계 10초 동안 팬/레이저 켜짐, CPU는 sensorWait() Light Sleep
+static const SensorProfile SENSOR_PROFILES[] = {
+  {FRAME_STAIR, "stair", 10, 120.0, SIM_ACTIVE_MA},
+  {FRAME_AM1008W, "am1008w", 60, 18000.0, 75.0},
+  {FRAME_AIR_STATION, "air", 60, 18200.0, 77.0},
+};
+
+struct SimConfig {
+  uint32_t nodes = 5;
+  uint8_t gateways = 1;
+  uint8_t channels = 3;
+  const SensorProfile* sensor = &SENSOR_PROFILES[1];
+  uint16_t interval_s = 0;        // 0이면 센서 기본값
+  double hours = 24.0;
+  double boot_spread_s = 0.0;     // 0: 모든 노드가 동시에 전원 켜짐
+  double radius_m = 2000.0;
+  double drift_ppm = 200.0;
+  double shadowing_db = 6.0;
+  double adr_margin_db = 10.0;
+  uint8_t join_dr = 0;            // 조인 요청 DR (ADR 전)
+  bool slots = true;              // DevEUI 슬롯 + 무작위 지연 (false: 고정 주기)
+  bool network_time = false;      // 슬롯 시계를 공통 네트워크 시각으로
+  double battery_mah = 3000.0;
+  uint32_t seed = 1;
+  bool ulp_screen = false;        // ULP 사전 선별 (stair_battery_ulp)
+  bool ulp_pressure = false;      // 선별용 BMP390 있음 (NODE_ULP_BMP390)
+  uint16_t ulp_heartbeat = 6;     // NODE_ULP_HEARTBEAT_CYCLES
+  double ulp_battery_mv = 50.0;   // NODE_ULP_BATTERY_DELTA_MV
+  double ulp_pressure_pa = 18.0;  // NODE_ULP_PRESSURE_DELTA_PA
+  double ulp_events = 1.0;        // 시간당 기압 계단 변화 (문 열림, 공조 등)
+};
+
+struct SimNode {
+  double x, y;
+  uint64_t dev_eui;
+  double loss_db[SIM_MAX_GATEWAYS];
+  uint8_t dr;
+  double drift;                   // Light Sleep 타이머 배율
+  double boot_ms;
+  bool joined, in_range;
+  JoinBackoff backoff;
+  uint16_t uplinks_since_check;
+  uint32_t joins, uplinks, delivered, collided, unheard;
+  double airtime_ms, charge_mas;
+  bool ulp_armed;                 // 슬롯에 맞춰 깬 주기를 한 번 지나 ULP에 맡긴 상태
+  UlpScreenState ulp;
+  double pressure_pa;             // 합성 기압 (날씨 + 계단 변화)
+  uint32_t ulp_wakes[5];          // 깨운 이유별 (ULP_WAKE_*)
+};
+
+struct SimTx {
+  double start, end;
+  uint32_t node;
+  uint8_t channel, sf;
+  bool join, link_check;
+  float rssi[SIM_MAX_GATEWAYS];
+};
+
+struct SimInterval {
+  double start, end;
+};
+
+enum SimEventType { EV_BOOT, EV_JOIN_TX, EV_CYCLE, EV_TX_START, EV_TX_END };
+
+struct SimEvent {
+  double t;
+  uint8_t type;
+  uint32_t index;       // 노드 번호 (EV_TX_START는 노드 x 2 + LinkCheckReq 여부, EV_TX_END는 전송 번호)
+  bool operator>(const SimEvent &o) const { return t > o.t; }
+};
+
+struct SimResult {
+  uint32_t nodes, joined, in_range;
+  uint64_t uplinks, delivered, collided, unheard;
+  uint64_t joins;
+  double airtime_ms, duration_ms;
+  double offered_load;            // 채널당 평균 동시 전송 수 (Erlang)
+  double max_node_airtime_pct;
+  double worst_node_delivery;
+  double battery_days_min, battery_days_median;
+  double avg_current_ma;
+  uint64_t sf_uplinks[6], sf_delivered[6];
+  uint64_t ulp_samples, ulp_wakes[5];
+};
+
+// 정규분포 (Box-Muller)
+inline double simGaussian(double sigma) {
+  double u1 = simUniform() + 1e-12, u2 = simUniform();
+  return sigma * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+inline double pathLossDb(double distance_m) {
+  double km = distance_m < 10.0 ? 0.01 : distance_m / 1000.0;
+  return 128.1 + 37.6 * log10(km);
+}
+
+// 센서 종류의 현재(가장 높은 버전) 프레임 크기 (디스크립터 포함)
+inline uint8_t simFrameSize(FrameKind kind) {
+  uint8_t size = 0, version = 0;
+  for (size_t i = 0; i < FRAME_LAYOUT_COUNT; i++) {
+    if (FRAME_LAYOUTS[i].kind == kind && FRAME_LAYOUTS[i].version > version) {
+      version = FRAME_LAYOUTS[i].version;
+      size = FRAME_LAYOUTS[i].size;
+    }
+  }
+  return FRAME_DESCRIPTOR_SIZE + size;
+}
+
+class FleetSim {
+ public:
+  explicit FleetSim(const SimConfig &config) : cfg(config) {
+    if (cfg.interval_s == 0) cfg.interval_s = cfg.sensor->interval_s;
+    if (cfg.gateways > SIM_MAX_GATEWAYS) cfg.gateways = SIM_MAX_GATEWAYS;
+    if (cfg.gateways == 0) cfg.gateways = 1;
+    if (cfg.channels == 0) cfg.channels = 1;
+    frame_size = simFrameSize(cfg.sensor->kind);
+    end_ms = cfg.hours * 3600.0 * 1000.0;
+  }
+
+  SimResult run() {
+    sim_random_state = cfg.seed ? cfg.seed : 1;
+    placeGateways();
+    placeNodes();
+
+    while (!events.empty()) {
+      SimEvent ev = events.top();
+      if (ev.t > end_ms) break;
+      events.pop();
+      switch (ev.type) {
+        case EV_BOOT:
+          nodes[ev.index].charge_mas += SIM_SETUP_MS * SIM_ACTIVE_MA / 1000.0;
+          push(ev.t + SIM_SETUP_MS, EV_JOIN_TX, ev.index);
+          break;
+        case EV_JOIN_TX: startTx(ev.t, ev.index, true, cfg.join_dr, false); break;
+        case EV_CYCLE: cycle(ev.t, ev.index); break;
+        case EV_TX_START: startTx(ev.t, ev.index / 2, false, nodes[ev.index / 2].dr, ev.index & 1); break;
+        case EV_TX_END: endTx(ev.t, ev.index); break;
+      }
+    }
+    return summarize();
+  }
+
+ private:
+  SimConfig cfg;
+  uint8_t frame_size;
+  double end_ms;
+  double gw_x[SIM_MAX_GATEWAYS], gw_y[SIM_MAX_GATEWAYS];
+  std::vector<SimNode> nodes;
+  std::deque<SimTx> txs;                               // 최근 전송 (시작 순, 번호 = tx_base + 위치)
+  uint32_t tx_base = 0;
+  std::vector<std::deque<SimInterval>> gw_busy;        // 게이트웨이 다운링크 송신 구간
+  uint64_t sf_uplinks[6] = {}, sf_delivered[6] = {};
+  std::priority_queue<SimEvent, std::vector<SimEvent>, std::greater<SimEvent>> events;
+
+  void push(double t, uint8_t type, uint32_t index) { events.push({t, type, index}); }
+
+  void randomPoint(double &x, double &y) {
+    double r = cfg.radius_m * sqrt(simUniform());
+    double a = 2.0 * M_PI * simUniform();
+    x = r * cos(a);
+    y = r * sin(a);
+  }
+
+  void placeGateways() {
+    gw_busy.assign(cfg.gateways, std::deque<SimInterval>());
+    gw_x[0] = gw_y[0] = 0.0;   // 첫 게이트웨이는 가운데
+    for (uint8_t g = 1; g < cfg.gateways; g++) randomPoint(gw_x[g], gw_y[g]);
+  }
+
+  void placeNodes() {
+    nodes.assign(cfg.nodes, SimNode());
+    for (uint32_t i = 0; i < cfg.nodes; i++) {
+      SimNode &n = nodes[i];
+      randomPoint(n.x, n.y);
+      n.dev_eui = SIM_DEV_EUI_BASE + i;
+      double best_rx = -1e9;
+      for (uint8_t g = 0; g < cfg.gateways; g++) {
+        double d = hypot(n.x - gw_x[g], n.y - gw_y[g]);
+        n.loss_db[g] = pathLossDb(d) + simGaussian(cfg.shadowing_db);
+        best_rx = fmax(best_rx, SIM_TX_POWER_DBM - n.loss_db[g]);
+      }
+      // ADR 수렴 DR: 여유를 남기는 가장 빠른 SF (안 되면 DR0)
+      n.dr = 0;
+      for (int dr = KR920_MAX_DATARATE; dr >= 0; dr--) {
+        if (best_rx - loraSensitivityDbm(datarateToSf(dr)) >= cfg.adr_margin_db) {
+          n.dr = dr;
+          break;
+        }
+      }
+      n.in_range = best_rx >= loraSensitivityDbm(12);
+      n.drift = 1.0 + (2.0 * simUniform() - 1.0) * cfg.drift_ppm * 1e-6;
+      n.boot_ms = cfg.boot_spread_s * 1000.0 * simUniform();
+      n.backoff = {0, 0, 0};
+      n.uplinks_since_check = SIM_LINK_CHECK_INTERVAL;   // link_stats 초기값과 같음 (첫 업링크에서 요청)
+      ulpScreenReset(&n.ulp);
+      n.pressure_pa = 101325.0;
+      push(n.boot_ms, EV_BOOT, i);
+    }
+  }
+
+  void startTx(double t, uint32_t node, bool join, uint8_t dr, bool link_check) {
+    SimNode &n = nodes[node];
+    SimTx tx;
+    tx.start = t;
+    tx.node = node;
+    tx.channel = simRandom() % cfg.channels;
+    tx.sf = datarateToSf(dr);
+    tx.join = join;
+    tx.link_check = link_check;
+    uint16_t phy = join ? LORAWAN_JOIN_REQUEST_SIZE : LORAWAN_PHY_OVERHEAD + (link_check ? 1 : 0) + frame_size;
+    double airtime = loraAirtimeMs(tx.sf, phy);
+    tx.end = t + airtime;
+    for (uint8_t g = 0; g < cfg.gateways; g++) tx.rssi[g] = (float)(SIM_TX_POWER_DBM - n.loss_db[g]);
+
+    n.airtime_ms += airtime;
+    n.charge_mas += airtime * SIM_TX_MA / 1000.0;
+    if (join) n.joins++;
+
+    // 충돌 판정에는 겹칠 수 있는 최근 전송만 필요 (가장 긴 SF12 프레임도 3초 미만)
+    while (!txs.empty() && txs.front().end < t - 10000.0) {
+      txs.pop_front();
+      tx_base++;
+    }
+    txs.push_back(tx);
+    push(tx.end, EV_TX_END, tx_base + txs.size() - 1);
+  }
+
+  // 게이트웨이 g가 tx를 복조했는지
+  bool receivedAt(const SimTx &tx, uint8_t g) {
+    if (tx.rssi[g] < loraSensitivityDbm(tx.sf)) return false;
+
+    for (const SimInterval &busy : gw_busy[g]) {
+      if (busy.start < tx.end && busy.end > tx.start) return false;   // 송신 중에는 못 받음
+    }
+
+    uint8_t paths = 0;
+    for (const SimTx &o : txs) {
+      if (&o == &tx) continue;
+      if (o.start >= tx.end || o.end <= tx.start) continue;
+      bool audible = o.rssi[g] >= loraSensitivityDbm(o.sf);
+      if (audible && o.start <= tx.start && ++paths >= SIM_GATEWAY_PATHS) return false;
+      if (o.channel == tx.channel && o.sf == tx.sf && tx.rssi[g] - o.rssi[g] < SIM_CAPTURE_DB) return false;
+    }
+    return true;
+  }
+
+  // 게이트웨이 g가 [start, start + duration) 동안 다운링크를 보낼 수 있으면 예약
+  bool reserveDownlink(uint8_t g, double start, double duration) {
+    std::deque<SimInterval> &busy = gw_busy[g];
+    while (!busy.empty() && busy.front().end < start - 60000.0) busy.pop_front();
+    for (const SimInterval &b : busy) {
+      if (b.start < start + duration && b.end > start) return false;
+    }
+    busy.push_back({start, start + duration});
+    return true;
+  }
+
+  void endTx(double t, uint32_t index) {
+    const SimTx &tx = txs[index - tx_base];
+    SimNode &n = nodes[tx.node];
+
+    bool heard = false, delivered = false;
+    int best = -1;
+    for (uint8_t g = 0; g < cfg.gateways; g++) {
+      if (tx.rssi[g] >= loraSensitivityDbm(tx.sf)) heard = true;
+      if (receivedAt(tx, g) && (best < 0 || tx.rssi[g] > tx.rssi[best])) best = g;
+    }
+    delivered = best >= 0;
+
+    if (tx.join) {
+      double accept_at = t + SIM_JOIN_ACCEPT_DELAY_MS;
+      double accept_ms = loraAirtimeMs(tx.sf, LORAWAN_JOIN_ACCEPT_SIZE);
+      if (delivered && reserveDownlink(best, accept_at, accept_ms)) {
+        n.joined = true;
+        n.charge_mas += (SIM_JOIN_ACCEPT_DELAY_MS + accept_ms) * SIM_RX_MA / 1000.0 +
+                        SIM_JOINED_HOLD_MS * SIM_DISPLAY_MA / 1000.0;
+        push(accept_at + accept_ms + SIM_JOINED_HOLD_MS, EV_CYCLE, tx.node);
+        return;
+      }
+
+      // RX1/RX2 모두 비고 나서 조인 실패 확인
+      double fail_at = t + SIM_JOIN_ACCEPT_DELAY_MS + 1000.0 + loraRxWindowMs(tx.sf);
+      n.charge_mas += (fail_at - t) * SIM_RX_MA / 1000.0;
+      join_backoff = n.backoff;
+      sim_millis = (uint32_t)(fail_at - n.boot_ms);
+      uint32_t wait_s = joinBackoffFailed(SIM_REJOIN_DELAY_S);
+      n.backoff = join_backoff;
+      n.charge_mas += wait_s * 1000.0 * SIM_SLEEP_MA / 1000.0;
+      push(fail_at + wait_s * 1000.0, EV_JOIN_TX, tx.node);
+      return;
+    }
+
+    n.uplinks++;
+    uint8_t sf_index = tx.sf - 7;
+    sf_uplinks[sf_index]++;
+    if (delivered) {
+      n.delivered++;
+      sf_delivered[sf_index]++;
+      if (tx.link_check) {
+        reserveDownlink(best, t + SIM_RX1_DELAY_MS, loraAirtimeMs(tx.sf, LORAWAN_LINK_CHECK_ANS_SIZE));
+      }
+    } else if (heard) {
+      n.collided++;
+    } else {
+      n.unheard++;
+    }
+  }
+
+  // ULP 샘플 하나 (합성 신호 → 원시값 → ulp_screen.h), 메인 CPU를 깨울 이유를 돌려줌
+  uint32_t ulpSample(SimNode &n) {
+    UlpScreenConfig c;
+    c.battery_delta_raw = (uint32_t)(cfg.ulp_battery_mv / 1000.0 / SIM_BATTERY_V_PER_COUNT + 0.5);
+    c.battery_low_raw = (uint32_t)(3.5 / SIM_BATTERY_V_PER_COUNT);
+    c.pressure_delta_raw = cfg.ulp_pressure ? (uint32_t)(cfg.ulp_pressure_pa / SIM_BMP390_PA_PER_COUNT + 0.5) : 0;
+    c.heartbeat_cycles = cfg.ulp_heartbeat;
+
+    double soc = fmax(0.0, 1.0 - n.charge_mas / 3600.0 / cfg.battery_mah);
+    double battery_v = 3.3 + 0.9 * soc + simGaussian(SIM_BATTERY_NOISE_V);
+    n.pressure_pa += simGaussian(SIM_WEATHER_PA_PER_SQRT_MIN * sqrt(cfg.interval_s / 60.0));
+    if (simUniform() < cfg.ulp_events * cfg.interval_s / 3600.0) {
+      n.pressure_pa += (simUniform() < 0.5 ? -1.0 : 1.0) * (20.0 + 40.0 * simUniform());
+    }
+
+    UlpSample sample;
+    sample.battery_raw = (uint32_t)(battery_v / SIM_BATTERY_V_PER_COUNT);
+    sample.pressure_raw =
+        cfg.ulp_pressure ? (uint32_t)((n.pressure_pa + simGaussian(SIM_PRESSURE_NOISE_PA)) / SIM_BMP390_PA_PER_COUNT) : 0;
+
+    double sample_ms = SIM_ULP_SAMPLE_MS + (cfg.ulp_pressure ? SIM_ULP_BMP390_MS : 0.0);
+    n.charge_mas += (sample_ms * SIM_ULP_MA + cfg.interval_s * 1000.0 * SIM_ULP_DIVIDER_MA) / 1000.0;
+    return ulpScreenStep(&n.ulp, &c, &sample);
+  }
+
+  // loop() 한 번: 측정 → 업링크 → RX1/RX2 → 화면 표시 → Light Sleep
+  void cycle(double t, uint32_t node) {
+    SimNode &n = nodes[node];
+    const SensorProfile &sensor = *cfg.sensor;
+    uint8_t sf = datarateToSf(n.dr);
+    double ulp_period_ms = cfg.interval_s * 1000.0 * n.drift;
+
+    if (n.ulp_armed) {
+      uint32_t reason = ulpSample(n);
+      if (reason == ULP_WAKE_NONE) {   // 메인 CPU는 계속 Light Sleep
+        n.charge_mas += ulp_period_ms * SIM_SLEEP_MA / 1000.0;
+        push(t + ulp_period_ms, EV_CYCLE, node);
+        return;
+      }
+      n.ulp_wakes[reason]++;
+    }
+
+    bool link_check = n.uplinks_since_check >= SIM_LINK_CHECK_INTERVAL;
+    n.uplinks_since_check = link_check ? 1 : n.uplinks_since_check + 1;
+    double tx_at = t + sensor.measure_ms + SIM_LOOP_OVERHEAD_MS;
+    push(tx_at, EV_TX_START, node * 2 + link_check);
+
+    double airtime = loraAirtimeMs(sf, LORAWAN_PHY_OVERHEAD + (link_check ? 1 : 0) + frame_size);
+    double rx_wait = SIM_RX2_DELAY_MS + loraRxWindowMs(sf);     // TX 끝 → RX2 닫힘
+    double rx_on = 2.0 * loraRxWindowMs(sf);
+    double elapsed = sensor.measure_ms + SIM_LOOP_OVERHEAD_MS + airtime + rx_wait + SIM_DISPLAY_HOLD_MS;
+    double sleep_ms = n.ulp_armed ? fmax(0.0, ulp_period_ms - elapsed - SIM_WAKE_MS) : sleepMs(n, t + elapsed, elapsed);
+    if (cfg.ulp_screen && !n.ulp_armed) {   // 첫 주기는 슬롯으로 잠 (sleepUntilNextCycle())
+      n.ulp_armed = true;
+      ulpScreenRebase(&n.ulp);
+    }
+
+    n.charge_mas += (sensor.measure_ms * sensor.measure_ma + SIM_LOOP_OVERHEAD_MS * SIM_ACTIVE_MA +
+                     rx_on * SIM_RX_MA + (rx_wait - rx_on) * SIM_SLEEP_MA +
+                     SIM_DISPLAY_HOLD_MS * SIM_DISPLAY_MA + (sleep_ms + SIM_WAKE_MS) * SIM_SLEEP_MA) / 1000.0;
+    push(t + elapsed + sleep_ms + SIM_WAKE_MS, EV_CYCLE, node);
+  }
+
+  // 펌웨어 스케줄로 계산한 Light Sleep 시간 (실제 시간, 노드 타이머 오차 포함)
+  double sleepMs(const SimNode &n, double t, double elapsed) {
+    if (!cfg.slots) {
+      return uplinkSleepSeconds((uint32_t)elapsed, cfg.interval_s) * 1000.0 * n.drift;
+    }
+    // 노드 시계 = 부팅 후 시간 / 타이머 배율, 네트워크 시각이면 실제 시간 그대로
+    uint64_t clock_ms = cfg.network_time ? (uint64_t)t : (uint64_t)((t - n.boot_ms) / n.drift);
+    uint32_t jitter_ms = random(uplinkSlotJitterMaxMs(cfg.interval_s) + 1);
+    uint32_t sleep_ms = uplinkSlotSleepMs(clock_ms, n.dev_eui, cfg.interval_s, jitter_ms);
+    return cfg.network_time ? sleep_ms : sleep_ms * n.drift;
+  }
+
+  SimResult summarize() {
+    SimResult r = {};
+    r.nodes = cfg.nodes;
+    r.duration_ms = end_ms;
+    r.worst_node_delivery = 1.0;
+    std::vector<double> battery;
+    double current_sum = 0;
+
+    for (SimNode &n : nodes) {
+      r.joined += n.joined;
+      r.in_range += n.in_range;
+      r.joins += n.joins;
+      r.uplinks += n.uplinks;
+      r.delivered += n.delivered;
+      r.collided += n.collided;
+      r.unheard += n.unheard;
+      r.airtime_ms += n.airtime_ms;
+      r.ulp_samples += n.ulp.samples;
+      for (int i = 0; i < 5; i++) r.ulp_wakes[i] += n.ulp_wakes[i];
+      r.max_node_airtime_pct = fmax(r.max_node_airtime_pct, n.airtime_ms / end_ms * 100.0);
+      if (n.uplinks > 0 && n.in_range) {
+        r.worst_node_delivery = fmin(r.worst_node_delivery, (double)n.delivered / n.uplinks);
+      }
+
+      double alive_ms = end_ms - n.boot_ms;
+      if (alive_ms <= 0) continue;
+      double avg_ma = n.charge_mas / (alive_ms / 1000.0);
+      current_sum += avg_ma;
+      battery.push_back(cfg.battery_mah / avg_ma / 24.0);
+    }
+
+    std::sort(battery.begin(), battery.end());
+    r.battery_days_min = battery.empty() ? 0 : battery.front();
+    r.battery_days_median = battery.empty() ? 0 : battery[battery.size() / 2];
+    r.avg_current_ma = battery.empty() ? 0 : current_sum / battery.size();
+    r.offered_load = r.airtime_ms / end_ms / cfg.channels;
+    for (int i = 0; i < 6; i++) {
+      r.sf_uplinks[i] = sf_uplinks[i];
+      r.sf_delivered[i] = sf_delivered[i];
+    }
+    return r;
+  }
+};
+
+#endif
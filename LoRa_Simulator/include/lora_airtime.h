@@ -0,0 +1,47 @@
+#ifndef _LORA_AIRTIME_H
+#define _LORA_AIRTIME_H
+
+#include <math.h>
+#include <stdint.h>
+
+// ============================================================================
+// KR920 LoRa 물리 계층 (BW125, CR4/5, 프리앰블 8, 명시적 헤더, CRC)
+//
+// DR0~5 = SF12~7, 감도는 SX1262 데이터시트 BW125 값
+// LoRaWAN 프레임 크기: MHDR 1 + DevAddr 4 + FCtrl 1 + FCnt 2 + FPort 1 + MIC 4 = 13바이트 + FOpts + 페이로드
+// ============================================================================
+
+#define LORA_BW_HZ 125000.0
+#define LORA_PREAMBLE_SYMBOLS 8
+#define LORA_CODING_RATE 1                // 4/5
+
+#define LORAWAN_PHY_OVERHEAD 13
+#define LORAWAN_JOIN_REQUEST_SIZE 23
+#define LORAWAN_JOIN_ACCEPT_SIZE 33       // CFList 포함 (KR920 추가 채널)
+#define LORAWAN_LINK_CHECK_ANS_SIZE 15    // 빈 페이로드 + FOpts LinkCheckAns 3바이트 (FPort 없음)
+
+#define KR920_MAX_DATARATE 5
+
+inline uint8_t datarateToSf(uint8_t dr) { return 12 - dr; }
+
+// 공중 전송 시간 (ms, Semtech AN1200.13)
+inline double loraAirtimeMs(uint8_t sf, uint16_t phy_len) {
+  double symbol_ms = (double)(1 << sf) / LORA_BW_HZ * 1000.0;
+  int low_dr_opt = sf >= 11 ? 1 : 0;   // BW125에서 SF11/12는 LDRO 필수
+  double numerator = 8.0 * phy_len - 4.0 * sf + 28 + 16;
+  double payload_symbols = 8 + fmax(ceil(numerator / (4.0 * (sf - 2 * low_dr_opt))) * (LORA_CODING_RATE + 4), 0);
+  return (LORA_PREAMBLE_SYMBOLS + 4.25 + payload_symbols) * symbol_ms;
+}
+
+// 수신 감도 (dBm)
+inline double loraSensitivityDbm(uint8_t sf) {
+  static const double sensitivity[6] = {-124.0, -127.0, -130.0, -133.0, -135.0, -137.0};  // SF7~12
+  return sensitivity[sf - 7];
+}
+
+// 프리앰블 검출까지 수신기가 켜져 있는 시간 (빈 수신 윈도우, ms)
+inline double loraRxWindowMs(uint8_t sf) {
+  return (LORA_PREAMBLE_SYMBOLS + 4.25) * (double)(1 << sf) / LORA_BW_HZ * 1000.0;
+}
+
+#endif
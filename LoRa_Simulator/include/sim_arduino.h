@@ -0,0 +1,32 @@
+#ifndef _SIM_ARDUINO_H
+#define _SIM_ARDUINO_H
+
+#include <algorithm>
+#include <stdint.h>
+
+// ============================================================================
+// 펌웨어 헤더(join_backoff.h 등)가 쓰는 Arduino 함수를 시뮬레이션 시각/난수로 대체
+// 노드마다 상태를 바꿔 끼우며 호출하므로 sim_millis는 호출 직전에 그 노드의 부팅 후 시각으로 맞춤
+// ============================================================================
+
+uint32_t sim_millis = 0;          // 현재 노드의 millis()
+uint32_t sim_random_state = 1;    // xorshift32 (0이면 안 됨)
+
+inline uint32_t millis() { return sim_millis; }
+
+inline uint32_t simRandom() {
+  sim_random_state ^= sim_random_state << 13;
+  sim_random_state ^= sim_random_state >> 17;
+  sim_random_state ^= sim_random_state << 5;
+  return sim_random_state;
+}
+
+// [0, 1)
+inline double simUniform() { return (simRandom() >> 8) * (1.0 / 16777216.0); }
+
+inline long random(long max) { return max > 0 ? (long)(simRandom() % (uint32_t)max) : 0; }
+
+using std::min;
+using std::max;
+
+#endif
@@ -0,0 +1,175 @@
+// ============================================================================
+// LoRa 노드 군집 airtime/충돌 시뮬레이터 (pio run -e native && .pio/build/native/program [옵션])
+//
+//   --nodes N          노드 수 (기본 5)
+//   --gateways G       게이트웨이 수 (기본 1, 첫 번째는 가운데)
+//   --channels C       업링크 채널 수 (기본 3, KR920 기본 채널)
+//   --sensor S         stair | am1008w | air (프레임 크기, 측정 시간, 기본 주기)
+//   --interval S       업링크 주기 (초, 기본 센서 환경값)
+//   --hours H          시뮬레이션 시간 (기본 24)
+//   --boot-spread S    노드 전원이 켜지는 시각 범위 (초, 기본 0 = 동시)
+//   --radius M         배치 반경 (m, 기본 2000)
+//   --drift PPM        Light Sleep 타이머 오차 범위 (기본 ±200ppm)
+//   --join-dr DR       조인 요청 DR (기본 0)
+//   --no-slots         DevEUI 슬롯 대신 고정 주기 (슬롯 이전 펌웨어)
+//   --network-time     슬롯 시계를 공통 네트워크 시각으로 (타이머 오차 없음)
+//   --battery MAH      배터리 용량 (기본 3000mAh)
+//   --seed N           난수 시드
+//   --ulp-screen       ULP RISC-V 사전 선별 (stair_battery_ulp, 변화/하트비트가 있을 때만 메인 CPU가 깸)
+//   --ulp-pressure     선별용 BMP390 있음 (NODE_ULP_BMP390, 없으면 배터리 + 하트비트만)
+//   --ulp-heartbeat N  변화가 없어도 N 주기마다 깨움 (기본 6)
+//   --ulp-battery MV   배터리 변화 임계값 (기본 50mV)
+//   --ulp-pressure-pa P 기압 변화 임계값 (기본 18Pa)
+//   --ulp-events R     시간당 기압 계단 변화 횟수 (기본 1)
+//   --sweep            노드 수를 늘려 가며 한 줄씩 (전달률 90% 아래로 떨어지는 지점 표시)
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fleet_sim.h"
+
+#define SWEEP_KNEE_DELIVERY 0.90
+
+static const uint32_t SWEEP_NODES[] = {5, 10, 20, 50, 100, 200, 300, 500, 750, 1000, 1500, 2000};
+
+static void printUsage() {
+  printf("usage: program [--nodes N] [--gateways G] [--channels C] [--sensor stair|am1008w|air]\n"
+         "               [--interval S] [--hours H] [--boot-spread S] [--radius M] [--drift PPM]\n"
+         "               [--join-dr DR] [--no-slots] [--network-time] [--battery MAH]\n"
+         "               [--seed N] [--sweep] [--ulp-screen] [--ulp-pressure] [--ulp-heartbeat N]\n"
+         "               [--ulp-battery MV] [--ulp-pressure-pa P] [--ulp-events R]\n");
+}
+
+static double ratio(uint64_t a, uint64_t b) { return b ? (double)a / b : 0.0; }
+
+static void printReport(const SimConfig &cfg, const SimResult &r) {
+  uint16_t interval = cfg.interval_s ? cfg.interval_s : cfg.sensor->interval_s;
+  printf("Fleet: %u x %s (%uB frame, %us), %u gateway(s), %u channel(s), %.1fh, boot spread %.0fs, %s\n",
+         r.nodes, cfg.sensor->name, simFrameSize(cfg.sensor->kind), interval, cfg.gateways, cfg.channels,
+         cfg.hours, cfg.boot_spread_s,
+         !cfg.slots ? "fixed interval" : cfg.network_time ? "slots (network time)" : "slots (local clock)");
+  printf("  joined %u/%u (join requests %llu), out of range %u\n",
+         r.joined, r.nodes, (unsigned long long)r.joins, r.nodes - r.in_range);
+  printf("  uplinks %llu: delivered %.2f%%, lost to interference %.2f%%, unheard %.2f%%\n",
+         (unsigned long long)r.uplinks, ratio(r.delivered, r.uplinks) * 100.0,
+         ratio(r.collided, r.uplinks) * 100.0, ratio(r.unheard, r.uplinks) * 100.0);
+  printf("  collision probability (heard uplinks) %.2f%%, worst node delivery %.1f%%\n",
+         ratio(r.collided, r.delivered + r.collided) * 100.0, r.worst_node_delivery * 100.0);
+  printf("  offered load %.4f Erlang/channel, node airtime max %.3f%%\n", r.offered_load, r.max_node_airtime_pct);
+  for (int i = 0; i < 6; i++) {
+    if (!r.sf_uplinks[i]) continue;
+    printf("    SF%-2d uplinks %8llu  delivered %6.2f%%\n", i + 7, (unsigned long long)r.sf_uplinks[i],
+           ratio(r.sf_delivered[i], r.sf_uplinks[i]) * 100.0);
+  }
+  if (cfg.ulp_screen) {
+    uint64_t wakes = 0;
+    for (int i = 1; i < 5; i++) wakes += r.ulp_wakes[i];
+    printf("  ULP screening (%s): %llu samples, main CPU woken %llu (%.1f%%) - heartbeat %llu, battery %llu, "
+           "pressure %llu, low battery %llu\n",
+           cfg.ulp_pressure ? "battery + pressure" : "battery only", (unsigned long long)r.ulp_samples,
+           (unsigned long long)wakes, ratio(wakes, r.ulp_samples) * 100.0,
+           (unsigned long long)r.ulp_wakes[ULP_WAKE_HEARTBEAT], (unsigned long long)r.ulp_wakes[ULP_WAKE_BATTERY],
+           (unsigned long long)r.ulp_wakes[ULP_WAKE_PRESSURE], (unsigned long long)r.ulp_wakes[ULP_WAKE_LOW_BATTERY]);
+  }
+  printf("  average current %.2f mA, battery life (%.0fmAh) min %.1f / median %.1f days\n",
+         r.avg_current_ma, cfg.battery_mah, r.battery_days_min, r.battery_days_median);
+}
+
+static void runSweep(SimConfig cfg) {
+  printf("%6s %7s %10s %9s %9s %9s %9s\n", "nodes", "joined", "load/ch", "delivery", "collide",
+         "worst", "battery");
+  bool knee_found = false;
+  for (uint32_t n : SWEEP_NODES) {
+    cfg.nodes = n;
+    SimResult r = FleetSim(cfg).run();
+    double delivery = ratio(r.delivered, r.uplinks);
+    bool knee = !knee_found && delivery < SWEEP_KNEE_DELIVERY;
+    knee_found |= knee;
+    printf("%6u %7u %10.4f %8.2f%% %8.2f%% %8.1f%% %8.1fd%s\n", n, r.joined, r.offered_load,
+           delivery * 100.0, ratio(r.collided, r.delivered + r.collided) * 100.0, r.worst_node_delivery * 100.0,
+           r.battery_days_median, knee ? "  <- delivery below 90%" : "");
+  }
+}
+
+int main(int argc, char** argv) {
+  SimConfig cfg;
+  bool sweep = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    bool takes_value = true;
+
+    if (!strcmp(arg, "--sweep")) {
+      sweep = true;
+      takes_value = false;
+    } else if (!strcmp(arg, "--no-slots")) {
+      cfg.slots = false;
+      takes_value = false;
+    } else if (!strcmp(arg, "--network-time")) {
+      cfg.network_time = true;
+      takes_value = false;
+    } else if (!strcmp(arg, "--ulp-screen")) {
+      cfg.ulp_screen = true;
+      takes_value = false;
+    } else if (!strcmp(arg, "--ulp-pressure")) {
+      cfg.ulp_pressure = true;
+      takes_value = false;
+    } else if (!value) {
+      printUsage();
+      return 1;
+    } else if (!strcmp(arg, "--nodes")) {
+      cfg.nodes = strtoul(value, nullptr, 10);
+    } else if (!strcmp(arg, "--gateways")) {
+      cfg.gateways = atoi(value);
+    } else if (!strcmp(arg, "--channels")) {
+      cfg.channels = atoi(value);
+    } else if (!strcmp(arg, "--sensor")) {
+      cfg.sensor = nullptr;
+      for (const SensorProfile &p : SENSOR_PROFILES) {
+        if (!strcmp(p.name, value)) cfg.sensor = &p;
+      }
+      if (!cfg.sensor) {
+        printUsage();
+        return 1;
+      }
+    } else if (!strcmp(arg, "--interval")) {
+      cfg.interval_s = atoi(value);
+    } else if (!strcmp(arg, "--hours")) {
+      cfg.hours = atof(value);
+    } else if (!strcmp(arg, "--boot-spread")) {
+      cfg.boot_spread_s = atof(value);
+    } else if (!strcmp(arg, "--radius")) {
+      cfg.radius_m = atof(value);
+    } else if (!strcmp(arg, "--drift")) {
+      cfg.drift_ppm = atof(value);
+    } else if (!strcmp(arg, "--join-dr")) {
+      cfg.join_dr = min(atoi(value), KR920_MAX_DATARATE);
+    } else if (!strcmp(arg, "--battery")) {
+      cfg.battery_mah = atof(value);
+    } else if (!strcmp(arg, "--seed")) {
+      cfg.seed = strtoul(value, nullptr, 10);
+    } else if (!strcmp(arg, "--ulp-heartbeat")) {
+      cfg.ulp_heartbeat = atoi(value);
+    } else if (!strcmp(arg, "--ulp-battery")) {
+      cfg.ulp_battery_mv = atof(value);
+    } else if (!strcmp(arg, "--ulp-pressure-pa")) {
+      cfg.ulp_pressure_pa = atof(value);
+    } else if (!strcmp(arg, "--ulp-events")) {
+      cfg.ulp_events = atof(value);
+    } else {
+      printUsage();
+      return 1;
+    }
+    if (takes_value) i++;
+  }
+
+  if (sweep) {
+    runSweep(cfg);
+  } else {
+    printReport(cfg, FleetSim(cfg).run());
+  }
+  return 0;
+}
@@ -0,0 +1,20 @@
+#ifndef _HOST_ADAFRUIT_GFX_H
+#define _HOST_ADAFRUIT_GFX_H
+
+#include <Arduino.h>
+
+// 그리기 호출은 모두 버림 (OLED 없음)
+
+class Adafruit_GFX : public Print {
+ public:
+  size_t write(uint8_t) override { return 1; }
+  void setTextSize(uint8_t) {}
+  void setTextColor(uint16_t) {}
+  void setCursor(int16_t, int16_t) {}
+  void drawLine(int16_t, int16_t, int16_t, int16_t, uint16_t) {}
+  void drawBitmap(int16_t, int16_t, const uint8_t*, int16_t, int16_t, uint16_t) {}
+  void fillRect(int16_t, int16_t, int16_t, int16_t, uint16_t) {}
+  void drawRect(int16_t, int16_t, int16_t, int16_t, uint16_t) {}
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef _HOST_ADAFRUIT_SSD1306_H
+#define _HOST_ADAFRUIT_SSD1306_H
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+#define SSD1306_WHITE 1
+#define SSD1306_BLACK 0
+#define SSD1306_SWITCHCAPVCC 2
+
+// OLED가 없는 보드처럼 begin()이 실패 → 펌웨어는 화면 없이 계속 (oled_available = false)
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+ public:
+  Adafruit_SSD1306(uint8_t, uint8_t, TwoWire*, int8_t) {}
+  bool begin(uint8_t, uint8_t, bool = true, bool = true) { return false; }
+  void clearDisplay() {}
+  void display() {}
+};
+
+#endif
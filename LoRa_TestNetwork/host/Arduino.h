@@ -0,0 +1,232 @@
+#ifndef _HOST_ARDUINO_H
+#define _HOST_ARDUINO_H
+
+#include <algorithm>
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+// ============================================================================
+// 호스트(Linux)용 Arduino 대체 - 펌웨어 LoRaNodeCore 헤더를 수정 없이 컴파일하기 위한 최소 구현
+//
+// 시간은 모두 시뮬레이션 시계(sim_now_us): delay()/Light Sleep은 시계만 앞으로 돌리고 바로 반환
+// 시나리오 종료 시각(sim_deadline_us)을 넘기면 SimTimeUp 예외로 펌웨어 루프를 빠져나옴
+// (라디오 초기화 실패 시 debug(..., halt)의 무한 대기도 이렇게 끝남)
+// ============================================================================
+
+typedef uint8_t byte;
+
+#define HEX 16
+#define DEC 10
+#define OUTPUT 1
+#define INPUT 0
+#define INPUT_PULLUP 2
+#define HIGH 1
+#define LOW 0
+#define ARDUINO 10819
+#define ESP32 1
+#define digitalPinToInterrupt(p) (p)
+#define PROGMEM
+
+struct SimTimeUp {};
+
+uint64_t sim_now_us = 0;                  // 시뮬레이션 시각 (전원 인가 후 µs)
+uint64_t sim_deadline_us = UINT64_MAX;    // 시나리오 종료 시각
+bool sim_verbose = false;                 // 펌웨어 시리얼 출력 표시
+
+inline void simAdvanceUs(uint64_t us) {
+  sim_now_us += us;
+  if (sim_now_us >= sim_deadline_us) throw SimTimeUp();
+}
+
+inline unsigned long millis() { return (unsigned long)(uint32_t)(sim_now_us / 1000); }
+inline unsigned long micros() { return (unsigned long)(uint32_t)sim_now_us; }
+inline void delay(uint32_t ms) { simAdvanceUs(ms * 1000ULL); }
+inline void delayMicroseconds(uint32_t us) { simAdvanceUs(us); }
+inline void yield() {}
+
+// 핀 레벨은 시뮬레이션 라디오가 정함 (BUSY, DIO1), 읽을 때마다 1µs 경과
+int (*sim_pin_reader)(uint8_t pin) = nullptr;
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t pin) {
+  simAdvanceUs(1);
+  return sim_pin_reader ? sim_pin_reader(pin) : LOW;
+}
+
+// 난수 (xorshift32, 시나리오 시드로 재현 가능)
+uint32_t sim_random_state = 1;
+inline uint32_t esp_random() {
+  sim_random_state ^= sim_random_state << 13;
+  sim_random_state ^= sim_random_state >> 17;
+  sim_random_state ^= sim_random_state << 5;
+  return sim_random_state;
+}
+inline long random(long max) { return max > 0 ? (long)(esp_random() % (uint32_t)max) : 0; }
+inline long random(long min, long max) { return min + random(max - min); }
+inline void randomSeed(unsigned long seed) { sim_random_state = seed ? seed : 1; }
+
+inline bool setCpuFrequencyMhz(uint32_t) { return true; }
+inline uint32_t getCpuFrequencyMhz() { return 240; }
+
+using std::min;
+using std::max;
+template <typename T> T constrain(T v, T a, T b) { return v < a ? a : (v > b ? b : v); }
+
+class __FlashStringHelper;
+#define F(x) (reinterpret_cast<const __FlashStringHelper*>(x))
+
+// ============================================================================
+// String (std::string 기반, 펌웨어가 쓰는 생성자/연산만)
+// ============================================================================
+
+class String {
+ public:
+  std::string s;
+
+  String() {}
+  String(const char* c) : s(c ? c : "") {}
+  String(const std::string &c) : s(c) {}
+  String(char c) : s(1, c) {}
+  String(int v, int base = DEC) : s(format((long long)v, base)) {}
+  String(unsigned int v, int base = DEC) : s(format((long long)v, base)) {}
+  String(long v, int base = DEC) : s(format((long long)v, base)) {}
+  String(unsigned long v, int base = DEC) : s(format((long long)v, base)) {}
+  String(long long v, int base = DEC) : s(format(v, base)) {}
+  String(unsigned long long v, int base = DEC) : s(format((long long)v, base)) {}
+  String(unsigned char v, int base = DEC) : s(format((long long)v, base)) {}
+  String(short v, int base = DEC) : s(format((long long)v, base)) {}
+  String(unsigned short v, int base = DEC) : s(format((long long)v, base)) {}
+  String(signed char v, int base = DEC) : s(format((long long)v, base)) {}
+  String(bool v) : s(v ? "1" : "0") {}
+  String(float v, int decimals = 2) : s(formatFloat(v, decimals)) {}
+  String(double v, int decimals = 2) : s(formatFloat(v, decimals)) {}
+
+  const char* c_str() const { return s.c_str(); }
+  unsigned length() const { return s.size(); }
+  bool isEmpty() const { return s.empty(); }
+  char operator[](unsigned i) const { return s[i]; }
+  bool operator==(const String &o) const { return s == o.s; }
+  bool operator==(const char* o) const { return s == o; }
+  bool operator!=(const String &o) const { return s != o.s; }
+  String &operator+=(const String &o) { s += o.s; return *this; }
+  String &operator+=(const char* o) { s += o; return *this; }
+  String &operator+=(char o) { s += o; return *this; }
+  String substring(unsigned a) const { return String(s.substr(a)); }
+  String substring(unsigned a, unsigned b) const { return String(s.substr(a, b - a)); }
+  int indexOf(char c, unsigned from = 0) const { size_t p = s.find(c, from); return p == std::string::npos ? -1 : (int)p; }
+  long toInt() const { return atol(s.c_str()); }
+  void trim() {
+    size_t a = s.find_first_not_of(" \t\r\n"), b = s.find_last_not_of(" \t\r\n");
+    s = a == std::string::npos ? "" : s.substr(a, b - a + 1);
+  }
+  void toUpperCase() { for (char &c : s) c = toupper(c); }
+
+ private:
+  static std::string format(long long v, int base) {
+    char buf[32];
+    if (base == HEX) snprintf(buf, sizeof(buf), "%llX", (unsigned long long)v);
+    else snprintf(buf, sizeof(buf), "%lld", v);
+    return buf;
+  }
+  static std::string formatFloat(double v, int decimals) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    return buf;
+  }
+};
+
+inline String operator+(const String &a, const String &b) { return String(a.s + b.s); }
+inline String operator+(const String &a, const char* b) { return String(a.s + b); }
+inline String operator+(const char* a, const String &b) { return String(a + b.s); }
+inline String operator+(const String &a, char b) { return String(a.s + b); }
+
+// ============================================================================
+// 시리얼 (sim_verbose일 때만 표준 출력, 앞에 시뮬레이션 시각)
+// ============================================================================
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  size_t write(const uint8_t* buf, size_t n) { for (size_t i = 0; i < n; i++) write(buf[i]); return n; }
+
+  size_t print(const String &v) { return emit(v.s.c_str()); }
+  size_t print(const char* v) { return emit(v); }
+  size_t print(const __FlashStringHelper* v) { return emit(reinterpret_cast<const char*>(v)); }
+  size_t print(char v) { char b[2] = {v, 0}; return emit(b); }
+  size_t print(char v, int base) { return print((int)(uint8_t)v, base); }
+  size_t print(int v, int base = DEC) { return emit(String(v, base).c_str()); }
+  size_t print(unsigned int v, int base = DEC) { return emit(String(v, base).c_str()); }
+  size_t print(long v, int base = DEC) { return emit(String(v, base).c_str()); }
+  size_t print(unsigned long v, int base = DEC) { return emit(String(v, base).c_str()); }
+  size_t print(unsigned char v, int base = DEC) { return emit(String(v, base).c_str()); }
+  size_t print(double v, int decimals = 2) { return emit(String(v, decimals).c_str()); }
+
+  template <typename T> size_t println(const T &v) { size_t n = print(v); return n + emit("\n"); }
+  template <typename T> size_t println(const T &v, int arg) { size_t n = print(v, arg); return n + emit("\n"); }
+  size_t println() { return emit("\n"); }
+
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[512];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    return emit(buf);
+  }
+
+ private:
+  size_t emit(const char* text) {
+    size_t n = strlen(text);
+    for (size_t i = 0; i < n; i++) write((uint8_t)text[i]);
+    return n;
+  }
+};
+
+class Stream : public Print {
+ public:
+  int available() { return 0; }
+  int read() { return -1; }
+  size_t readBytes(uint8_t*, size_t) { return 0; }
+  void setTimeout(unsigned long) {}
+  void flush() { fflush(stdout); }
+};
+
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override {
+    if (!sim_verbose) return 1;
+    if (line_start) ::printf("[%9.3f] ", sim_now_us / 1e6);
+    putchar(c);
+    line_start = c == '\n';
+    return 1;
+  }
+  using Print::write;
+
+ private:
+  bool line_start = true;
+};
+
+HardwareSerial Serial;
+
+// ============================================================================
+// ESP32 칩 (재시작은 지원하지 않음 - 호출되면 시나리오 종료)
+// ============================================================================
+
+struct SimRestart {};
+
+class EspClass {
+ public:
+  uint64_t getEfuseMac() { return 0x0000A1B2C3D4E5F6ULL; }
+  void restart() { throw SimRestart(); }
+};
+
+EspClass ESP;
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef _HOST_CLIENT_H
+#define _HOST_CLIENT_H
+
+// Arduino 네트워크 클라이언트 기반 클래스 자리 (PubSubClient 생성자 타입만 맞춤)
+
+class Client {
+ public:
+  virtual ~Client() {}
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef _HOST_FS_H
+#define _HOST_FS_H
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+// 파일 시스템: 프로세스 메모리 (시나리오마다 fork()된 프로세스라 빈 상태로 시작)
+// 펌웨어가 쓰는 open("r"/"w"/"a"), read/write/seek/size, exists/remove/rename만
+// /device_registry.json이 없으므로 기본 Device ID, 플래시 기록(NODE_HISTORY)은 메모리에 쌓임
+
+std::map<std::string, std::vector<uint8_t>> sim_files;
+
+class File {
+ public:
+  File() {}
+  File(std::vector<uint8_t>* data, size_t pos, bool writable) : data(data), pos(pos), writable(writable) {}
+
+  operator bool() const { return data != nullptr; }
+  int read() { return data && pos < data->size() ? (*data)[pos++] : -1; }
+  size_t read(uint8_t* buf, size_t len) {
+    if (!data || pos >= data->size()) return 0;
+    size_t n = std::min(len, data->size() - pos);
+    memcpy(buf, data->data() + pos, n);
+    pos += n;
+    return n;
+  }
+  size_t write(const uint8_t* buf, size_t len) {
+    if (!data || !writable) return 0;
+    if (data->size() < pos + len) data->resize(pos + len);
+    memcpy(data->data() + pos, buf, len);
+    pos += len;
+    return len;
+  }
+  size_t size() { return data ? data->size() : 0; }
+  size_t position() { return pos; }
+  bool seek(uint32_t p) {
+    if (!data || p > data->size()) return false;
+    pos = p;
+    return true;
+  }
+  void close() { data = nullptr; }
+
+ private:
+  std::vector<uint8_t>* data = nullptr;
+  size_t pos = 0;
+  bool writable = false;
+};
+
+class FS {
+ public:
+  File open(const char* path, const char* mode = "r", bool = false) {
+    if (mode[0] == 'r') {
+      auto it = sim_files.find(path);
+      return it == sim_files.end() ? File() : File(&it->second, 0, false);
+    }
+    std::vector<uint8_t> &data = sim_files[path];
+    if (mode[0] == 'w') data.clear();
+    return File(&data, data.size(), true);
+  }
+  bool exists(const char* path) { return sim_files.count(path) > 0; }
+  bool remove(const char* path) { return sim_files.erase(path) > 0; }
+  bool rename(const char* from, const char* to) {
+    auto it = sim_files.find(from);
+    if (it == sim_files.end()) return false;
+    std::vector<uint8_t> data = std::move(it->second);
+    sim_files.erase(it);
+    sim_files[to] = std::move(data);
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef _HOST_LITTLEFS_H
+#define _HOST_LITTLEFS_H
+
+#include <FS.h>
+
+// 항상 마운트됨 (내용은 FS.h의 프로세스 메모리)
+
+class LittleFSFS : public FS {
+ public:
+  bool begin(bool = false, const char* = "/littlefs", uint8_t = 10, const char* = "spiffs") { return true; }
+  void end() {}
+  size_t totalBytes() { return 0x160000; }
+  size_t usedBytes() {
+    size_t used = 0;
+    for (const auto &f : sim_files) used += f.second.size();
+    return used;
+  }
+};
+
+LittleFSFS LittleFS;
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef _HOST_PREFERENCES_H
+#define _HOST_PREFERENCES_H
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+// NVS 대체: 프로세스 메모리 (시나리오마다 fork()된 프로세스라 빈 상태로 시작)
+// 펌웨어가 쓰는 바이트 blob 읽기/쓰기만 지원
+
+std::map<std::string, std::vector<uint8_t>> sim_nvs;
+
+class Preferences {
+ public:
+  bool begin(const char* name, bool readOnly = false) {
+    space = name;
+    read_only = readOnly;
+    return true;
+  }
+  void end() {}
+
+  size_t putBytes(const char* key, const void* value, size_t len) {
+    if (read_only) return 0;
+    const uint8_t* bytes = (const uint8_t*)value;
+    sim_nvs[space + "/" + key].assign(bytes, bytes + len);
+    return len;
+  }
+
+  size_t getBytesLength(const char* key) {
+    auto it = sim_nvs.find(space + "/" + key);
+    return it == sim_nvs.end() ? 0 : it->second.size();
+  }
+
+  size_t getBytes(const char* key, void* buf, size_t maxLen) {
+    auto it = sim_nvs.find(space + "/" + key);
+    if (it == sim_nvs.end() || it->second.size() > maxLen) return 0;
+    memcpy(buf, it->second.data(), it->second.size());
+    return it->second.size();
+  }
+
+ private:
+  std::string space;
+  bool read_only = false;
+};
+
+#endif
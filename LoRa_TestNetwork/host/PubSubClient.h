@@ -0,0 +1,120 @@
+#ifndef _HOST_PUBSUBCLIENT_H
+#define _HOST_PUBSUBCLIENT_H
+
+#include <Arduino.h>
+#include <Client.h>
+#include <WiFi.h>
+#include <functional>
+#include "mqtt_broker.h"
+
+// ============================================================================
+// PubSubClient 2.8 대체: TCP 대신 로컬 브로커 대역(sim_mqtt_broker, include/mqtt_broker.h)에 붙음
+//
+// 펌웨어가 쓰는 API만. QoS 0 발행, 버퍼 크기 한도(헤더 + 토픽 + 페이로드)는 실제 라이브러리와 같음
+// 연결/구독은 왕복 한 번, 발행은 SIM_WIFI_BYTES_PER_MS로 보내는 시간만큼 시뮬레이션 시계를 돌림
+// Wi-Fi가 끊기거나 브로커가 연결을 끊으면 connected()가 false (state MQTT_CONNECTION_LOST)
+// ============================================================================
+
+#define MQTT_CONNECTION_TIMEOUT -4
+#define MQTT_CONNECTION_LOST -3
+#define MQTT_CONNECT_FAILED -2
+#define MQTT_DISCONNECTED -1
+#define MQTT_CONNECTED 0
+
+#define MQTT_MAX_HEADER_SIZE 5
+#define MQTT_MAX_PACKET_SIZE 256
+
+#define MQTT_CALLBACK_SIGNATURE std::function<void(char*, uint8_t*, unsigned int)> callback
+
+MqttBroker* sim_mqtt_broker = nullptr;
+
+class PubSubClient {
+ public:
+  explicit PubSubClient(Client &) {}
+
+  PubSubClient &setServer(const char* host, uint16_t port) {
+    this->host = host;
+    this->port = port;
+    return *this;
+  }
+  PubSubClient &setCallback(MQTT_CALLBACK_SIGNATURE) {
+    this->callback = callback;
+    return *this;
+  }
+  bool setBufferSize(uint16_t size) {
+    if (size == 0) return false;
+    buffer.resize(size);
+    return true;
+  }
+  uint16_t getBufferSize() { return (uint16_t)buffer.size(); }
+
+  bool connect(const char* id) { return connect(id, nullptr, nullptr); }
+  bool connect(const char* id, const char*, const char*) {
+    if (connected()) return true;
+    if (!sim_mqtt_broker || WiFi.status() != WL_CONNECTED) {
+      rc = MQTT_CONNECT_FAILED;
+      return false;
+    }
+    roundTrip();
+    session = sim_mqtt_broker->connect(id);
+    rc = MQTT_CONNECTED;
+    return true;
+  }
+
+  bool connected() {
+    if (session < 0) return false;
+    if (WiFi.status() != WL_CONNECTED || !sim_mqtt_broker->connected(session)) {
+      session = -1;
+      rc = MQTT_CONNECTION_LOST;
+      return false;
+    }
+    return true;
+  }
+
+  bool subscribe(const char* topic, uint8_t = 0) {
+    if (!connected() || MQTT_MAX_HEADER_SIZE + 2 + strlen(topic) + 1 > buffer.size()) return false;
+    roundTrip();
+    return sim_mqtt_broker->subscribe(session, topic);
+  }
+
+  bool publish(const char* topic, const uint8_t* payload, unsigned int len, bool = false) {
+    if (!connected() || MQTT_MAX_HEADER_SIZE + 2 + strlen(topic) + len > buffer.size()) return false;
+    simAdvanceUs(1000ULL * (MQTT_MAX_HEADER_SIZE + 2 + strlen(topic) + len) / SIM_WIFI_BYTES_PER_MS);
+    return sim_mqtt_broker->publish(session, topic, payload, len, sim_now_us);
+  }
+  bool publish(const char* topic, const char* payload) {
+    return publish(topic, (const uint8_t*)payload, strlen(payload));
+  }
+
+  // 도착한 메시지를 콜백으로 (버퍼보다 크면 실제 라이브러리처럼 버림)
+  bool loop() {
+    if (!connected()) return false;
+    MqttMessage msg;
+    while (sim_mqtt_broker->poll(session, sim_now_us, msg)) {
+      if (!callback || MQTT_MAX_HEADER_SIZE + 2 + msg.topic.size() + msg.payload.size() > buffer.size()) continue;
+      std::string topic = msg.topic;
+      callback(&topic[0], msg.payload.data(), (unsigned int)msg.payload.size());
+    }
+    return true;
+  }
+
+  void disconnect() {
+    if (session >= 0) sim_mqtt_broker->disconnect(session);
+    session = -1;
+    rc = MQTT_DISCONNECTED;
+  }
+
+  int state() { return rc; }
+
+ private:
+  std::string host;
+  uint16_t port = 0;
+  std::function<void(char*, uint8_t*, unsigned int)> callback;
+  std::vector<uint8_t> buffer = std::vector<uint8_t>(MQTT_MAX_PACKET_SIZE);
+  int session = -1;
+  int rc = MQTT_DISCONNECTED;
+
+  void roundTrip() { simAdvanceUs(2 * sim_mqtt_broker->latency_us); }
+};
+
+#endif
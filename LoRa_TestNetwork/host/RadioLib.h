@@ -0,0 +1,686 @@
+#ifndef _HOST_RADIOLIB_H
+#define _HOST_RADIOLIB_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "lorawan_crypto.h"
+#include "lora_airtime.h"   // LoRa_Simulator와 같은 airtime 계산
+
+// ============================================================================
+// 호스트용 RadioLib 대체: 시뮬레이션 SX1262 + LoRaWAN 1.0.x Class A 노드
+//
+// 펌웨어(LoRaNodeCore)가 쓰는 RadioLib 7.x API만 같은 이름/상태 코드로 구현함.
+// SPI 레지스터 수준이 아니라 API 수준의 모델이고, 아래 동작은 RadioLib 7 소스 기준의 가정:
+//  - beginOTAA()는 세션을 지움 (isActivated() = false), DevNonce 카운터는 RAM에 유지
+//    (sim_nonce_reset_on_begin이면 0부터 다시 - 세션 버퍼를 복원하지 않는 재부팅과 같음)
+//  - activateOTAA(): 조인 요청 → JOIN_ACCEPT_DELAY1/2(5/6초) 수신 윈도우, 수락이면 NEW_SESSION,
+//    아무것도 못 받으면 RADIOLIB_ERR_NO_JOIN_ACCEPT
+//  - sendReceive(): 확인 없는 업링크 후 RX1/RX2, 다운링크를 받으면 윈도우 번호(1, 2), 없으면 ERR_NONE
+//    (다운링크가 없어도 성공 - 게이트웨이/서버 장애는 노드가 알 수 없음)
+//  - 다운링크 MIC/FCnt 오류는 음수 상태 코드로 반환 (업링크 자체는 전송됨)
+//  - ADR 백오프: ADR_ACK_LIMIT 업링크 동안 다운링크가 없으면 ADRACKReq, 이후 ADR_ACK_DELAY마다 DR 한 단계 낮춤
+//  - 수신 윈도우까지는 hal->delay()로 기다림 → LoRaSleepHal의 Light Sleep 경로가 그대로 실행됨
+//
+// 칩 장애는 sim_radio_faults 시각에 맞춰 발생 (멈춤/브라운아웃/TX 멈춤은 radio.begin()이 풀어 줌)
+// 업링크는 sim_air_uplink()로 게이트웨이(네트워크 서버)에 전달됨
+// ============================================================================
+
+#define RADIOLIB_VERSION_MAJOR 7
+
+#define RADIOLIB_ERR_NONE 0
+#define RADIOLIB_ERR_UNKNOWN -1
+#define RADIOLIB_ERR_CHIP_NOT_FOUND -2
+#define RADIOLIB_ERR_PACKET_TOO_LONG -4
+#define RADIOLIB_ERR_TX_TIMEOUT -5
+#define RADIOLIB_ERR_RX_TIMEOUT -6
+#define RADIOLIB_ERR_CRC_MISMATCH -7
+#define RADIOLIB_ERR_INVALID_BANDWIDTH -8
+#define RADIOLIB_ERR_INVALID_SPREADING_FACTOR -9
+#define RADIOLIB_ERR_INVALID_CODING_RATE -10
+#define RADIOLIB_ERR_INVALID_FREQUENCY -12
+#define RADIOLIB_ERR_INVALID_OUTPUT_POWER -13
+#define RADIOLIB_ERR_SPI_WRITE_FAILED -16
+#define RADIOLIB_ERR_SPI_CMD_TIMEOUT -705
+#define RADIOLIB_ERR_SPI_CMD_INVALID -706
+#define RADIOLIB_ERR_SPI_CMD_FAILED -707
+#define RADIOLIB_ERR_INVALID_DATA_RATE -1100
+#define RADIOLIB_ERR_NETWORK_NOT_JOINED -1101
+#define RADIOLIB_ERR_DOWNLINK_MALFORMED -1102
+#define RADIOLIB_ERR_INVALID_REVISION -1103
+#define RADIOLIB_ERR_INVALID_PORT -1104
+#define RADIOLIB_ERR_NO_RX_WINDOW -1105
+#define RADIOLIB_ERR_INVALID_CID -1106
+#define RADIOLIB_ERR_UPLINK_UNAVAILABLE -1107
+#define RADIOLIB_ERR_COMMAND_QUEUE_FULL -1108
+#define RADIOLIB_ERR_COMMAND_QUEUE_ITEM_NOT_FOUND -1109
+#define RADIOLIB_ERR_JOIN_NONCE_INVALID -1110
+#define RADIOLIB_ERR_MIC_MISMATCH -1111
+#define RADIOLIB_ERR_MULTICAST_FCNT_INVALID -1112
+#define RADIOLIB_ERR_DWELL_TIME_EXCEEDED -1113
+#define RADIOLIB_ERR_CHECKSUM_MISMATCH -1114
+#define RADIOLIB_ERR_NO_JOIN_ACCEPT -1115
+#define RADIOLIB_LORAWAN_SESSION_RESTORED -1116
+#define RADIOLIB_LORAWAN_NEW_SESSION -1117
+#define RADIOLIB_ERR_NONCES_DISCARDED -1118
+#define RADIOLIB_ERR_SESSION_DISCARDED -1119
+
+#define RADIOLIB_LORAWAN_MAC_LINK_CHECK 0x02
+#define RADIOLIB_LORAWAN_MAC_LINK_ADR 0x03
+#define RADIOLIB_LORAWAN_MAC_DEVICE_TIME 0x0D
+#define RADIOLIB_LORAWAN_DATA_RATE_UNUSED 0xFF
+
+#define RADIOLIB_LORAWAN_ADR_ACK_LIMIT 64
+#define RADIOLIB_LORAWAN_ADR_ACK_DELAY 32
+
+typedef unsigned long RadioLibTime_t;
+
+// ---- 시뮬레이션 설정/공중 인터페이스 ----
+
+#define SIM_SX1262_BEGIN_US 12000       // radio.begin() (리셋 + 보정) 소요 시간
+#define SIM_SX1262_SPI_US 40            // 레지스터 읽기 한 번
+#define SIM_TX_TIMEOUT_FACTOR 1.5       // TX 완료 인터럽트 대기 한도 (airtime 배수)
+#define SIM_GPS_EPOCH_OFFSET_S 315964800UL  // Unix → GPS 시각 (1980-01-06)
+#define SIM_GPS_LEAP_SECONDS 18
+
+#define SIM_FRAME_MAX 256
+
+// 공중 프레임 (업링크: 노드 → 게이트웨이, 다운링크: 게이트웨이 → 노드)
+struct SimAirFrame {
+  uint8_t data[SIM_FRAME_MAX];
+  size_t len;
+  uint8_t datarate;
+  uint32_t freq_hz;
+  uint8_t window;      // 다운링크 수신 윈도우 (1, 2)
+  float rssi;
+  float snr;
+};
+
+// 업링크 전송이 끝난 순간 호출됨 (main.cpp가 게이트웨이/네트워크 서버에 연결), 다운링크가 있으면 true
+bool (*sim_air_uplink)(const SimAirFrame &uplink, SimAirFrame &downlink) = nullptr;
+
+// 칩 장애 일정 (µs, UINT64_MAX = 없음)
+struct SimRadioFaults {
+  uint64_t dead_from_us;     // 이 구간 동안 SPI 응답 없음 (전원/납땜 불량), begin()도 실패
+  uint64_t dead_until_us;
+  uint64_t hang_at_us;       // 이후 첫 접근에서 칩 멈춤 (BUSY HIGH 고정, SPI 타임아웃)
+  uint64_t brownout_at_us;   // 이후 첫 접근에서 칩 자체 리셋 (동기 워드/TCXO 설정 잃음 → TX 타임아웃)
+  uint64_t tx_stall_at_us;   // 이후 첫 TX에서 TX 완료 인터럽트가 오지 않음
+};
+
+SimRadioFaults sim_radio_faults = {UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX};
+
+// 무선 통계 (보고용)
+struct SimRadioStats {
+  uint32_t begins;
+  uint32_t join_requests;
+  uint32_t uplinks;
+  uint32_t tx_errors;
+  double airtime_ms;
+  uint64_t first_join_us;    // 전원 인가 후 첫 조인 수락까지 (0 = 아직)
+  uint32_t joins;            // 조인 수락 횟수
+};
+
+SimRadioStats sim_radio_stats = {};
+bool sim_nonce_reset_on_begin = false;
+
+// ---- HAL ----
+
+class RadioLibHal {
+ public:
+  virtual ~RadioLibHal() {}
+  virtual void delay(RadioLibTime_t ms) = 0;
+  virtual void delayMicroseconds(RadioLibTime_t us) = 0;
+  virtual RadioLibTime_t millis() = 0;
+  virtual RadioLibTime_t micros() = 0;
+  virtual void attachInterrupt(uint32_t, void (*)(void), uint32_t) {}
+  virtual void detachInterrupt(uint32_t) {}
+  virtual void spiBeginTransaction() {}
+  virtual void spiEndTransaction() {}
+};
+
+class ArduinoHal : public RadioLibHal {
+ public:
+  void delay(RadioLibTime_t ms) override { ::delay(ms); }
+  void delayMicroseconds(RadioLibTime_t us) override { ::delayMicroseconds(us); }
+  RadioLibTime_t millis() override { return ::millis(); }
+  RadioLibTime_t micros() override { return ::micros(); }
+  void attachInterrupt(uint32_t, void (*)(void), uint32_t) override {}
+  void detachInterrupt(uint32_t) override {}
+};
+
+class SX1262;
+
+class Module {
+ public:
+  Module(RadioLibHal* hal, uint32_t cs, uint32_t irq, uint32_t rst, uint32_t gpio)
+      : hal(hal), cs(cs), irq(irq), rst(rst), gpio(gpio) {}
+
+  int16_t SPIreadRegisterBurst(uint16_t reg, size_t len, uint8_t* data);
+
+  RadioLibHal* hal;
+  SX1262* chip = nullptr;
+  uint32_t cs, irq, rst, gpio;
+};
+
+// ---- SX1262 ----
+
+class PhysicalLayer {
+ public:
+  virtual ~PhysicalLayer() {}
+};
+
+class SX1262 : public PhysicalLayer {
+ public:
+  SX1262(Module* mod) : mod(mod) {
+    mod->chip = this;
+    active = this;
+  }
+
+  // 리셋 핀 + 기본 설정 (멈춤/브라운아웃/TX 멈춤은 여기서 풀림)
+  int16_t begin(float = 434.0, float = 125.0, uint8_t = 9, uint8_t = 7, uint8_t = 0x12, int8_t = 10,
+                uint16_t = 8, float = 1.6, bool = false) {
+    sim_radio_stats.begins++;
+    simAdvanceUs(SIM_SX1262_BEGIN_US);
+    applyFaults();
+    if (dead) return RADIOLIB_ERR_CHIP_NOT_FOUND;
+    hung = false;
+    stalled = false;
+    tcxo_ok = true;
+    sync_word = 0x1424;
+    return RADIOLIB_ERR_NONE;
+  }
+
+  float getRSSI() { return last_rssi; }
+  float getSNR() { return last_snr; }
+  Module* getMod() { return mod; }
+
+  // 일정된 장애를 현재 시각에 반영
+  void applyFaults() {
+    const SimRadioFaults &f = sim_radio_faults;
+    dead = sim_now_us >= f.dead_from_us && sim_now_us < f.dead_until_us;
+    if (sim_now_us >= f.hang_at_us && !hang_done) {
+      hang_done = true;
+      hung = true;
+    }
+    if (sim_now_us >= f.brownout_at_us && !brownout_done) {
+      brownout_done = true;
+      sync_word = 0x1424;
+      tcxo_ok = false;
+    }
+    if (sim_now_us >= f.tx_stall_at_us && !stall_done) {
+      stall_done = true;
+      stalled = true;
+    }
+  }
+
+  // SPI 접근 가능 여부 (RadioLib SPI 상태 바이트 검사와 같은 결과)
+  int16_t spiState() {
+    applyFaults();
+    if (dead) return RADIOLIB_ERR_CHIP_NOT_FOUND;
+    if (hung) return RADIOLIB_ERR_SPI_CMD_TIMEOUT;
+    return RADIOLIB_ERR_NONE;
+  }
+
+  // 전송: airtime만큼 시간이 흐르고, 칩이 정상이면 RADIOLIB_ERR_NONE
+  int16_t transmit(double airtime_ms) {
+    int16_t state = spiState();
+    if (state != RADIOLIB_ERR_NONE) return state;
+    if (stalled || !tcxo_ok) {
+      simAdvanceUs((uint64_t)(airtime_ms * SIM_TX_TIMEOUT_FACTOR * 1000.0));
+      return RADIOLIB_ERR_TX_TIMEOUT;
+    }
+    sync_word = 0x3444;  // LoRaWAN 스택이 PHY 설정 (공개 동기 워드)
+    simAdvanceUs((uint64_t)(airtime_ms * 1000.0));
+    return RADIOLIB_ERR_NONE;
+  }
+
+  static SX1262* active;
+
+  Module* mod;
+  uint16_t sync_word = 0;
+  float last_rssi = 0.0f;
+  float last_snr = 0.0f;
+  bool dead = false;
+  bool hung = false;
+  bool stalled = false;
+  bool tcxo_ok = true;
+
+ private:
+  bool hang_done = false;
+  bool brownout_done = false;
+  bool stall_done = false;
+};
+
+SX1262* SX1262::active = nullptr;
+
+int16_t Module::SPIreadRegisterBurst(uint16_t reg, size_t len, uint8_t* data) {
+  simAdvanceUs(SIM_SX1262_SPI_US);
+  int16_t state = chip->spiState();
+  if (state != RADIOLIB_ERR_NONE) return state;
+  for (size_t i = 0; i < len; i++) {
+    uint16_t r = reg + i;
+    data[i] = r == 0x0740 ? chip->sync_word >> 8 : r == 0x0741 ? chip->sync_word & 0xFF : 0x00;
+  }
+  return RADIOLIB_ERR_NONE;
+}
+
+// BUSY(13)는 멈춘 칩에서 HIGH 고정, DIO1(14)은 항상 LOW (수신은 동기적으로 처리)
+int simRadioPin(uint8_t pin) {
+  SX1262* chip = SX1262::active;
+  if (!chip || pin != chip->mod->gpio) return LOW;
+  chip->applyFaults();
+  return chip->hung ? HIGH : LOW;
+}
+
+// ---- LoRaWAN 1.0.x 노드 (KR920) ----
+
+struct LoRaWANBand_t {
+  uint32_t channels_hz[3];   // 기본 업링크 채널
+  uint32_t rx2_freq_hz;
+  uint8_t rx2_datarate;
+  uint8_t max_payload[6];    // DR별 최대 애플리케이션 페이로드 (FOpts 포함)
+};
+
+const LoRaWANBand_t KR920 = {{922100000, 922300000, 922500000}, 921900000, 0, {51, 51, 51, 115, 242, 242}};
+
+struct LoRaWANEvent_t {
+  uint8_t dir;
+  bool confirmed;
+  bool confirming;
+  bool frmPending;
+  uint8_t datarate;
+  float freq;
+  int16_t power;
+  uint32_t fCnt;
+  uint8_t fPort;
+  uint8_t port;        // 6.x 이름 (lorawan_config.h downlinkPort())
+  uint8_t multicast;
+};
+
+struct LoRaWANJoinEvent_t {
+  bool newSession;
+  bool savedSession;
+};
+
+#define SIM_JOIN_ACCEPT_DELAY1_MS 5000
+#define SIM_JOIN_ACCEPT_DELAY2_MS 6000
+#define SIM_FOPTS_MAX 15
+
+class LoRaWANNode {
+ public:
+  LoRaWANNode(PhysicalLayer* phy, const LoRaWANBand_t* band, uint8_t subBand = 0)
+      : phy(static_cast<SX1262*>(phy)), band(band) {
+    (void)subBand;
+  }
+
+  int16_t beginOTAA(uint64_t joinEUI, uint64_t devEUI, const uint8_t* nwkKey, const uint8_t* appKey) {
+    join_eui = joinEUI;
+    dev_eui = devEUI;
+    memcpy(nwk_key, nwkKey, AES_BLOCK_SIZE);
+    (void)appKey;  // 1.0.x: 루트 키 하나 (NwkKey)
+    active = false;
+    if (sim_nonce_reset_on_begin) dev_nonce = 0;
+    return RADIOLIB_ERR_NONE;
+  }
+
+  int16_t activateOTAA(uint8_t joinDr = RADIOLIB_LORAWAN_DATA_RATE_UNUSED, LoRaWANJoinEvent_t* joinEvent = nullptr) {
+    if (active) return RADIOLIB_ERR_NONE;
+    uint8_t dr = joinDr == RADIOLIB_LORAWAN_DATA_RATE_UNUSED ? 0 : joinDr;
+
+    // 조인 요청: [MHDR][JoinEUI][DevEUI][DevNonce][MIC]
+    dev_nonce++;
+    SimAirFrame up = {};
+    up.data[0] = 0x00;
+    putLe(up.data + 1, join_eui, 8);
+    putLe(up.data + 9, dev_eui, 8);
+    putLe(up.data + 17, dev_nonce, 2);
+    putLe(up.data + 19, lorawanJoinMic(nwk_key, up.data, 19), 4);
+    up.len = LORAWAN_JOIN_REQUEST_SIZE;
+    sim_radio_stats.join_requests++;
+
+    SimAirFrame down;
+    bool heard;
+    int16_t state = transmitFrame(up, dr, down, heard);
+    if (state != RADIOLIB_ERR_NONE) return state;
+    if (!receiveWindows(up, down, heard, SIM_JOIN_ACCEPT_DELAY1_MS, SIM_JOIN_ACCEPT_DELAY2_MS)) {
+      return RADIOLIB_ERR_NO_JOIN_ACCEPT;
+    }
+
+    // 조인 수락: MHDR 뒤를 AES 암호화(= 서버의 복호화 역연산)로 풂
+    if (down.len != 17 && down.len != LORAWAN_JOIN_ACCEPT_SIZE) return RADIOLIB_ERR_DOWNLINK_MALFORMED;
+    if (down.data[0] != 0x20) return RADIOLIB_ERR_DOWNLINK_MALFORMED;
+    for (size_t i = 1; i < down.len; i += AES_BLOCK_SIZE) aes128Encrypt(nwk_key, down.data + i, down.data + i);
+    uint32_t mic = getLe(down.data + down.len - LORAWAN_MIC_SIZE, 4);
+    if (lorawanJoinMic(nwk_key, down.data, down.len - LORAWAN_MIC_SIZE) != mic) return RADIOLIB_ERR_MIC_MISMATCH;
+
+    uint32_t nonce = getLe(down.data + 1, 3);
+    if (has_join_nonce && nonce <= join_nonce) return RADIOLIB_ERR_JOIN_NONCE_INVALID;
+    join_nonce = nonce;
+    has_join_nonce = true;
+
+    uint32_t net_id = getLe(down.data + 4, 3);
+    dev_addr = getLe(down.data + 7, 4);
+    rx1_delay_ms = (down.data[12] & 0x0F ? down.data[12] & 0x0F : 1) * 1000UL;
+    lorawanSessionKey(nwk_key, 0x01, join_nonce, net_id, dev_nonce, nwk_skey);
+    lorawanSessionKey(nwk_key, 0x02, join_nonce, net_id, dev_nonce, app_skey);
+
+    fcnt_up = 0;
+    fcnt_down = 0;
+    has_fcnt_down = false;
+    datarate = dr;
+    adr_ack_cnt = 0;
+    mac_req_count = 0;
+    mac_ans_len = 0;
+    link_check_valid = false;
+    device_time_valid = false;
+    active = true;
+
+    sim_radio_stats.joins++;
+    if (!sim_radio_stats.first_join_us) sim_radio_stats.first_join_us = sim_now_us;
+    if (joinEvent) joinEvent->newSession = true;
+    return RADIOLIB_LORAWAN_NEW_SESSION;
+  }
+
+  bool isActivated() { return active; }
+
+  int16_t sendReceive(const uint8_t* dataUp, size_t lenUp, uint8_t fPort, uint8_t* dataDown, size_t* lenDown,
+                      bool isConfirmed = false, LoRaWANEvent_t* eventUp = nullptr,
+                      LoRaWANEvent_t* eventDown = nullptr) {
+    (void)isConfirmed;
+    if (lenDown) *lenDown = 0;
+    if (!active) return RADIOLIB_ERR_NETWORK_NOT_JOINED;
+    if (fPort == 0 || fPort > 223) return RADIOLIB_ERR_INVALID_PORT;
+
+    // FOpts: 밀린 MAC 응답 + 요청 (LinkCheckReq, DeviceTimeReq)
+    uint8_t fopts[SIM_FOPTS_MAX];
+    uint8_t fopts_len = 0;
+    memcpy(fopts, mac_ans, mac_ans_len);
+    fopts_len = mac_ans_len;
+    for (uint8_t i = 0; i < mac_req_count && fopts_len < SIM_FOPTS_MAX; i++) fopts[fopts_len++] = mac_req[i];
+    if (lenUp + fopts_len > band->max_payload[datarate]) return RADIOLIB_ERR_PACKET_TOO_LONG;
+
+    // ADR 백오프
+    bool adr_ack_req = false;
+    if (adr_enabled) {
+      if (adr_ack_cnt >= RADIOLIB_LORAWAN_ADR_ACK_LIMIT) adr_ack_req = true;
+      if (adr_ack_cnt >= RADIOLIB_LORAWAN_ADR_ACK_LIMIT + RADIOLIB_LORAWAN_ADR_ACK_DELAY) {
+        if (datarate > 0) datarate--;
+        adr_ack_cnt = RADIOLIB_LORAWAN_ADR_ACK_LIMIT;
+      }
+    }
+
+    // [MHDR][DevAddr][FCtrl][FCnt][FOpts][FPort][FRMPayload][MIC]
+    SimAirFrame up = {};
+    size_t pos = 0;
+    up.data[pos++] = 0x40;
+    putLe(up.data + pos, dev_addr, 4);
+    pos += 4;
+    up.data[pos++] = (adr_enabled ? 0x80 : 0) | (adr_ack_req ? 0x40 : 0) | fopts_len;
+    putLe(up.data + pos, fcnt_up, 2);
+    pos += 2;
+    memcpy(up.data + pos, fopts, fopts_len);
+    pos += fopts_len;
+    up.data[pos++] = fPort;
+    memcpy(up.data + pos, dataUp, lenUp);
+    lorawanCryptPayload(app_skey, LORAWAN_DIR_UPLINK, dev_addr, fcnt_up, up.data + pos, lenUp);
+    pos += lenUp;
+    putLe(up.data + pos, lorawanDataMic(nwk_skey, LORAWAN_DIR_UPLINK, dev_addr, fcnt_up, up.data, pos), 4);
+    up.len = pos + LORAWAN_MIC_SIZE;
+
+    SimAirFrame down;
+    bool heard;
+    int16_t state = transmitFrame(up, datarate, down, heard);
+    if (state != RADIOLIB_ERR_NONE) return state;
+
+    if (eventUp) {
+      *eventUp = LoRaWANEvent_t();
+      eventUp->dir = LORAWAN_DIR_UPLINK;
+      eventUp->datarate = datarate;
+      eventUp->freq = up.freq_hz / 1e6f;
+      eventUp->power = tx_power;
+      eventUp->fCnt = fcnt_up;
+      eventUp->fPort = eventUp->port = fPort;
+    }
+    fcnt_up++;
+    mac_ans_len = 0;
+    mac_req_count = 0;
+    link_check_valid = false;
+    device_time_valid = false;
+    if (adr_ack_cnt < 0xFFFF) adr_ack_cnt++;
+
+    if (!receiveWindows(up, down, heard, rx1_delay_ms, rx1_delay_ms + 1000)) return RADIOLIB_ERR_NONE;
+    adr_ack_cnt = 0;
+
+    uint8_t port = 0;
+    size_t payload_len = 0;
+    state = parseDownlink(down, dataDown, &payload_len, port);
+    if (state != RADIOLIB_ERR_NONE) return state;
+    if (lenDown) *lenDown = payload_len;
+
+    if (eventDown) {
+      *eventDown = LoRaWANEvent_t();
+      eventDown->dir = LORAWAN_DIR_DOWNLINK;
+      eventDown->datarate = down.datarate;
+      eventDown->freq = down.freq_hz / 1e6f;
+      eventDown->fCnt = fcnt_down;
+      eventDown->fPort = eventDown->port = port;
+    }
+    return down.window;
+  }
+
+  void setADR(bool enable) { adr_enabled = enable; }
+
+  int16_t setDatarate(uint8_t dr) {
+    if (dr > KR920_MAX_DATARATE) return RADIOLIB_ERR_INVALID_DATA_RATE;
+    datarate = dr;
+    return RADIOLIB_ERR_NONE;
+  }
+
+  int16_t setTxPower(int8_t power) {
+    if (power < 0 || power > 22) return RADIOLIB_ERR_INVALID_OUTPUT_POWER;
+    tx_power = power;
+    return RADIOLIB_ERR_NONE;
+  }
+
+  int16_t sendMacCommandReq(uint8_t cid) {
+    if (cid != RADIOLIB_LORAWAN_MAC_LINK_CHECK && cid != RADIOLIB_LORAWAN_MAC_DEVICE_TIME) {
+      return RADIOLIB_ERR_INVALID_CID;
+    }
+    for (uint8_t i = 0; i < mac_req_count; i++) {
+      if (mac_req[i] == cid) return RADIOLIB_ERR_NONE;
+    }
+    if (mac_req_count >= sizeof(mac_req)) return RADIOLIB_ERR_COMMAND_QUEUE_FULL;
+    mac_req[mac_req_count++] = cid;
+    return RADIOLIB_ERR_NONE;
+  }
+
+  int16_t getMacLinkCheckAns(uint8_t* margin, uint8_t* gwCnt) {
+    if (!link_check_valid) return RADIOLIB_ERR_COMMAND_QUEUE_ITEM_NOT_FOUND;
+    if (margin) *margin = link_check_margin;
+    if (gwCnt) *gwCnt = link_check_gateways;
+    return RADIOLIB_ERR_NONE;
+  }
+
+  int16_t getMacDeviceTimeAns(uint32_t* gpsEpoch, uint8_t* fraction, bool returnUnix = true) {
+    if (!device_time_valid) return RADIOLIB_ERR_COMMAND_QUEUE_ITEM_NOT_FOUND;
+    if (gpsEpoch) *gpsEpoch = returnUnix ? device_time_gps + SIM_GPS_EPOCH_OFFSET_S - SIM_GPS_LEAP_SECONDS
+                                         : device_time_gps;
+    if (fraction) *fraction = device_time_fraction;
+    return RADIOLIB_ERR_NONE;
+  }
+
+  RadioLibTime_t getLastToA() { return (RadioLibTime_t)last_toa_ms; }
+  uint32_t getFCntUp() { return fcnt_up; }
+  uint32_t getDevAddr() { return dev_addr; }
+  uint8_t getDatarate() const { return datarate; }
+
+ private:
+  static void putLe(uint8_t* out, uint64_t v, int n) {
+    for (int i = 0; i < n; i++) out[i] = (uint8_t)(v >> (8 * i));
+  }
+
+  static uint32_t getLe(const uint8_t* in, int n) {
+    uint32_t v = 0;
+    for (int i = 0; i < n; i++) v |= (uint32_t)in[i] << (8 * i);
+    return v;
+  }
+
+  // 칩으로 전송 후 게이트웨이에 전달 (heard: 다운링크 예약 여부)
+  int16_t transmitFrame(SimAirFrame &up, uint8_t dr, SimAirFrame &down, bool &heard) {
+    up.datarate = dr;
+    up.freq_hz = band->channels_hz[esp_random() % 3];
+    last_toa_ms = loraAirtimeMs(datarateToSf(dr), up.len);
+
+    int16_t state = phy->transmit(last_toa_ms);
+    if (state != RADIOLIB_ERR_NONE) {
+      sim_radio_stats.tx_errors++;
+      return state;
+    }
+    sim_radio_stats.uplinks++;
+    sim_radio_stats.airtime_ms += last_toa_ms;
+    heard = sim_air_uplink && sim_air_uplink(up, down);
+    return RADIOLIB_ERR_NONE;
+  }
+
+  // TX 끝에서 RX1/RX2까지 hal->delay()로 대기 후 수신 (받으면 true, 시간은 프레임 끝까지 흐름)
+  bool receiveWindows(const SimAirFrame &up, SimAirFrame &down, bool heard, uint32_t rx1_ms, uint32_t rx2_ms) {
+    RadioLibHal* hal = phy->getMod()->hal;
+    uint64_t tx_end = sim_now_us;
+
+    for (uint8_t window = 1; window <= 2; window++) {
+      uint64_t open = tx_end + (window == 1 ? rx1_ms : rx2_ms) * 1000ULL;
+      if (sim_now_us < open) hal->delay((open - sim_now_us + 999) / 1000);
+      uint8_t dr = window == 1 ? up.datarate : band->rx2_datarate;
+      if (phy->spiState() != RADIOLIB_ERR_NONE) continue;
+
+      if (heard && down.window == window) {
+        down.datarate = dr;
+        down.freq_hz = window == 1 ? up.freq_hz : band->rx2_freq_hz;
+        simAdvanceUs((uint64_t)(loraAirtimeMs(datarateToSf(dr), down.len) * 1000.0));
+        phy->last_rssi = down.rssi;
+        phy->last_snr = down.snr;
+        return true;
+      }
+      simAdvanceUs((uint64_t)(loraRxWindowMs(datarateToSf(dr)) * 1000.0));
+    }
+    return false;
+  }
+
+  // 다운링크 검증/복호화 후 MAC 명령 처리
+  int16_t parseDownlink(SimAirFrame &down, uint8_t* payload, size_t* payload_len, uint8_t &port) {
+    if (down.len < 12 || (down.data[0] != 0x60 && down.data[0] != 0xA0)) return RADIOLIB_ERR_DOWNLINK_MALFORMED;
+    if (getLe(down.data + 1, 4) != dev_addr) return RADIOLIB_ERR_DOWNLINK_MALFORMED;
+
+    uint8_t fctrl = down.data[5];
+    uint8_t fopts_len = fctrl & 0x0F;
+    uint16_t fcnt16 = getLe(down.data + 6, 2);
+    uint32_t fcnt = (fcnt_down & 0xFFFF0000UL) | fcnt16;
+    if (has_fcnt_down && fcnt <= fcnt_down) fcnt += 0x10000;
+
+    size_t mic_pos = down.len - LORAWAN_MIC_SIZE;
+    uint32_t mic = getLe(down.data + mic_pos, 4);
+    if (lorawanDataMic(nwk_skey, LORAWAN_DIR_DOWNLINK, dev_addr, fcnt, down.data, mic_pos) != mic) {
+      return RADIOLIB_ERR_MIC_MISMATCH;
+    }
+    fcnt_down = fcnt;
+    has_fcnt_down = true;
+
+    size_t pos = 8;
+    const uint8_t* mac = down.data + pos;
+    size_t mac_len = fopts_len;
+    pos += fopts_len;
+
+    port = 0;
+    *payload_len = 0;
+    if (pos < mic_pos) {
+      port = down.data[pos++];
+      size_t len = mic_pos - pos;
+      lorawanCryptPayload(port == 0 ? nwk_skey : app_skey, LORAWAN_DIR_DOWNLINK, dev_addr, fcnt, down.data + pos, len);
+      if (port == 0) {
+        mac = down.data + pos;
+        mac_len = len;
+      } else if (payload) {
+        memcpy(payload, down.data + pos, len);
+        *payload_len = len;
+      }
+    }
+    return parseMac(mac, mac_len);
+  }
+
+  int16_t parseMac(const uint8_t* mac, size_t len) {
+    size_t pos = 0;
+    while (pos < len) {
+      uint8_t cid = mac[pos++];
+      switch (cid) {
+        case RADIOLIB_LORAWAN_MAC_LINK_CHECK:
+          if (pos + 2 > len) return RADIOLIB_ERR_DOWNLINK_MALFORMED;
+          link_check_margin = mac[pos];
+          link_check_gateways = mac[pos + 1];
+          link_check_valid = true;
+          pos += 2;
+          break;
+        case RADIOLIB_LORAWAN_MAC_LINK_ADR: {
+          // [DR | TXPower][ChMask 2][Redundancy] → LinkADRAns (모두 수락)
+          if (pos + 4 > len) return RADIOLIB_ERR_DOWNLINK_MALFORMED;
+          uint8_t dr = mac[pos] >> 4;
+          if (adr_enabled && dr <= KR920_MAX_DATARATE) datarate = dr;
+          pos += 4;
+          if (mac_ans_len + 2 <= (int)sizeof(mac_ans)) {
+            mac_ans[mac_ans_len++] = RADIOLIB_LORAWAN_MAC_LINK_ADR;
+            mac_ans[mac_ans_len++] = adr_enabled ? 0x07 : 0x06;
+          }
+          break;
+        }
+        case RADIOLIB_LORAWAN_MAC_DEVICE_TIME:
+          if (pos + 5 > len) return RADIOLIB_ERR_DOWNLINK_MALFORMED;
+          device_time_gps = getLe(mac + pos, 4);
+          device_time_fraction = mac[pos + 4];
+          device_time_valid = true;
+          pos += 5;
+          break;
+        default:
+          return RADIOLIB_ERR_INVALID_CID;  // 알 수 없는 명령 뒤는 길이를 몰라 해석 불가
+      }
+    }
+    return RADIOLIB_ERR_NONE;
+  }
+
+  SX1262* phy;
+  const LoRaWANBand_t* band;
+
+  uint64_t join_eui = 0;
+  uint64_t dev_eui = 0;
+  uint8_t nwk_key[AES_BLOCK_SIZE] = {};
+  uint16_t dev_nonce = 0;
+  uint32_t join_nonce = 0;
+  bool has_join_nonce = false;
+
+  bool active = false;
+  uint32_t dev_addr = 0;
+  uint8_t nwk_skey[AES_BLOCK_SIZE] = {};
+  uint8_t app_skey[AES_BLOCK_SIZE] = {};
+  uint32_t fcnt_up = 0;
+  uint32_t fcnt_down = 0;
+  bool has_fcnt_down = false;
+  uint32_t rx1_delay_ms = 1000;
+
+  uint8_t datarate = 0;
+  int8_t tx_power = 14;
+  bool adr_enabled = true;
+  uint16_t adr_ack_cnt = 0;
+  double last_toa_ms = 0;
+
+  uint8_t mac_req[4] = {};
+  uint8_t mac_req_count = 0;
+  uint8_t mac_ans[8] = {};
+  uint8_t mac_ans_len = 0;
+
+  bool link_check_valid = false;
+  uint8_t link_check_margin = 0;
+  uint8_t link_check_gateways = 0;
+  bool device_time_valid = false;
+  uint32_t device_time_gps = 0;
+  uint8_t device_time_fraction = 0;
+};
+
+#endif
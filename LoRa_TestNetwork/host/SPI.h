@@ -0,0 +1,25 @@
+#ifndef _HOST_SPI_H
+#define _HOST_SPI_H
+
+#include <Arduino.h>
+
+// SX1262는 RadioLib API 수준에서 시뮬레이션하므로 SPI 버스는 아무것도 하지 않음
+
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+class SPISettings {
+ public:
+  SPISettings() {}
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass {
+ public:
+  void begin(int8_t = -1, int8_t = -1, int8_t = -1, int8_t = -1) {}
+  void end() {}
+};
+
+SPIClass SPI;
+
+#endif
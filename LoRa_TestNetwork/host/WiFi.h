@@ -0,0 +1,125 @@
+#ifndef _HOST_WIFI_H
+#define _HOST_WIFI_H
+
+#include <Arduino.h>
+#include <Client.h>
+
+// ============================================================================
+// ESP32 WiFi 대체 (Wi-Fi 백홀 NODE_WIFI_BACKHAUL 테스트)
+//
+// AP 하나(sim_wifi_ap)가 정해진 시각 구간에만 보임. 스캔/연결은 실제 걸리는 시간만큼 시뮬레이션 시계를 돌림
+//  - scanNetworks(): 채널당 max_ms_per_chan (channel 0이면 13채널), SSID가 맞고 구간 안이면 1개
+//  - begin() 후 SIM_WIFI_CONNECT_US 지나면 WL_CONNECTED (비밀번호가 틀리면 WL_CONNECT_FAILED)
+//  - 구간이 끝나면 WL_CONNECTION_LOST
+//  - 전원이 켜져 있던 시간(모드가 WIFI_OFF가 아닌 동안)을 sim_wifi_stats에 기록
+// ============================================================================
+
+#define SIM_WIFI_CONNECT_US 1200000ULL    // 인증 + 연결 + DHCP
+#define SIM_WIFI_BYTES_PER_MS 500         // 실효 TCP 처리량 (약 4Mbit/s)
+#define SIM_WIFI_CHANNELS 13
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_SCAN_COMPLETED = 2,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+
+struct SimWifiAp {
+  std::string ssid;
+  std::string pass;
+  uint64_t from_us;      // 보이는 구간 [from, until)
+  uint64_t until_us;
+  int32_t rssi;
+};
+
+struct SimWifiStats {
+  uint32_t scans;
+  uint32_t connects;
+  uint64_t on_us;        // Wi-Fi 전원이 켜져 있던 시간 합
+  uint64_t longest_us;   // 가장 길게 켜져 있던 한 번
+};
+
+SimWifiAp sim_wifi_ap = {"", "", 0, 0, -60};
+SimWifiStats sim_wifi_stats = {};
+
+inline bool simWifiApVisible() { return sim_now_us >= sim_wifi_ap.from_us && sim_now_us < sim_wifi_ap.until_us; }
+
+class WiFiClass {
+ public:
+  bool mode(wifi_mode_t m) {
+    if (m != WIFI_OFF && current == WIFI_OFF) on_since_us = sim_now_us;
+    if (m == WIFI_OFF && current != WIFI_OFF) {
+      uint64_t on = sim_now_us - on_since_us;
+      sim_wifi_stats.on_us += on;
+      sim_wifi_stats.longest_us = std::max(sim_wifi_stats.longest_us, on);
+      joined = false;
+      begun = false;
+    }
+    current = m;
+    return true;
+  }
+  wifi_mode_t getMode() { return current; }
+
+  int16_t scanNetworks(bool = false, bool = false, bool = false, uint32_t max_ms_per_chan = 300, uint8_t channel = 0,
+                       const char* ssid = nullptr, const uint8_t* = nullptr) {
+    if (current == WIFI_OFF) return -2;
+    simAdvanceUs((uint64_t)max_ms_per_chan * 1000 * (channel ? 1 : SIM_WIFI_CHANNELS));
+    sim_wifi_stats.scans++;
+    scan_count = simWifiApVisible() && (!ssid || sim_wifi_ap.ssid == ssid) ? 1 : 0;
+    return scan_count;
+  }
+  int32_t RSSI(uint8_t) { return scan_count ? sim_wifi_ap.rssi : 0; }
+  int32_t RSSI() { return joined ? sim_wifi_ap.rssi : 0; }
+  void scanDelete() { scan_count = 0; }
+
+  wl_status_t begin(const char* ssid, const char* pass = nullptr) {
+    begun = current != WIFI_OFF;
+    joined = false;
+    ssid_ok = sim_wifi_ap.ssid == ssid;
+    pass_ok = sim_wifi_ap.pass == (pass ? pass : "");
+    connect_at_us = sim_now_us + SIM_WIFI_CONNECT_US;
+    return status();
+  }
+
+  wl_status_t status() {
+    if (!begun) return WL_IDLE_STATUS;
+    if (!ssid_ok || !simWifiApVisible()) {
+      wl_status_t s = joined ? WL_CONNECTION_LOST : WL_NO_SSID_AVAIL;
+      joined = false;
+      return s;
+    }
+    if (!pass_ok) return WL_CONNECT_FAILED;
+    if (sim_now_us < connect_at_us) return WL_DISCONNECTED;
+    if (!joined) sim_wifi_stats.connects++;
+    joined = true;
+    return WL_CONNECTED;
+  }
+
+  bool isConnected() { return status() == WL_CONNECTED; }
+
+  bool disconnect(bool wifioff = false, bool = false) {
+    begun = false;
+    joined = false;
+    if (wifioff) mode(WIFI_OFF);
+    return true;
+  }
+
+ private:
+  wifi_mode_t current = WIFI_OFF;
+  uint64_t on_since_us = 0;
+  uint64_t connect_at_us = 0;
+  int16_t scan_count = 0;
+  bool begun = false, joined = false, ssid_ok = false, pass_ok = false;
+};
+
+WiFiClass WiFi;
+
+class WiFiClient : public Client {};
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef _HOST_WIRE_H
+#define _HOST_WIRE_H
+
+#include <Arduino.h>
+
+// OLED 버스 (Wire1) - 응답하는 장치 없음
+
+class TwoWire {
+ public:
+  bool begin(int = -1, int = -1, uint32_t = 0) { return true; }
+  bool setClock(uint32_t) { return true; }
+};
+
+TwoWire Wire;
+TwoWire Wire1;
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef _HOST_DRIVER_GPIO_H
+#define _HOST_DRIVER_GPIO_H
+
+// GPIO 웨이크업 설정은 기록만 (수신 완료는 시뮬레이션 라디오가 동기적으로 처리)
+
+typedef int esp_err_t;
+typedef int gpio_num_t;
+typedef enum {
+  GPIO_INTR_DISABLE,
+  GPIO_INTR_POSEDGE,
+  GPIO_INTR_NEGEDGE,
+  GPIO_INTR_ANYEDGE,
+  GPIO_INTR_LOW_LEVEL,
+  GPIO_INTR_HIGH_LEVEL
+} gpio_int_type_t;
+
+inline esp_err_t gpio_wakeup_enable(gpio_num_t, gpio_int_type_t) { return 0; }
+inline esp_err_t gpio_wakeup_disable(gpio_num_t) { return 0; }
+inline esp_err_t gpio_set_intr_type(gpio_num_t, gpio_int_type_t) { return 0; }
+inline esp_err_t gpio_intr_enable(gpio_num_t) { return 0; }
+inline esp_err_t gpio_intr_disable(gpio_num_t) { return 0; }
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef _HOST_ESP_ATTR_H
+#define _HOST_ESP_ATTR_H
+
+// RTC 메모리 구분 없음 (재시작은 시뮬레이션하지 않으므로 일반 전역 변수와 같음)
+#define RTC_NOINIT_ATTR
+#define RTC_DATA_ATTR
+#define IRAM_ATTR
+
+#endif
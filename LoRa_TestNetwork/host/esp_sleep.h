@@ -0,0 +1,37 @@
+#ifndef _HOST_ESP_SLEEP_H
+#define _HOST_ESP_SLEEP_H
+
+#include <Arduino.h>
+#include "driver/gpio.h"
+
+// Light Sleep = 타이머 웨이크업 시각까지 시뮬레이션 시계를 돌림 (GPIO 웨이크업은 일어나지 않음)
+
+typedef enum {
+  ESP_SLEEP_WAKEUP_UNDEFINED,
+  ESP_SLEEP_WAKEUP_TIMER,
+  ESP_SLEEP_WAKEUP_GPIO
+} esp_sleep_source_t;
+
+#define ESP_OK 0
+
+uint64_t sim_sleep_timer_us = 0;    // 설정된 타이머 웨이크업
+uint64_t sim_light_sleep_us = 0;    // 누적 Light Sleep 시간
+
+inline esp_err_t esp_sleep_enable_timer_wakeup(uint64_t us) {
+  sim_sleep_timer_us = us;
+  return ESP_OK;
+}
+
+inline esp_err_t esp_sleep_enable_gpio_wakeup() { return ESP_OK; }
+inline esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t source) {
+  if (source == ESP_SLEEP_WAKEUP_TIMER) sim_sleep_timer_us = 0;
+  return ESP_OK;
+}
+
+inline esp_err_t esp_light_sleep_start() {
+  sim_light_sleep_us += sim_sleep_timer_us;
+  simAdvanceUs(sim_sleep_timer_us);
+  return ESP_OK;
+}
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef _HOST_ESP_SYSTEM_H
+#define _HOST_ESP_SYSTEM_H
+
+#include <Arduino.h>  // ESP, esp_random()
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef _HOST_ESP_TIMER_H
+#define _HOST_ESP_TIMER_H
+
+#include <Arduino.h>
+
+// 부팅 후 시간 (µs) = 시뮬레이션 시각
+inline int64_t esp_timer_get_time() { return (int64_t)sim_now_us; }
+
+#endif
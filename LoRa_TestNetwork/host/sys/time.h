@@ -0,0 +1,36 @@
+#ifndef _HOST_SYS_TIME_H
+#define _HOST_SYS_TIME_H
+
+#include_next <sys/time.h>
+#include <stdint.h>
+
+// 시스템 시계(gettimeofday/settimeofday)를 시뮬레이션 RTC로 바꿈
+// RTC는 전원 인가 시 0에서 시작하고 sim_rtc_drift_ppm만큼 빠르거나 느리게 흐름 (+면 빠름)
+// settimeofday()는 호스트 시계 대신 이 RTC를 맞춤 (network_time.h)
+
+extern uint64_t sim_now_us;   // Arduino.h (시스템 헤더가 먼저 이 파일을 포함할 수 있어 직접 포함하지 않음)
+
+double sim_rtc_drift_ppm = 0.0;
+int64_t sim_rtc_offset_us = 0;
+
+inline int64_t simRtcUs() {
+  return (int64_t)(sim_now_us + sim_now_us * sim_rtc_drift_ppm / 1e6) + sim_rtc_offset_us;
+}
+
+inline int simGettimeofday(struct timeval* tv, void*) {
+  int64_t us = simRtcUs();
+  tv->tv_sec = us / 1000000;
+  tv->tv_usec = us % 1000000;
+  return 0;
+}
+
+inline int simSettimeofday(const struct timeval* tv, const void*) {
+  int64_t target = (int64_t)tv->tv_sec * 1000000 + tv->tv_usec;
+  sim_rtc_offset_us += target - simRtcUs();
+  return 0;
+}
+
+#define gettimeofday simGettimeofday
+#define settimeofday simSettimeofday
+
+#endif
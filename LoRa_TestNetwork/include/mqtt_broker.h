@@ -0,0 +1,159 @@
+#ifndef _MQTT_BROKER_H
+#define _MQTT_BROKER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 로컬 MQTT 브로커 대역 (Wi-Fi 백홀 NODE_WIFI_BACKHAUL 종단 간 테스트)
+//
+// host/PubSubClient.h가 TCP 대신 이 객체에 붙음 (같은 프로세스, 시뮬레이션 시각)
+//  - CONNECT/SUBSCRIBE(+, # 와일드카드)/PUBLISH QoS 0: 받은 메시지를 구독자 모두에게 전달
+//    (보낸 클라이언트 자신도 포함 → 펌웨어는 이 되돌림으로 전달을 확인)
+//  - 전달은 latency_us 뒤 (클라이언트 loop()가 가져감)
+//  - 장애 주입: 발행 손실(브로커가 못 받음), 전달 손실(되돌림 유실), disconnect_every번째 발행마다 연결 끊김
+//  - 받은 메시지는 시각과 함께 기록 → main.cpp가 풀어 측정 번호를 셈
+// ============================================================================
+
+struct MqttMessage {
+  std::string topic;
+  std::vector<uint8_t> payload;
+  uint64_t time_us;            // 브로커가 받은 시각 (전달 대기열에서는 전달 시각)
+};
+
+struct MqttBrokerStats {
+  uint32_t connects;
+  uint32_t publishes;          // 받은 발행
+  uint32_t lost_publishes;     // 장애 주입으로 못 받음
+  uint32_t deliveries;         // 구독자에게 보낸 것
+  uint32_t lost_deliveries;
+  uint32_t forced_disconnects;
+};
+
+class MqttBroker {
+ public:
+  double publish_loss = 0.0;        // 발행마다 적용 확률
+  double delivery_loss = 0.0;       // 구독자 전달마다 적용 확률
+  uint32_t disconnect_every = 0;    // 이 수만큼 발행마다 보낸 클라이언트 연결을 끊음 (0: 안 끊음)
+  uint64_t latency_us = 5000;       // 브로커 ↔ 클라이언트 한 방향
+
+  std::vector<MqttMessage> received;
+  MqttBrokerStats stats = {};
+
+  explicit MqttBroker(uint32_t seed) : rng(seed ? seed : 1) {}
+
+  // 세션 번호 (같은 클라이언트 ID면 이전 세션을 끊음, clean session)
+  int connect(const std::string &client_id) {
+    for (Session &s : sessions) {
+      if (s.client_id == client_id) s.connected = false;
+    }
+    sessions.push_back(Session());
+    sessions.back().client_id = client_id;
+    sessions.back().connected = true;
+    stats.connects++;
+    return (int)sessions.size() - 1;
+  }
+
+  bool connected(int session) const {
+    return session >= 0 && session < (int)sessions.size() && sessions[session].connected;
+  }
+
+  void disconnect(int session) {
+    if (connected(session)) sessions[session].connected = false;
+  }
+
+  bool subscribe(int session, const std::string &filter) {
+    if (!connected(session)) return false;
+    sessions[session].filters.push_back(filter);
+    return true;
+  }
+
+  // 클라이언트가 now_us에 다 보낸 발행 (연결이 끊기면 false)
+  bool publish(int session, const std::string &topic, const uint8_t* payload, size_t len, uint64_t now_us) {
+    if (!connected(session)) return false;
+    if (disconnect_every && ++publish_count % disconnect_every == 0) {
+      sessions[session].connected = false;   // 발행 도중 TCP 끊김
+      stats.forced_disconnects++;
+      return false;
+    }
+    if (chance(publish_loss)) {
+      stats.lost_publishes++;
+      return true;
+    }
+
+    uint64_t arrival = now_us + latency_us;
+    MqttMessage msg = {topic, std::vector<uint8_t>(payload, payload + len), arrival};
+    received.push_back(msg);
+    stats.publishes++;
+
+    for (Session &s : sessions) {
+      if (!s.connected || !subscribed(s, topic)) continue;
+      if (chance(delivery_loss)) {
+        stats.lost_deliveries++;
+        continue;
+      }
+      MqttMessage out = msg;
+      out.time_us = arrival + latency_us;
+      s.inbox.push_back(out);
+      stats.deliveries++;
+    }
+    return true;
+  }
+
+  // now_us까지 도착한 전달 하나 (없으면 false)
+  bool poll(int session, uint64_t now_us, MqttMessage &out) {
+    if (!connected(session)) return false;
+    std::vector<MqttMessage> &inbox = sessions[session].inbox;
+    if (inbox.empty() || inbox.front().time_us > now_us) return false;
+    out = inbox.front();
+    inbox.erase(inbox.begin());
+    return true;
+  }
+
+  // MQTT 토픽 필터 (+: 한 단계, #: 나머지 전부)
+  static bool topicMatches(const std::string &filter, const std::string &topic) {
+    size_t f = 0, t = 0;
+    while (f < filter.size()) {
+      if (filter[f] == '#') return true;
+      if (filter[f] == '+') {
+        while (t < topic.size() && topic[t] != '/') t++;
+        f++;
+        continue;
+      }
+      if (t >= topic.size() || filter[f] != topic[t]) return false;
+      f++;
+      t++;
+    }
+    return t == topic.size();
+  }
+
+ private:
+  struct Session {
+    std::string client_id;
+    bool connected;
+    std::vector<std::string> filters;
+    std::vector<MqttMessage> inbox;
+  };
+
+  std::vector<Session> sessions;
+  uint32_t publish_count = 0;
+  uint32_t rng;
+
+  static bool subscribed(const Session &s, const std::string &topic) {
+    for (const std::string &filter : s.filters) {
+      if (topicMatches(filter, topic)) return true;
+    }
+    return false;
+  }
+
+  bool chance(double p) {
+    if (p <= 0) return false;
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (rng % 10000) < p * 10000;
+  }
+};
+
+#endif
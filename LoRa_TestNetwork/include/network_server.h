@@ -0,0 +1,433 @@
+#ifndef _NETWORK_SERVER_H
+#define _NETWORK_SERVER_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "lorawan_crypto.h"
+#include "lora_airtime.h"
+#include "payload_decoder.h"   // LoRa_Decoder 필드/FPort 표
+#include "delta_decoder.h"     // 묶음 업링크(FPort 4) 해석
+
+// ============================================================================
+// LoRaWAN 1.0.4 네트워크 서버 + 게이트웨이 대역 (단일 게이트웨이, KR920)
+//
+//  - OTAA: 조인 요청 MIC(NwkKey) 검증, DevNonce 재사용 거부(이전 값보다 커야 함),
+//    JoinNonce 증가, DevAddr 할당, 조인 수락은 JOIN_ACCEPT_DELAY1(RX1)로
+//  - 데이터: DevAddr 세션 조회, FCnt 32비트 복원(MAX_FCNT_GAP) 및 재전송/되감기 거부, MIC(NwkSKey) 검증
+//  - MAC: LinkCheckReq → LinkCheckAns, DeviceTimeReq → DeviceTimeAns(업링크 끝 시각, GPS),
+//    LinkADRAns 수신, ADR(최근 NS_ADR_HISTORY 업링크 최대 SNR - 설치 마진으로 DR 올림 → LinkADRReq),
+//    ADRACKReq에는 빈 다운링크로 응답
+//  - 애플리케이션: FPort 10 설정 다운링크 큐, 측정값은 LoRa_Decoder로 풀어 측정 번호(데이터 첫 u16)별로 집계
+//  - 장애 주입 (FaultWindow, 시각 구간 + 확률): 업링크/다운링크/조인 수락 손실, 업링크/다운링크 MIC 손상,
+//    게이트웨이 중단, 서버 재시작(세션 DB 유실) - 칩 장애(FAULT_RADIO_*)는 main.cpp가 시뮬레이션 라디오에 전달
+// ============================================================================
+
+#define NS_NET_ID 0x000013
+#define NS_DEV_ADDR_BASE 0x26010000UL
+#define NS_MAX_FCNT_GAP 16384
+#define NS_ADR_HISTORY 20           // ADR 판단에 쓰는 최근 업링크 수
+#define NS_ADR_MARGIN_DB 10.0f      // 설치 마진
+#define NS_ADR_STEP_DB 3.0f         // DR 한 단계당 필요한 SNR 여유
+#define NS_UNIX_EPOCH 1790000000UL  // 시뮬레이션 시각 0의 Unix 시각
+#define NS_GPS_EPOCH_OFFSET_S 315964800UL
+#define NS_GPS_LEAP_SECONDS 18
+#define NS_MAX_SEQUENCE 65536       // 측정 번호 (u16)
+#define NS_FRAME_MAX 256
+
+enum FaultKind {
+  FAULT_UPLINK_LOSS,        // 게이트웨이가 업링크를 못 들음
+  FAULT_DOWNLINK_LOSS,      // 다운링크(조인 수락 포함) 전달 안 됨 → 노드 RX 타임아웃
+  FAULT_JOIN_ACCEPT_LOSS,   // 조인 수락만 전달 안 됨
+  FAULT_UPLINK_MIC,         // 업링크 MIC 손상 (서버가 거부)
+  FAULT_DOWNLINK_MIC,       // 다운링크 MIC 손상 (노드가 거부)
+  FAULT_GATEWAY_OFFLINE,    // 게이트웨이 백홀 끊김 (양방향)
+  FAULT_SERVER_RESET,       // 구간 시작 시각에 세션 DB 유실 (장치 등록/DevNonce 기록은 유지)
+  FAULT_RADIO_HANG,         // 노드 SX1262 멈춤 (구간 시작 시각, radio.begin()으로 풀림)
+  FAULT_RADIO_BROWNOUT,     // 노드 SX1262 자체 리셋 (구간 시작 시각)
+  FAULT_RADIO_DEAD,         // 노드 SX1262 응답 없음 (구간 동안)
+  FAULT_TX_STALL,           // 노드 TX 완료 인터럽트 없음 (구간 시작 시각, 한 번)
+  FAULT_KIND_COUNT
+};
+
+struct FaultWindow {
+  FaultKind kind;
+  double start_s;
+  double end_s;
+  double probability;       // 구간 안에서 프레임마다 적용 확률 (1 = 항상)
+};
+
+// 서버 쪽 장치 기록
+struct ServerDevice {
+  uint64_t dev_eui;
+  uint64_t join_eui;
+  uint8_t nwk_key[AES_BLOCK_SIZE];
+  bool has_dev_nonce;
+  uint16_t last_dev_nonce;
+  uint32_t join_nonce;
+
+  bool session;
+  uint32_t dev_addr;
+  uint8_t nwk_skey[AES_BLOCK_SIZE];
+  uint8_t app_skey[AES_BLOCK_SIZE];
+  bool has_fcnt_up;
+  uint32_t fcnt_up;
+  uint32_t fcnt_down;
+
+  uint8_t datarate;
+  float snr_history[NS_ADR_HISTORY];
+  uint8_t snr_count;
+  bool adr_pending;
+
+  std::vector<std::vector<uint8_t>> app_queue;   // FPort 10 다운링크
+};
+
+struct ServerStats {
+  uint32_t join_requests;      // MIC가 맞는 조인 요청
+  uint32_t join_accepts;
+  uint32_t nonce_rejects;      // DevNonce 재사용으로 거부
+  uint32_t uplinks;            // 받아들인 데이터 업링크
+  uint32_t unknown_dev_addr;   // 세션 없는 DevAddr (서버 재시작 후 등)
+  uint32_t mic_rejects;
+  uint32_t fcnt_rejects;
+  uint32_t downlinks;          // 보낸 다운링크 (장애로 잃은 것 포함)
+  uint32_t link_adr_reqs;
+  uint32_t lost_uplinks;       // 장애 주입으로 잃음
+  uint32_t lost_downlinks;
+  uint32_t corrupted_downlinks;
+  uint32_t config_acks;        // 적용 성공 설정 응답 (FPort 11, 상태 0)
+};
+
+class NetworkServer {
+ public:
+  std::vector<FaultWindow> faults;
+  ServerStats stats = {};
+  float link_snr_db = 5.0f;          // 노드 ↔ 게이트웨이 SNR (양방향 같음)
+  float link_rssi_dbm = -105.0f;
+
+  std::vector<uint16_t> sequence_counts;    // 측정 번호별 수신 횟수
+  std::vector<uint64_t> data_times_us;      // 측정값이 담긴 업링크를 받은 시각
+  uint32_t late_readings = 0;               // 밀린 측정값(FPort 2/4)으로 온 것
+
+  explicit NetworkServer(uint32_t seed) : sequence_counts(NS_MAX_SEQUENCE, 0), rng(seed ? seed : 1) {}
+
+  void addDevice(uint64_t dev_eui, uint64_t join_eui, const uint8_t* nwk_key) {
+    ServerDevice dev = ServerDevice();
+    dev.dev_eui = dev_eui;
+    dev.join_eui = join_eui;
+    memcpy(dev.nwk_key, nwk_key, AES_BLOCK_SIZE);
+    devices.push_back(dev);
+  }
+
+  // FPort 10 설정 다운링크 예약 (다음 업링크의 RX1로)
+  void queueDownlink(uint64_t dev_eui, const std::vector<uint8_t> &payload) {
+    for (ServerDevice &dev : devices) {
+      if (dev.dev_eui == dev_eui) dev.app_queue.push_back(payload);
+    }
+  }
+
+  // 시각 now_us에 끝난 업링크 하나 처리, 다운링크가 있으면 true (dl, dl_len, window)
+  bool receive(const uint8_t* phy, size_t len, uint8_t dr, uint64_t now_us, uint8_t* dl, size_t &dl_len,
+               uint8_t &window) {
+    double t = now_us / 1e6;
+    applyServerReset(t);
+
+    if (faultHits(FAULT_GATEWAY_OFFLINE, t) || faultHits(FAULT_UPLINK_LOSS, t)) {
+      stats.lost_uplinks++;
+      return false;
+    }
+    if (len == 0 || len > NS_FRAME_MAX) return false;
+
+    uint8_t frame[NS_FRAME_MAX];
+    memcpy(frame, phy, len);
+    if (faultHits(FAULT_UPLINK_MIC, t)) frame[len - 1] ^= 0x5A;
+
+    bool join = frame[0] == 0x00;
+    bool sent = join ? handleJoin(frame, len, dl, dl_len) : handleData(frame, len, dr, now_us, dl, dl_len);
+    if (!sent) return false;
+    window = 1;
+    stats.downlinks++;
+
+    if (faultHits(FAULT_GATEWAY_OFFLINE, t) || faultHits(FAULT_DOWNLINK_LOSS, t) ||
+        (join && faultHits(FAULT_JOIN_ACCEPT_LOSS, t))) {
+      stats.lost_downlinks++;
+      return false;
+    }
+    if (faultHits(FAULT_DOWNLINK_MIC, t)) {
+      dl[dl_len - 1] ^= 0xA5;
+      stats.corrupted_downlinks++;
+    }
+    return true;
+  }
+
+  // 세션이 있는 장치의 현재 업링크 DR (없으면 0xFF)
+  uint8_t deviceDatarate(uint64_t dev_eui) const {
+    for (const ServerDevice &dev : devices) {
+      if (dev.dev_eui == dev_eui && dev.session) return dev.datarate;
+    }
+    return 0xFF;
+  }
+
+ private:
+  uint32_t rng;
+  uint32_t next_dev_addr = NS_DEV_ADDR_BASE;
+  std::vector<ServerDevice> devices;
+  std::vector<bool> resets_applied;
+
+  uint32_t nextRandom() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+  }
+
+  bool faultHits(FaultKind kind, double t) {
+    for (const FaultWindow &f : faults) {
+      if (f.kind != kind || t < f.start_s || t >= f.end_s) continue;
+      if (f.probability >= 1.0 || (nextRandom() >> 8) * (1.0 / 16777216.0) < f.probability) return true;
+    }
+    return false;
+  }
+
+  void applyServerReset(double t) {
+    resets_applied.resize(faults.size(), false);
+    for (size_t i = 0; i < faults.size(); i++) {
+      if (faults[i].kind != FAULT_SERVER_RESET || resets_applied[i] || t < faults[i].start_s) continue;
+      resets_applied[i] = true;
+      for (ServerDevice &dev : devices) {
+        dev.session = false;
+        dev.app_queue.clear();
+      }
+    }
+  }
+
+  static void putLe(uint8_t* out, uint64_t v, int n) {
+    for (int i = 0; i < n; i++) out[i] = (uint8_t)(v >> (8 * i));
+  }
+
+  static uint64_t getLe(const uint8_t* in, int n) {
+    uint64_t v = 0;
+    for (int i = 0; i < n; i++) v |= (uint64_t)in[i] << (8 * i);
+    return v;
+  }
+
+  // 데이터레이트별 복조 한계 SNR (dB, SF12 -20 ~ SF7 -7.5)
+  static float requiredSnr(uint8_t dr) { return -20.0f + 2.5f * dr; }
+
+  // ---- 조인 ----
+
+  bool handleJoin(const uint8_t* frame, size_t len, uint8_t* dl, size_t &dl_len) {
+    if (len != LORAWAN_JOIN_REQUEST_SIZE) return false;
+    uint64_t join_eui = getLe(frame + 1, 8);
+    uint64_t dev_eui = getLe(frame + 9, 8);
+    uint16_t dev_nonce = (uint16_t)getLe(frame + 17, 2);
+
+    ServerDevice* dev = nullptr;
+    for (ServerDevice &d : devices) {
+      if (d.dev_eui == dev_eui && d.join_eui == join_eui) dev = &d;
+    }
+    if (!dev) return false;
+    if (lorawanJoinMic(dev->nwk_key, frame, 19) != (uint32_t)getLe(frame + 19, 4)) {
+      stats.mic_rejects++;
+      return false;
+    }
+    stats.join_requests++;
+
+    // 1.0.4: DevNonce는 장치마다 증가하는 카운터, 같거나 작으면 재전송 공격으로 보고 무시
+    if (dev->has_dev_nonce && dev_nonce <= dev->last_dev_nonce) {
+      stats.nonce_rejects++;
+      return false;
+    }
+    dev->has_dev_nonce = true;
+    dev->last_dev_nonce = dev_nonce;
+    dev->join_nonce++;
+
+    dev->session = true;
+    dev->dev_addr = next_dev_addr++;
+    lorawanSessionKey(dev->nwk_key, 0x01, dev->join_nonce, NS_NET_ID, dev_nonce, dev->nwk_skey);
+    lorawanSessionKey(dev->nwk_key, 0x02, dev->join_nonce, NS_NET_ID, dev_nonce, dev->app_skey);
+    dev->has_fcnt_up = false;
+    dev->fcnt_up = 0;
+    dev->fcnt_down = 0;
+    dev->datarate = 0;
+    dev->snr_count = 0;
+    dev->adr_pending = false;
+
+    // [MHDR][JoinNonce 3][NetID 3][DevAddr 4][DLSettings][RxDelay][MIC], MHDR 뒤를 AES 복호화 연산으로 감쌈
+    dl[0] = 0x20;
+    putLe(dl + 1, dev->join_nonce, 3);
+    putLe(dl + 4, NS_NET_ID, 3);
+    putLe(dl + 7, dev->dev_addr, 4);
+    dl[11] = 0x00;   // RX1DROffset 0, RX2 DR0
+    dl[12] = 0x01;   // RX1 1초
+    putLe(dl + 13, lorawanJoinMic(dev->nwk_key, dl, 13), 4);
+    dl_len = 17;
+    aes128Decrypt(dev->nwk_key, dl + 1, dl + 1);
+
+    stats.join_accepts++;
+    return true;
+  }
+
+  // ---- 데이터 ----
+
+  bool handleData(const uint8_t* frame, size_t len, uint8_t dr, uint64_t now_us, uint8_t* dl, size_t &dl_len) {
+    if (len < 12 || (frame[0] != 0x40 && frame[0] != 0x80)) return false;
+    uint32_t dev_addr = (uint32_t)getLe(frame + 1, 4);
+
+    ServerDevice* dev = nullptr;
+    for (ServerDevice &d : devices) {
+      if (d.session && d.dev_addr == dev_addr) dev = &d;
+    }
+    if (!dev) {
+      stats.unknown_dev_addr++;
+      return false;
+    }
+
+    uint8_t fctrl = frame[5];
+    uint8_t fopts_len = fctrl & 0x0F;
+    if (8 + fopts_len + LORAWAN_MIC_SIZE > (int)len) return false;
+
+    // FCnt 16비트 → 32비트 (이전 값 이하면 상위 비트 올림, 간격이 너무 크면 거부)
+    uint32_t fcnt = (dev->fcnt_up & 0xFFFF0000UL) | (uint32_t)getLe(frame + 6, 2);
+    if (dev->has_fcnt_up && fcnt <= dev->fcnt_up) fcnt += 0x10000;
+    if (dev->has_fcnt_up && fcnt - dev->fcnt_up > NS_MAX_FCNT_GAP) {
+      stats.fcnt_rejects++;
+      return false;
+    }
+
+    size_t mic_pos = len - LORAWAN_MIC_SIZE;
+    if (lorawanDataMic(dev->nwk_skey, LORAWAN_DIR_UPLINK, dev_addr, fcnt, frame, mic_pos) !=
+        (uint32_t)getLe(frame + mic_pos, 4)) {
+      stats.mic_rejects++;
+      return false;
+    }
+    dev->fcnt_up = fcnt;
+    dev->has_fcnt_up = true;
+    dev->datarate = dr;
+    stats.uplinks++;
+
+    // ADR 기록
+    dev->snr_history[dev->snr_count % NS_ADR_HISTORY] = link_snr_db;
+    if (dev->snr_count < 255) dev->snr_count++;
+
+    // FOpts MAC 명령 → 응답
+    uint8_t answers[15];
+    uint8_t answers_len = 0;
+    const uint8_t* mac = frame + 8;
+    for (size_t i = 0; i < fopts_len;) {
+      uint8_t cid = mac[i++];
+      if (cid == 0x02 && answers_len + 3 <= (int)sizeof(answers)) {            // LinkCheckReq
+        float margin = link_snr_db - requiredSnr(dr);
+        answers[answers_len++] = 0x02;
+        answers[answers_len++] = margin > 0 ? (uint8_t)margin : 0;
+        answers[answers_len++] = 1;
+      } else if (cid == 0x0D && answers_len + 6 <= (int)sizeof(answers)) {     // DeviceTimeReq
+        uint64_t unix_us = (uint64_t)NS_UNIX_EPOCH * 1000000ULL + now_us;
+        uint32_t gps = (uint32_t)(unix_us / 1000000ULL - NS_GPS_EPOCH_OFFSET_S + NS_GPS_LEAP_SECONDS);
+        answers[answers_len++] = 0x0D;
+        putLe(answers + answers_len, gps, 4);
+        answers[answers_len + 4] = (uint8_t)((unix_us % 1000000ULL) * 256 / 1000000ULL);
+        answers_len += 5;
+      } else if (cid == 0x03) {                                           // LinkADRAns [status]
+        if (i < fopts_len && (mac[i] & 0x07) == 0x07) dev->adr_pending = false;
+        i++;
+      } else {
+        break;  // 이 서버가 모르는 명령 (길이를 몰라 나머지 무시)
+      }
+    }
+
+    // FRMPayload
+    size_t pos = 8 + fopts_len;
+    if (pos < mic_pos) {
+      uint8_t port = frame[pos++];
+      uint8_t payload[NS_FRAME_MAX];
+      size_t payload_len = mic_pos - pos;
+      memcpy(payload, frame + pos, payload_len);
+      if (port != 0) {
+        lorawanCryptPayload(dev->app_skey, LORAWAN_DIR_UPLINK, dev_addr, fcnt, payload, payload_len);
+        recordReadings(port, payload, payload_len, now_us);
+      }
+    }
+
+    // ADR: 최근 업링크 최대 SNR의 여유만큼 DR 올림
+    bool adr = fctrl & 0x80;
+    uint8_t adr_dr = 0xFF;
+    if (adr && !dev->adr_pending && dev->snr_count >= NS_ADR_HISTORY && dr < KR920_MAX_DATARATE) {
+      float max_snr = dev->snr_history[0];
+      for (int i = 1; i < NS_ADR_HISTORY; i++) max_snr = fmaxf(max_snr, dev->snr_history[i]);
+      int steps = (int)floorf((max_snr - requiredSnr(dr) - NS_ADR_MARGIN_DB) / NS_ADR_STEP_DB);
+      if (steps > 0) adr_dr = (uint8_t)(dr + steps > KR920_MAX_DATARATE ? KR920_MAX_DATARATE : dr + steps);
+    }
+    if (adr_dr != 0xFF && answers_len + 5 <= (int)sizeof(answers)) {
+      answers[answers_len++] = 0x03;
+      answers[answers_len++] = (uint8_t)(adr_dr << 4);   // TXPower 0 = 최대
+      answers[answers_len++] = 0x07;                     // ChMask: 기본 3채널
+      answers[answers_len++] = 0x00;
+      answers[answers_len++] = 0x01;                     // NbTrans 1
+      dev->adr_pending = true;
+      dev->snr_count = 0;
+      stats.link_adr_reqs++;
+    }
+
+    bool adr_ack_req = fctrl & 0x40;
+    bool app = !dev->app_queue.empty();
+    if (!answers_len && !adr_ack_req && !app) return false;
+
+    // [MHDR][DevAddr][FCtrl][FCnt][FOpts][FPort 10][FRMPayload][MIC]
+    size_t n = 0;
+    dl[n++] = 0x60;
+    putLe(dl + n, dev_addr, 4);
+    n += 4;
+    dl[n++] = (adr ? 0x80 : 0) | answers_len;
+    putLe(dl + n, dev->fcnt_down, 2);
+    n += 2;
+    memcpy(dl + n, answers, answers_len);
+    n += answers_len;
+    if (app) {
+      std::vector<uint8_t> payload = dev->app_queue.front();
+      dev->app_queue.erase(dev->app_queue.begin());
+      dl[n++] = 10;
+      memcpy(dl + n, payload.data(), payload.size());
+      lorawanCryptPayload(dev->app_skey, LORAWAN_DIR_DOWNLINK, dev_addr, dev->fcnt_down, dl + n, payload.size());
+      n += payload.size();
+    }
+    putLe(dl + n, lorawanDataMic(dev->nwk_skey, LORAWAN_DIR_DOWNLINK, dev_addr, dev->fcnt_down, dl, n), 4);
+    dl_len = n + LORAWAN_MIC_SIZE;
+    dev->fcnt_down++;
+    return true;
+  }
+
+  // ---- 측정값 ----
+
+  void countSequence(const uint8_t* frame) {
+    uint16_t seq = (uint16_t)(frame[FRAME_DESCRIPTOR_SIZE] << 8 | frame[FRAME_DESCRIPTOR_SIZE + 1]);
+    if (sequence_counts[seq] < 0xFFFF) sequence_counts[seq]++;
+  }
+
+  void recordReadings(uint8_t port, const uint8_t* payload, size_t len, uint64_t now_us) {
+    UplinkInfo info;
+    float values[COL_COUNT];
+    if (decodeUplink(port, payload, len, FRAME_STAIR, info, values)) {
+      if (!info.descriptor) return;
+      if (info.frame_class == CLASS_CONFIG_ACK && info.header[1] == 0) stats.config_acks++;
+      countSequence(payload + info.header_size);
+      if (info.frame_class == CLASS_BACKLOG) late_readings++;
+      data_times_us.push_back(now_us);
+      return;
+    }
+    if (info.frame_class != CLASS_DELTA_BATCH) return;
+
+    static const size_t max_samples = 64;
+    uint8_t frames[max_samples * DELTA_FRAME_STRIDE_MAX];
+    uint32_t times[max_samples];
+    const FrameLayout* layout;
+    size_t count = decodeDeltaBlock(payload, len, frames, times, max_samples, layout);
+    for (size_t s = 0; s < count; s++) countSequence(frames + s * (FRAME_DESCRIPTOR_SIZE + layout->size));
+    late_readings += count;
+    if (count) data_times_us.push_back(now_us);
+  }
+};
+
+#endif
@@ -0,0 +1,512 @@
+// ============================================================================
+// LoRaWAN 종단 간 장애 테스트 (pio run -e native && .pio/build/native/program [옵션])
+//
+// 펌웨어 SensorNode setup()/loop()(LoRaNodeCore)를 수정 없이 호스트 빌드해 시뮬레이션 SX1262/RadioLib
+// (host/)과 로컬 네트워크 서버(network_server.h) 사이에서 돌리고, 시나리오별로 장애를 주입해
+// 조인 지연, 장애 후 복구 시간, 측정값 전달률을 잼. 시나리오 실행마다 fork()해서 전역 상태가 깨끗함
+// Wi-Fi 백홀(NODE_WIFI_BACKHAUL)은 시나리오가 정한 구간에만 보이는 AP와 로컬 브로커 대역(mqtt_broker.h)으로
+//
+//   --scenario NAME    한 시나리오만 (기본: 전체, --list로 목록)
+//   --runs N           시나리오당 실행 수 (시드 1..N, 기본 10)
+//   --hours H          실행 시간 (기본 6)
+//   --seed N           첫 시드 (기본 1)
+//   --snr DB           링크 SNR (기본 5dB)
+//   --drift PPM        노드 RTC 오차 (기본 +20ppm)
+//   --reset-nonce      beginOTAA()가 DevNonce를 0부터 다시 쓴다고 가정 (RadioLib 동작 확인용)
+//   --verbose          펌웨어 시리얼 로그 출력 (--runs 1 권장)
+//
+// halted 실행이 있거나 복구를 재는 시나리오에서 복구 못 한 실행이 있으면 그 줄에 FAIL, 종료 코드 1
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "sensor_node.h"
+#include "network_server.h"
+#include "mqtt_broker.h"
+
+// ============================================================================
+// 호스트 센서: 계단 센서 v2 배치(14바이트)로 보내되 BME280 온도 자리에 측정 번호를 넣음
+// 서버가 번호로 측정값 전달/손실/중복을 셈 (밀린 측정값 묶음도 같은 번호로 풀림)
+// ============================================================================
+
+#define HOST_SENSOR_READ_MS 30       // 측정 시간 (BMP390 변환 정도)
+
+struct HostReading {
+  uint16_t sequence;
+};
+
+class HostSensor {
+ public:
+  typedef HostReading Reading;
+  static const uint8_t PAYLOAD_SIZE = 14;
+  static const uint8_t FRAME_TYPE = FRAME_TYPE_STAIR;
+  static const uint8_t FRAME_VERSION = 2;
+  static const uint32_t DELTA_U16_FIELDS = 0x00000555;
+
+  uint16_t readings = 0;
+
+  const char* title() { return " LoRa:Host "; }
+  const char* splashTitle() { return "LoRa-Host Sensor"; }
+  bool begin() { return true; }
+
+  Reading read() {
+    delay(HOST_SENSOR_READ_MS);
+    return {readings++};
+  }
+
+  void encode(const Reading &data, uint8_t* buffer) {
+    static const uint8_t fixed[10] = {0x01, 0xF4, 0x08, 0x54, 0x02, 0x8A, 0x08, 0x54, 0x01, 0xF4};
+    buffer[0] = data.sequence >> 8;
+    buffer[1] = data.sequence & 0xFF;
+    memcpy(buffer + 2, fixed, sizeof(fixed));   // 습도 50%, 1013.2hPa, 25°C, 0m
+    buffer[12] = encodeLinkQuality(consecutive_send_failures);
+    buffer[13] = 0;
+  }
+
+  void print(const Reading &data) { Serial.println("Sequence: " + String(data.sequence)); }
+  void draw(const Reading &) {}
+  void onConfigActions(uint8_t) {}
+};
+
+typedef SensorNode<HostSensor> Node;
+
+// ============================================================================
+// 시나리오
+// ============================================================================
+
+#define SCENARIO_MAX_FAULTS 3
+#define HOUR_S 3600.0
+#define BACKHAUL_MAX_SAMPLES 255     // 기록 묶음 하나의 최대 샘플 수 (DeltaBlock.count u8)
+
+// Wi-Fi 백홀: AP가 보이는 구간과 브로커 장애 (기본값 0 = AP 없음)
+struct BackhaulSetup {
+  double ap_from_s;
+  double ap_until_s;
+  double publish_loss;         // 브로커가 발행을 못 받을 확률
+  double delivery_loss;        // 되돌림(전달 확인)이 유실될 확률
+  uint32_t disconnect_every;   // 이 수만큼 발행마다 브로커가 연결을 끊음
+};
+
+#define NO_BACKHAUL {0, 0, 0, 0, 0}  // Wi-Fi AP 없음 (LoRa만)
+
+struct Scenario {
+  const char* name;
+  const char* description;
+  uint8_t fault_count;
+  FaultWindow faults[SCENARIO_MAX_FAULTS];
+  BackhaulSetup wifi;
+};
+
+static const Scenario SCENARIOS[] = {
+  {"baseline", "no faults", 0, {}, NO_BACKHAUL},
+  {"boot_join_loss", "join accepts lost for the first 10 min", 1,
+   {{FAULT_JOIN_ACCEPT_LOSS, 0, 600, 1.0}}, NO_BACKHAUL},
+  {"boot_join_flaky", "30% of join accepts lost for the first 10 min", 1,
+   {{FAULT_JOIN_ACCEPT_LOSS, 0, 600, 0.3}}, NO_BACKHAUL},
+  {"gateway_outage", "gateway offline 1h-2h", 1,
+   {{FAULT_GATEWAY_OFFLINE, HOUR_S, 2 * HOUR_S, 1.0}}, NO_BACKHAUL},
+  {"rx_timeout", "all downlinks lost 1h-2h (RX1/RX2 time out)", 1,
+   {{FAULT_DOWNLINK_LOSS, HOUR_S, 2 * HOUR_S, 1.0}}, NO_BACKHAUL},
+  {"uplink_mic", "uplink MIC corrupted 1h-1.25h", 1,
+   {{FAULT_UPLINK_MIC, HOUR_S, 1.25 * HOUR_S, 1.0}}, NO_BACKHAUL},
+  {"downlink_mic", "downlink MIC corrupted 1h-1.5h", 1,
+   {{FAULT_DOWNLINK_MIC, HOUR_S, 1.5 * HOUR_S, 1.0}}, NO_BACKHAUL},
+  {"rejoin_accept_loss", "downlink MIC corrupted 1h-1.5h, join accepts lost 1h-2h", 2,
+   {{FAULT_DOWNLINK_MIC, HOUR_S, 1.5 * HOUR_S, 1.0}, {FAULT_JOIN_ACCEPT_LOSS, HOUR_S, 2 * HOUR_S, 1.0}}, NO_BACKHAUL},
+  {"server_reset", "network server loses its session DB at 1h", 1,
+   {{FAULT_SERVER_RESET, HOUR_S, HOUR_S, 1.0}}, NO_BACKHAUL},
+  {"radio_hang", "SX1262 hangs (BUSY stuck) at 1h", 1,
+   {{FAULT_RADIO_HANG, HOUR_S, HOUR_S, 1.0}}, NO_BACKHAUL},
+  {"radio_brownout", "SX1262 resets itself at 1h", 1,
+   {{FAULT_RADIO_BROWNOUT, HOUR_S, HOUR_S, 1.0}}, NO_BACKHAUL},
+  {"tx_stall", "one TX never completes at 1h", 1,
+   {{FAULT_TX_STALL, HOUR_S, HOUR_S, 1.0}}, NO_BACKHAUL},
+  {"radio_dead", "SX1262 unresponsive 1h-1.5h", 1,
+   {{FAULT_RADIO_DEAD, HOUR_S, 1.5 * HOUR_S, 1.0}}, NO_BACKHAUL},
+  {"wifi_backhaul", "SX1262 unresponsive 1h-5h, Wi-Fi AP visible from 4h", 1,
+   {{FAULT_RADIO_DEAD, HOUR_S, 5 * HOUR_S, 1.0}}, {4 * HOUR_S, 1e9, 0, 0, 0}},
+  {"wifi_flaky_broker", "as wifi_backhaul, broker loses 20% of publishes/echoes and drops every 5th", 1,
+   {{FAULT_RADIO_DEAD, HOUR_S, 5 * HOUR_S, 1.0}}, {4 * HOUR_S, 1e9, 0.2, 0.2, 5}},
+};
+
+#define SCENARIO_COUNT (sizeof(SCENARIOS) / sizeof(SCENARIOS[0]))
+
+struct TestOptions {
+  double hours = 6.0;
+  uint32_t runs = 10;
+  uint32_t seed = 1;
+  float snr_db = 5.0f;
+  double drift_ppm = 20.0;
+  bool reset_nonce = false;
+  bool verbose = false;
+};
+
+// 실행 하나의 결과 (자식 프로세스 → 파이프)
+struct RunResult {
+  bool booted;               // setup()이 끝남 (첫 조인 실패여도 loop()로 넘어감)
+  bool restarted;            // 펌웨어가 ESP.restart() 호출
+  double join_latency_s;     // 전원 인가 → 첫 조인 수락 (-1: 조인 못 함)
+  double recovery_s;         // 마지막 장애가 끝난 뒤 서버가 측정값을 다시 받기까지 (-1: 못 받음)
+  double max_gap_s;          // 서버가 받은 측정값 업링크 사이 최대 간격 (실행 끝까지 포함)
+  uint32_t readings;         // 노드가 측정한 수
+  uint32_t delivered;        // 서버가 받은 서로 다른 측정 번호 수
+  uint32_t duplicates;
+  uint32_t late;             // 밀린 측정값(FPort 2/4)으로 도착
+  uint32_t queued;           // 실행 끝에 노드 큐에 남은 수
+  uint32_t join_requests;
+  uint32_t joins;
+  uint32_t radio_begins;
+  uint32_t heals;
+  uint32_t tx_errors;
+  double airtime_s;
+  uint8_t final_dr;
+  ServerStats server;
+  uint32_t wifi_scans;       // 노드가 AP를 찾은 횟수
+  uint32_t wifi_sessions;    // MQTT 연결까지 된 횟수
+  double wifi_on_s;          // Wi-Fi 전원이 켜져 있던 시간 합
+  double wifi_longest_s;     // 가장 긴 한 번 (스캔 + 연결 + 비우기)
+  uint32_t mqtt_published;   // 노드가 발행한 메시지 (재발행 포함)
+  uint32_t mqtt_acked;
+  uint32_t mqtt_retries;
+  uint32_t wifi_readings;    // 브로커로 도착한 서로 다른 측정 번호 수
+  uint32_t wifi_only;        // 그중 LoRa로는 안 온 것
+  MqttBrokerStats broker;
+};
+
+NetworkServer* test_server = nullptr;
+
+// 브로커가 받은 백홀 메시지 ([메시지 번호 u16][[길이 u16][델타 묶음]...]) → 측정 번호별 수신 횟수
+static void countBackhaulReadings(const MqttBroker &broker, std::vector<uint16_t> &counts) {
+  static uint8_t frames[BACKHAUL_MAX_SAMPLES * DELTA_FRAME_STRIDE_MAX];
+  uint32_t times[BACKHAUL_MAX_SAMPLES];
+  for (const MqttMessage &msg : broker.received) {
+    size_t pos = 2;
+    const uint8_t* block;
+    size_t block_len;
+    while (nextHistoryBlock(msg.payload.data(), msg.payload.size(), pos, block, block_len)) {
+      const FrameLayout* layout;
+      size_t count = decodeDeltaBlock(block, block_len, frames, times, BACKHAUL_MAX_SAMPLES, layout);
+      for (size_t i = 0; i < count; i++) {
+        const uint8_t* frame = frames + i * (FRAME_DESCRIPTOR_SIZE + layout->size);
+        uint16_t seq = (uint16_t)(frame[FRAME_DESCRIPTOR_SIZE] << 8 | frame[FRAME_DESCRIPTOR_SIZE + 1]);
+        if (counts[seq] < 0xFFFF) counts[seq]++;
+      }
+    }
+  }
+}
+
+// 시뮬레이션 라디오 → 게이트웨이
+static bool airUplink(const SimAirFrame &uplink, SimAirFrame &downlink) {
+  downlink = SimAirFrame();
+  if (!test_server->receive(uplink.data, uplink.len, uplink.datarate, sim_now_us, downlink.data, downlink.len,
+                            downlink.window)) {
+    return false;
+  }
+  downlink.rssi = test_server->link_rssi_dbm;
+  downlink.snr = test_server->link_snr_db;
+  return true;
+}
+
+// 칩 장애는 시뮬레이션 라디오 일정으로
+static void scheduleRadioFaults(const Scenario &scenario) {
+  for (uint8_t i = 0; i < scenario.fault_count; i++) {
+    const FaultWindow &f = scenario.faults[i];
+    uint64_t start = (uint64_t)(f.start_s * 1e6), end = (uint64_t)(f.end_s * 1e6);
+    switch (f.kind) {
+      case FAULT_RADIO_HANG: sim_radio_faults.hang_at_us = start; break;
+      case FAULT_RADIO_BROWNOUT: sim_radio_faults.brownout_at_us = start; break;
+      case FAULT_TX_STALL: sim_radio_faults.tx_stall_at_us = start; break;
+      case FAULT_RADIO_DEAD:
+        sim_radio_faults.dead_from_us = start;
+        sim_radio_faults.dead_until_us = end;
+        break;
+      default: break;
+    }
+  }
+}
+
+// 부팅 구간(10분 이내)에서 끝나는 장애는 조인 지연으로만 보고 복구 시간은 재지 않음
+static double recoveryMark(const Scenario &scenario) {
+  double mark = -1.0;
+  for (uint8_t i = 0; i < scenario.fault_count; i++) {
+    if (scenario.faults[i].start_s > 0) mark = std::max(mark, scenario.faults[i].end_s);
+  }
+  return mark;
+}
+
+static RunResult runScenario(const Scenario &scenario, uint32_t seed, const TestOptions &opt) {
+  NetworkServer server(seed * 2654435761UL + 1);
+  server.link_snr_db = opt.snr_db;
+  server.faults.assign(scenario.faults, scenario.faults + scenario.fault_count);
+  server.addDevice(devEUI, joinEUI, nwkKey);
+  // 설정 다운링크 (트랜잭션 1: 화면 표시 3초) - 첫 업링크의 RX1로 전달되어 FPort 11 응답이 와야 함
+  server.queueDownlink(devEUI, {0x01, CMD_SET_DISPLAY_HOLD, 3});
+  test_server = &server;
+
+  MqttBroker broker(seed * 40503UL + 7);
+  broker.publish_loss = scenario.wifi.publish_loss;
+  broker.delivery_loss = scenario.wifi.delivery_loss;
+  broker.disconnect_every = scenario.wifi.disconnect_every;
+  sim_mqtt_broker = &broker;
+  sim_wifi_ap.ssid = NODE_WIFI_SSID;
+  sim_wifi_ap.pass = NODE_WIFI_PASS;
+  sim_wifi_ap.from_us = (uint64_t)(scenario.wifi.ap_from_s * 1e6);
+  sim_wifi_ap.until_us = (uint64_t)(std::min(scenario.wifi.ap_until_s, 1e9) * 1e6);
+
+  sim_air_uplink = airUplink;
+  sim_pin_reader = simRadioPin;
+  sim_verbose = opt.verbose;
+  sim_rtc_drift_ppm = opt.drift_ppm;
+  sim_nonce_reset_on_begin = opt.reset_nonce;
+  sim_deadline_us = (uint64_t)(opt.hours * HOUR_S * 1e6);
+  randomSeed(seed);
+  scheduleRadioFaults(scenario);
+
+  RunResult r = RunResult();
+  try {
+    Node::setup();
+    r.booted = true;
+    while (true) Node::loop();
+  } catch (const SimTimeUp &) {
+  } catch (const SimRestart &) {
+    r.restarted = true;
+  }
+  fflush(stdout);
+
+  uint64_t end_us = sim_now_us;
+  r.join_latency_s = sim_radio_stats.first_join_us ? sim_radio_stats.first_join_us / 1e6 : -1.0;
+
+  double mark = recoveryMark(scenario);
+  r.recovery_s = mark < 0 ? 0.0 : -1.0;
+  uint64_t prev = 0;
+  r.max_gap_s = server.data_times_us.empty() ? -1.0 : 0.0;
+  for (uint64_t t : server.data_times_us) {
+    if (prev) r.max_gap_s = std::max(r.max_gap_s, (t - prev) / 1e6);
+    prev = t;
+    if (mark >= 0 && r.recovery_s < 0 && t / 1e6 >= mark) r.recovery_s = t / 1e6 - mark;
+  }
+  if (prev) r.max_gap_s = std::max(r.max_gap_s, (end_us - prev) / 1e6);
+
+  std::vector<uint16_t> wifi_counts(NS_MAX_SEQUENCE, 0);
+  countBackhaulReadings(broker, wifi_counts);
+
+  r.readings = Node::sensor.readings;
+  for (uint32_t seq = 0; seq < r.readings; seq++) {
+    uint16_t n = server.sequence_counts[seq];
+    if (n || wifi_counts[seq]) r.delivered++;
+    if (n > 1) r.duplicates += n - 1;
+    if (wifi_counts[seq]) r.wifi_readings++;
+    if (wifi_counts[seq] && !n) r.wifi_only++;
+  }
+  r.late = server.late_readings;
+  r.queued = uplink_queue.count;
+  r.join_requests = sim_radio_stats.join_requests;
+  r.joins = sim_radio_stats.joins;
+  r.radio_begins = sim_radio_stats.begins;
+  r.heals = radio_health.heals;
+  r.tx_errors = sim_radio_stats.tx_errors;
+  r.airtime_s = sim_radio_stats.airtime_ms / 1000.0;
+  r.final_dr = node.getDatarate();
+  r.server = server.stats;
+  WiFi.mode(WIFI_OFF);   // 실행이 Wi-Fi 도중에 끝났으면 켜져 있던 시간까지
+  r.wifi_scans = sim_wifi_stats.scans;
+  r.wifi_sessions = wifi_backhaul.sessions;
+  r.wifi_on_s = sim_wifi_stats.on_us / 1e6;
+  r.wifi_longest_s = sim_wifi_stats.longest_us / 1e6;
+  r.mqtt_published = wifi_backhaul.published;
+  r.mqtt_acked = wifi_backhaul.acked;
+  r.mqtt_retries = wifi_backhaul.retries;
+  r.broker = broker.stats;
+  return r;
+}
+
+// 시나리오 실행 하나를 자식 프로세스에서 (펌웨어 전역 변수가 실행마다 초기 상태)
+static bool forkScenario(const Scenario &scenario, uint32_t seed, const TestOptions &opt, RunResult &result) {
+  int fds[2];
+  if (pipe(fds) != 0) return false;
+  fflush(stdout);
+
+  pid_t pid = fork();
+  if (pid < 0) return false;
+  if (pid == 0) {
+    close(fds[0]);
+    RunResult r = runScenario(scenario, seed, opt);
+    ssize_t written = write(fds[1], &r, sizeof(r));
+    _exit(written == (ssize_t)sizeof(r) ? 0 : 1);
+  }
+
+  close(fds[1]);
+  ssize_t got = read(fds[0], &result, sizeof(result));
+  close(fds[0]);
+  int status = 0;
+  waitpid(pid, &status, 0);
+  return got == (ssize_t)sizeof(result) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// ============================================================================
+// 보고
+// ============================================================================
+
+static double median(std::vector<double> v) {
+  if (v.empty()) return -1.0;
+  std::sort(v.begin(), v.end());
+  return v[v.size() / 2];
+}
+
+static void printSeconds(double s) {
+  if (s < 0) printf(" %8s", "-");
+  else printf(" %8.1f", s);
+}
+
+static void printHeader() {
+  printf("%-19s %4s %6s %8s %8s %8s %8s %8s %9s %5s %7s %6s %8s\n", "scenario", "runs", "halted", "join(s)",
+         "recov'd", "recov(s)", "worst(s)", "gap(s)", "delivered", "dup", "joinreq", "heals", "air(s)");
+}
+
+// 시나리오 한 줄 요약, 통과 여부 반환 (halted 없음, 복구를 재면 모든 실행이 복구)
+static bool printSummary(const Scenario &scenario, const std::vector<RunResult> &runs) {
+  uint32_t halted = 0, recovered = 0, readings = 0, delivered = 0, duplicates = 0;
+  double join_requests = 0, heals = 0, airtime = 0, worst_recovery = -1.0;
+  std::vector<double> joins, recoveries, gaps;
+  bool measures_recovery = recoveryMark(scenario) >= 0;
+
+  for (const RunResult &r : runs) {
+    if (!r.booted) halted++;
+    if (r.join_latency_s >= 0) joins.push_back(r.join_latency_s);
+    if (r.booted && r.recovery_s >= 0) {
+      recovered++;
+      recoveries.push_back(r.recovery_s);
+      worst_recovery = std::max(worst_recovery, r.recovery_s);
+    }
+    if (r.max_gap_s >= 0) gaps.push_back(r.max_gap_s);
+    readings += r.readings;
+    delivered += r.delivered;
+    duplicates += r.duplicates;
+    join_requests += r.join_requests;
+    heals += r.heals;
+    airtime += r.airtime_s;
+  }
+
+  size_t n = runs.size();
+  printf("%-19s %4zu %6u", scenario.name, n, halted);
+  printSeconds(median(joins));
+  if (measures_recovery) {
+    printf(" %4u/%-3u", recovered, (uint32_t)n - halted);
+    printSeconds(median(recoveries));
+    printSeconds(worst_recovery);
+  } else {
+    printf(" %8s %8s %8s", "-", "-", "-");
+  }
+  printSeconds(median(gaps));
+  bool passed = halted == 0 && (!measures_recovery || recovered == n);
+  printf(" %8.1f%% %5u %7.1f %6.1f %8.1f%s\n", readings ? 100.0 * delivered / readings : 0.0, duplicates,
+         join_requests / n, heals / n, airtime / n, passed ? "" : "  FAIL");
+  return passed;
+}
+
+// 실행 하나 자세히 (--runs 1)
+static void printRunDetail(const RunResult &r) {
+  const ServerStats &s = r.server;
+  printf("  node: readings %u, delivered %u (late %u), duplicates %u, still queued %u, final DR%u\n", r.readings,
+         r.delivered, r.late, r.duplicates, r.queued, r.final_dr);
+  printf("  radio: join requests %u, joins %u, begin() %u, heals %u, TX errors %u, airtime %.1fs\n",
+         r.join_requests, r.joins, r.radio_begins, r.heals, r.tx_errors, r.airtime_s);
+  printf("  server: joins %u/%u (nonce rejects %u), uplinks %u, unknown DevAddr %u, MIC rejects %u, "
+         "FCnt rejects %u\n", s.join_accepts, s.join_requests, s.nonce_rejects, s.uplinks, s.unknown_dev_addr,
+         s.mic_rejects, s.fcnt_rejects);
+  printf("  server: downlinks %u (lost %u, corrupted %u), LinkADRReq %u, config acks %u, lost uplinks %u\n",
+         s.downlinks, s.lost_downlinks, s.corrupted_downlinks, s.link_adr_reqs, s.config_acks, s.lost_uplinks);
+  if (!r.wifi_scans) return;
+  const MqttBrokerStats &b = r.broker;
+  printf("  wifi: scans %u, sessions %u, on %.1fs (longest %.1fs), readings %u (%u only via Wi-Fi)\n", r.wifi_scans,
+         r.wifi_sessions, r.wifi_on_s, r.wifi_longest_s, r.wifi_readings, r.wifi_only);
+  printf("  mqtt: published %u, acked %u, retries %u; broker got %u (lost %u), echoes lost %u, forced disconnects %u\n",
+         r.mqtt_published, r.mqtt_acked, r.mqtt_retries, b.publishes, b.lost_publishes, b.lost_deliveries,
+         b.forced_disconnects);
+}
+
+static void printUsage() {
+  printf("usage: program [--scenario NAME] [--runs N] [--hours H] [--seed N] [--snr DB] [--drift PPM]\n"
+         "               [--reset-nonce] [--verbose] [--list]\n");
+}
+
+int main(int argc, char** argv) {
+  TestOptions opt;
+  const char* only = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    bool takes_value = true;
+
+    if (!strcmp(arg, "--list")) {
+      for (const Scenario &s : SCENARIOS) printf("%-19s %s\n", s.name, s.description);
+      return 0;
+    } else if (!strcmp(arg, "--verbose")) {
+      opt.verbose = true;
+      takes_value = false;
+    } else if (!strcmp(arg, "--reset-nonce")) {
+      opt.reset_nonce = true;
+      takes_value = false;
+    } else if (!value) {
+      printUsage();
+      return 1;
+    } else if (!strcmp(arg, "--scenario")) {
+      only = value;
+    } else if (!strcmp(arg, "--runs")) {
+      opt.runs = std::max(1, atoi(value));
+    } else if (!strcmp(arg, "--hours")) {
+      opt.hours = atof(value);
+    } else if (!strcmp(arg, "--seed")) {
+      opt.seed = strtoul(value, nullptr, 10);
+    } else if (!strcmp(arg, "--snr")) {
+      opt.snr_db = atof(value);
+    } else if (!strcmp(arg, "--drift")) {
+      opt.drift_ppm = atof(value);
+    } else {
+      printUsage();
+      return 1;
+    }
+    if (takes_value) i++;
+  }
+
+  bool found = false;
+  uint32_t failed = 0;
+  printf("Node: %us interval, %.1fh per run, link SNR %.1fdB%s\n", NODE_UPLINK_INTERVAL_S, opt.hours, opt.snr_db,
+         opt.reset_nonce ? ", DevNonce reset on beginOTAA()" : "");
+  if (!opt.verbose) printHeader();
+
+  for (const Scenario &scenario : SCENARIOS) {
+    if (only && strcmp(only, scenario.name)) continue;
+    found = true;
+
+    std::vector<RunResult> runs;
+    for (uint32_t k = 0; k < opt.runs; k++) {
+      RunResult r;
+      if (!forkScenario(scenario, opt.seed + k, opt, r)) {
+        fprintf(stderr, "%s seed %u: run failed\n", scenario.name, opt.seed + k);
+        return 1;
+      }
+      runs.push_back(r);
+    }
+    if (opt.verbose) printHeader();
+    if (!printSummary(scenario, runs)) failed++;
+    if (opt.runs == 1) printRunDetail(runs[0]);
+  }
+
+  if (!found) {
+    printUsage();
+    return 1;
+  }
+  if (failed) {
+    printf("FAIL: %u scenario(s) with halted or unrecovered runs\n", failed);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}